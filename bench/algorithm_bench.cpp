@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/stl/algorithm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * introSort and radixSort against std::sort on the shapes report handlers sort: random
+ * integers, doubles, rows ordered by amount and strings.
+ */
+
+struct ReportRow {
+    uint32 id;
+    uint32 region;
+    double amount;
+};
+
+template< class ItemType, class Sort >
+static double millisToSort(const std::vector< ItemType >& input, Sort sort) {
+    double best = 1e30;
+
+    for (int round = 0; round < 5; ++round) {
+        std::vector< ItemType > items = input;
+
+        auto start = std::chrono::steady_clock::now();
+        sort(items.data(), items.data() + items.size());
+        auto stop = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration< double, std::milli >(stop - start).count());
+    }
+    return best;
+}
+
+template< class ItemType >
+static void report(const char* name, const std::vector< ItemType >& input, bool withRadix) {
+    double stdMs   = millisToSort(input, [](ItemType* first, ItemType* last) { std::sort(first, last); });
+    double introMs = millisToSort(input, [](ItemType* first, ItemType* last) { introSort(first, last); });
+
+    if constexpr (std::is_arithmetic_v< ItemType >) {
+        if (withRadix) {
+            double radixMs = millisToSort(input, [](ItemType* first, ItemType* last) { radixSort(first, last); });
+            printf("%-10s %8zu  std::sort %8.2f ms  introSort %8.2f ms  radixSort %8.2f ms\n", name, input.size(), stdMs, introMs, radixMs);
+            return;
+        }
+    }
+    printf("%-10s %8zu  std::sort %8.2f ms  introSort %8.2f ms\n", name, input.size(), stdMs, introMs);
+}
+
+int main() {
+    std::mt19937_64 rng(2025);
+
+    for (uint32 count : {1000u, 100000u, 1000000u}) {
+        std::vector< uint32 > ids(count);
+        std::vector< uint64 > stamps(count);
+        std::vector< double > amounts(count);
+        std::vector< ReportRow > rows(count);
+        std::vector< std::string > names(count / 10);
+
+        for (uint32 idx = 0; idx < count; ++idx) {
+            ids[idx]     = (uint32) rng();
+            stamps[idx]  = rng();
+            amounts[idx] = (double)(int64_t)(rng() % 2000000) / 100.0 - 10000.0;
+            rows[idx]    = {idx, (uint32)(rng() % 16), amounts[idx]};
+        }
+        for (std::string& name : names) {
+            name = "customer-" + std::to_string(rng() % 1000000);
+        }
+
+        report("uint32", ids, true);
+        report("uint64", stamps, true);
+        report("double", amounts, true);
+        report("string", names, false);
+
+        auto byAmount = [](const ReportRow& lhs, const ReportRow& rhs) { return lhs.amount < rhs.amount; };
+        double stdMs   = millisToSort(rows, [&](ReportRow* first, ReportRow* last) { std::sort(first, last, byAmount); });
+        double introMs = millisToSort(rows, [&](ReportRow* first, ReportRow* last) { introSort(first, last, byAmount); });
+        double radixMs = millisToSort(rows, [](ReportRow* first, ReportRow* last) {
+            radixSortBy(first, last, [](const ReportRow& row) { return row.amount; });
+        });
+        printf("%-10s %8u  std::sort %8.2f ms  introSort %8.2f ms  radixSort %8.2f ms\n", "rows", count, stdMs, introMs, radixMs);
+    }
+    return 0;
+}
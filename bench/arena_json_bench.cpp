@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/json/arena_json.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Parse + drop of a request scoped DOM: nlohmann::json on the global allocator against
+ * ArenaJson in a per thread MonotonicArena reset after every document. The payloads are
+ * stress_test/test.json records (id, name, active, tags) scaled up to 1, 100 and 10k per
+ * body, run from 1 and then 4 threads to show allocator contention.
+ */
+
+/** Keeps the parses alive; atomic since every worker thread adds its total. */
+static std::atomic< uint64 > sink{0};
+
+static std::string makeBody(uint32 records) {
+    std::string body = "[";
+
+    for (uint32 idx = 0; idx < records; ++idx) {
+        if (idx > 0) body += ",";
+        body += R"({"id": )" + std::to_string(100 + idx) + R"(, "name": "Kevin )" + std::to_string(idx) +
+                R"(", "active": true, "tags": ["a", "b", "c"]})";
+    }
+
+    return body + "]";
+}
+
+template< class Parse >
+static double microsPerBody(const std::string& body, uint32 threads, Parse parse) {
+    uint32 rounds = (uint32)(4000000 / body.size()) + 10;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector< std::thread > workers;
+    for (uint32 thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&]() {
+            uint64 total = 0;
+            for (uint32 round = 0; round < rounds; ++round) {
+                total += parse(body);
+            }
+            sink.fetch_add(total, std::memory_order_relaxed);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration< double, std::micro >(stop - start).count() / (rounds * threads);
+}
+
+static uint64 parseGlobal(const std::string& body) {
+    nlohmann::json doc = nlohmann::json::parse(body);
+    return doc.size();
+}
+
+static uint64 parseArena(const std::string& body) {
+    static thread_local MonotonicArena arena;
+
+    uint64 size;
+    {
+        ArenaScope scope(arena);
+        ArenaJson  doc = ArenaJson::parse(body);
+        size = doc.size();
+    }
+    arena.reset();
+    return size;
+}
+
+int main() {
+    for (uint32 threads : {1u, 4u}) {
+        for (uint32 records : {1u, 100u, 10000u}) {
+            std::string body = makeBody(records);
+
+            double globalUs = microsPerBody(body, threads, parseGlobal);
+            double arenaUs  = microsPerBody(body, threads, parseArena);
+
+            printf("%u thread(s) %8zu bytes  global %10.2f us  arena %10.2f us\n",
+                   threads, body.size(), globalUs, arenaUs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/json/json_binding.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Service to service payloads: an order of 10 to 1k lines written with bodyWrite and read
+ * back into the struct with bodyRead, per body format. Reports the body size and the time
+ * to encode and to decode one body.
+ */
+
+struct BenchLine {
+    String      sku;
+    long long   qty   = 0;
+    double      price = 0;
+    bool        promo = false;
+};
+SA_JSON_BINDING(BenchLine,
+    SA_JSON_FIELD(BenchLine, sku),
+    SA_JSON_FIELD(BenchLine, qty),
+    SA_JSON_FIELD(BenchLine, price),
+    SA_JSON_FIELD(BenchLine, promo))
+
+struct BenchOrder {
+    unsigned long long       id = 0;
+    String                   customer;
+    std::vector< BenchLine > lines;
+};
+SA_JSON_BINDING(BenchOrder,
+    SA_JSON_FIELD(BenchOrder, id),
+    SA_JSON_FIELD(BenchOrder, customer),
+    SA_JSON_FIELD(BenchOrder, lines))
+
+static volatile uint64 sink;
+
+static BenchOrder makeOrder(uint32 lines) {
+    BenchOrder order;
+    order.id       = 9007199254740993ull;
+    order.customer = "customer-4711@example.com";
+
+    for (uint32 idx = 0; idx < lines; ++idx) {
+        order.lines.push_back({ "SKU-" + std::to_string(idx), (long long)(idx % 17), 19.99 + idx, idx % 3 == 0 });
+    }
+    return order;
+}
+
+template< class Run >
+static double microsecondsPerCall(uint32 rounds, Run run) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round) {
+        run();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    return std::chrono::duration< double, std::micro >(stop - start).count() / rounds;
+}
+
+int main() {
+    const char* names[]   = { "json", "cbor", "msgpack" };
+    BodyFormat  formats[] = { BODY_FORMAT_JSON, BODY_FORMAT_CBOR, BODY_FORMAT_MSGPACK };
+
+    for (uint32 lines : {10u, 100u, 1000u}) {
+        BenchOrder order  = makeOrder(lines);
+        uint32     rounds = 200000 / lines + 10;
+
+        for (uint32 idx = 0; idx < 3; ++idx) {
+            String     body;
+            BenchOrder back;
+            bodyWrite(body, formats[idx], order);
+
+            if (!bodyRead(body, formats[idx], back) || back.lines.size() != lines) {
+                printf("%s does not round trip\n", names[idx]);
+                return 1;
+            }
+
+            double encode = microsecondsPerCall(rounds, [&] {
+                String out;
+                bodyWrite(out, formats[idx], order);
+                sink = out.size();
+            });
+            double decode = microsecondsPerCall(rounds, [&] {
+                BenchOrder read;
+                bodyRead(body, formats[idx], read);
+                sink = read.lines.size();
+            });
+
+            printf("%5u lines  %-8s %8zu bytes  encode %8.2f us  decode %8.2f us\n",
+                   lines, names[idx], body.size(), encode, decode);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/stl/concurrent_hash_map.hpp"
+#include "../src/stl/hash_associative_container.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+/**
+ * Scaling of ConcurrentHashMap against a HashAssociativeContainer behind one mutex, the only
+ * way to share the existing containers between workers.
+ *
+ *   read-heavy:  95% lookups, 5% counter updates
+ *   write-heavy: 50% lookups, 50% counter updates
+ */
+
+static constexpr uint32 KEY_SPACE      = 1 << 16;
+static constexpr uint32 OPS_PER_THREAD = 400000;
+
+struct MutexMap {
+    HashAssociativeContainer< uint32, uint32, KEY_SPACE > container;
+    pthread_mutex_t                                       mutex;
+
+    MutexMap()  { pthread_mutex_init(&mutex, nullptr); }
+    ~MutexMap() { pthread_mutex_destroy(&mutex); }
+
+    bool find(uint32 key, uint32& value) {
+        pthread_mutex_lock(&mutex);
+        bool found = container.exists(key);
+        if (found) {
+            value = container.at(key);
+        }
+        pthread_mutex_unlock(&mutex);
+        return found;
+    }
+
+    void increment(uint32 key) {
+        pthread_mutex_lock(&mutex);
+        if (container.exists(key)) {
+            container.at(key)++;
+        } else {
+            container.add(key, 1);
+        }
+        pthread_mutex_unlock(&mutex);
+    }
+};
+
+struct ShardedMap {
+    ConcurrentHashMap< uint32, uint32, 64, KEY_SPACE / 64 > container;
+
+    bool find(uint32 key, uint32& value) {
+        return container.find(key, value);
+    }
+
+    void increment(uint32 key) {
+        container.update(key, 0, [](uint32& count) { count++; });
+    }
+};
+
+template< class MapType >
+double runWorkload(MapType& map, uint32 nbThreads, uint32 writePercent) {
+    std::vector< std::thread > threads;
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32 t = 0; t < nbThreads; ++t) {
+        threads.emplace_back([&map, t, writePercent]() {
+            uint32 seed  = 0x9E3779B9u * (t + 1);
+            uint32 value = 0;
+            uint32 found = 0;
+
+            for (uint32 i = 0; i < OPS_PER_THREAD; ++i) {
+                seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+                uint32 key = seed & (KEY_SPACE - 1);
+
+                if (seed % 100 < writePercent) {
+                    map.increment(key);
+                } else {
+                    found += map.find(key, value);
+                }
+            }
+
+            // Keep the lookups alive
+            if (found == 0xFFFFFFFFu) printf("%u\n", value);
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+    return (double) nbThreads * OPS_PER_THREAD / elapsed.count() / 1e6;
+}
+
+template< class MapType >
+void prefill(MapType& map) {
+    for (uint32 key = 0; key < KEY_SPACE; key += 2) {
+        map.increment(key);
+    }
+}
+
+int main() {
+    const uint32 threadCounts[] = {1, 2, 4, 8, 16};
+    const uint32 writePercents[] = {5, 50};
+
+    printf("hardware threads: %u, ops per thread: %u\n\n", std::thread::hardware_concurrency(), OPS_PER_THREAD);
+    printf("%-12s %8s %16s %16s %8s\n", "workload", "threads", "mutex (Mops/s)", "sharded (Mops/s)", "speedup");
+
+    for (uint32 writePercent : writePercents) {
+        for (uint32 nbThreads : threadCounts) {
+            MutexMap*   mutexMap   = new MutexMap();
+            ShardedMap* shardedMap = new ShardedMap();
+            prefill(*mutexMap);
+            prefill(*shardedMap);
+
+            double mutexRate   = runWorkload(*mutexMap, nbThreads, writePercent);
+            double shardedRate = runWorkload(*shardedMap, nbThreads, writePercent);
+
+            printf("%-12s %8u %16.2f %16.2f %7.2fx\n", writePercent == 5 ? "read-heavy" : "write-heavy",
+                   nbThreads, mutexRate, shardedRate, shardedRate / mutexRate);
+
+            delete mutexMap;
+            delete shardedMap;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/json/fast_number.hpp"
+#include "../src/json/json_tape.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Number conversion on numeric corpora: telemetry readings (6 decimals), order lines (ids,
+ * quantities, prices), 64 bit ids and shortest round trip doubles (17 digits).
+ *
+ * "strtod" copies each token and calls strtoll / strtod, which is what nlohmann's lexer does;
+ * "from_chars" is the standard library; "fast" is jsonParseNumber. The last table parses the
+ * same corpora as JSON arrays: nlohmann::json::parse against JsonTape.
+ */
+
+static volatile double sink;
+
+static std::vector< std::string > makeCorpus(const char* kind, uint32 count) {
+    std::mt19937_64            rng(42);
+    std::vector< std::string > tokens;
+    char                       text[64];
+
+    for (uint32 idx = 0; idx < count; idx++) {
+        if (std::string(kind) == "telemetry") {
+            ::snprintf(text, sizeof(text), "%.6f", (double)(rng() % 2000000) / 1000.0 - 1000.0);
+        } else if (std::string(kind) == "orders") {
+            uint32 field = idx % 3;
+            if (field == 0)      ::snprintf(text, sizeof(text), "%llu", (unsigned long long)(100000 + rng() % 900000));
+            else if (field == 1) ::snprintf(text, sizeof(text), "%llu", (unsigned long long)(1 + rng() % 20));
+            else                 ::snprintf(text, sizeof(text), "%llu.%02llu", (unsigned long long)(rng() % 500), (unsigned long long)(rng() % 100));
+        } else if (std::string(kind) == "ids") {
+            ::snprintf(text, sizeof(text), "%llu", (unsigned long long)(rng() >> 1));
+        } else {
+            double value;
+            uint64 bits = rng();
+            ::memcpy(&value, &bits, sizeof(value));
+            if (!std::isfinite(value)) value = 1.0 / (1 + idx);
+            ::snprintf(text, sizeof(text), "%.17g", value);
+        }
+        tokens.push_back(text);
+    }
+    return tokens;
+}
+
+static double parseStrtod(const std::string& token) {
+    std::string copy(token);
+
+    if (copy.find_first_of(".eE") == std::string::npos) {
+        return (double) std::strtoll(copy.c_str(), nullptr, 10);
+    }
+    return std::strtod(copy.c_str(), nullptr);
+}
+
+static double parseFromChars(const std::string& token) {
+    if (token.find_first_of(".eE") == std::string::npos) {
+        long long value = 0;
+        std::from_chars(token.data(), token.data() + token.size(), value);
+        return (double) value;
+    }
+
+    double value = 0;
+    std::from_chars(token.data(), token.data() + token.size(), value);
+    return value;
+}
+
+static double parseFast(const std::string& token) {
+    JsonNumber number;
+    jsonParseNumber(token.data(), token.data() + token.size(), number);
+    return number.kind == JSON_NUMBER_DOUBLE ? number.asDouble : (double) number.asInt64;
+}
+
+template< class Parse >
+static double nanosPerNumber(const std::vector< std::string >& tokens, Parse parse) {
+    uint32 rounds = 20;
+    double total  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round) {
+        for (const std::string& token : tokens) {
+            total += parse(token);
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    sink = total;
+    return std::chrono::duration< double, std::nano >(stop - start).count() / (rounds * tokens.size());
+}
+
+template< class Parse >
+static double megabytesPerSecond(const std::string& body, Parse parse) {
+    uint32 rounds = (uint32)(20000000 / body.size()) + 5;
+    double total  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round) {
+        total += parse(body);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    sink = total;
+    return body.size() * (double) rounds / std::chrono::duration< double, std::micro >(stop - start).count();
+}
+
+int main() {
+    const char* kinds[] = { "telemetry", "orders", "ids", "roundtrip" };
+
+    printf("%-10s %12s %12s %12s   (ns per number)\n", "corpus", "strtod", "from_chars", "fast");
+    for (const char* kind : kinds) {
+        std::vector< std::string > tokens = makeCorpus(kind, 100000);
+
+        for (const std::string& token : tokens) {
+            if (parseFast(token) != parseStrtod(token)) {
+                printf("mismatch on %s\n", token.c_str());
+                return 1;
+            }
+        }
+
+        printf("%-10s %12.1f %12.1f %12.1f\n", kind, nanosPerNumber(tokens, parseStrtod),
+               nanosPerNumber(tokens, parseFromChars), nanosPerNumber(tokens, parseFast));
+    }
+
+    printf("\n%-10s %12s %12s   (MB/s, whole JSON array)\n", "corpus", "nlohmann", "tape");
+    for (const char* kind : kinds) {
+        std::vector< std::string > tokens = makeCorpus(kind, 100000);
+        std::string                body   = "[";
+
+        for (const std::string& token : tokens) {
+            if (body.size() > 1) body += ",";
+            body += token;
+        }
+        body += "]";
+
+        double domMbs = megabytesPerSecond(body, [](const std::string& text) {
+            return (double) nlohmann::json::parse(text).size();
+        });
+        double tapeMbs = megabytesPerSecond(body, [](const std::string& text) {
+            static JsonTape tape;
+            tape.parse(text);
+            return (double) tape.root().size();
+        });
+
+        printf("%-10s %12.1f %12.1f\n", kind, domMbs, tapeMbs);
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/json/json_push_parser.hpp"
+#include "../src/json/json_tape.hpp"
+#include "../src/json/lazy_json.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+ * What receive-time validation costs a JSON body. JsonPushParser is fed in 2 KiB chunks, the
+ * size of the server's recv() buffer; the structure check of JsonDocument (skipped for a body
+ * the push parser already accepted) and a JsonTape parse are the passes readBody runs after
+ * the body is complete. "tail" is the validation work left once the last chunk arrives.
+ * Throughput in MB/s, tail in microseconds.
+ */
+
+enum { RECV_CHUNK = 2048 };
+
+static volatile uint64 sink;
+
+static std::string makeBody(uint32 records) {
+    std::string body = "[";
+
+    for (uint32 idx = 0; idx < records; ++idx) {
+        if (idx > 0) body += ",\n  ";
+        body += R"({"sku": "SKU-)" + std::to_string(idx) + R"(", "qty": )" + std::to_string(idx % 17) +
+                R"(, "price": 19.99, "tags": ["red", "large", "promo"], "note": "café, \"handle\" with care"})";
+    }
+
+    return body + "]";
+}
+
+template< class Pass >
+static double megabytesPerSecond(const std::string& body, Pass pass) {
+    uint32 rounds = (uint32)(50000000 / body.size()) + 10;
+    uint64 total  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round) {
+        total += pass(body);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    sink = total;
+    return body.size() * (double) rounds / std::chrono::duration< double, std::micro >(stop - start).count();
+}
+
+static uint64 pushValidate(const std::string& body) {
+    static JsonPushParser<> parser;
+    parser.reset();
+
+    for (ulong at = 0; at < body.size(); at += RECV_CHUNK) {
+        parser.feed(std::string_view(body).substr(at, RECV_CHUNK));
+    }
+    return parser.finish() == JSON_PUSH_COMPLETE;
+}
+
+static uint64 lazyValidate(const std::string& body) {
+    JsonDocument doc(body);
+    return doc.isValid() && doc.root().type() == JSON_ARRAY;
+}
+
+static uint64 tapeParse(const std::string& body) {
+    static JsonTape tape;
+    return tape.parse(body);
+}
+
+/** Best of 1000: feeding the last chunk and finishing, everything before it already fed. */
+static double tailMicros(const std::string& body) {
+    ulong  lastChunk = (body.size() - 1) / RECV_CHUNK * RECV_CHUNK;
+    double best      = 1e30;
+
+    for (int round = 0; round < 1000; ++round) {
+        JsonPushParser<> parser;
+        parser.feed(std::string_view(body).substr(0, lastChunk));
+
+        auto start = std::chrono::steady_clock::now();
+        parser.feed(std::string_view(body).substr(lastChunk));
+        sink = parser.finish();
+        auto stop = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration< double, std::micro >(stop - start).count());
+    }
+    return best;
+}
+
+int main() {
+    for (uint32 records : {10u, 100u, 1000u, 10000u}) {
+        std::string body = makeBody(records);
+
+        if (!pushValidate(body) || !lazyValidate(body) || !tapeParse(body)) {
+            printf("parsers disagree\n");
+            return 1;
+        }
+
+        double pushMbs = megabytesPerSecond(body, pushValidate);
+        double lazyMbs = megabytesPerSecond(body, lazyValidate);
+        double tapeMbs = megabytesPerSecond(body, tapeParse);
+
+        printf("%8zu bytes  push %7.1f MB/s (tail %5.2f us)  lazy check %7.1f MB/s  tape %7.1f MB/s\n",
+               body.size(), pushMbs, tailMicros(body), lazyMbs, tapeMbs);
+    }
+    return 0;
+}
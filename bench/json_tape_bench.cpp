@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/json/json_tape.hpp"
+#include "../src/json/lazy_json.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+ * Bulk ingest: an array of 100 to 10k records read in full (every record's "qty" summed).
+ * nlohmann builds the DOM; JsonTape parses with SIMD into its reused tape; the lazy backend
+ * walks the body, which is its worst case since nothing can be skipped. Reported in MB/s.
+ */
+
+static volatile uint64 sink;
+
+static std::string makeBody(uint32 records) {
+    std::string body = "[";
+
+    for (uint32 idx = 0; idx < records; ++idx) {
+        if (idx > 0) body += ",\n  ";
+        body += R"({"sku": "SKU-)" + std::to_string(idx) + R"(", "qty": )" + std::to_string(idx % 17) +
+                R"(, "price": 19.99, "tags": ["red", "large", "promo"], "note": "café, \"handle\" with care"})";
+    }
+
+    return body + "]";
+}
+
+template< class Sum >
+static double megabytesPerSecond(const std::string& body, Sum sum) {
+    uint32 rounds = (uint32)(50000000 / body.size()) + 10;
+    uint64 total  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < rounds; ++round) {
+        total += sum(body);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    sink = total;
+    return body.size() * (double) rounds / std::chrono::duration< double, std::micro >(stop - start).count();
+}
+
+static uint64 sumDom(const std::string& body) {
+    nlohmann::json doc   = nlohmann::json::parse(body);
+    uint64         total = 0;
+
+    for (const nlohmann::json& record : doc) {
+        total += record["qty"].get< uint64 >();
+    }
+    return total;
+}
+
+static uint64 sumTape(const std::string& body) {
+    static JsonTape tape;
+    uint64          total = 0;
+
+    tape.parse(body);
+    tape.root().forEachItem([&](const JsonTapeValue& record) {
+        long long qty = 0;
+        record["qty"].getInt64(qty);
+        total += qty;
+        return true;
+    });
+    return total;
+}
+
+static uint64 sumLazy(const std::string& body) {
+    JsonDocument doc(body);
+    uint64       total = 0;
+
+    doc.root().forEachItem([&](const JsonValue& record) {
+        long long qty = 0;
+        record["qty"].getInt64(qty);
+        total += qty;
+        return true;
+    });
+    return total;
+}
+
+int main() {
+    for (uint32 records : {100u, 1000u, 10000u}) {
+        std::string body = makeBody(records);
+
+        if (sumDom(body) != sumTape(body) || sumDom(body) != sumLazy(body)) {
+            printf("backends disagree\n");
+            return 1;
+        }
+
+        double domMbs  = megabytesPerSecond(body, sumDom);
+        double tapeMbs = megabytesPerSecond(body, sumTape);
+        double lazyMbs = megabytesPerSecond(body, sumLazy);
+
+        printf("%8zu bytes  nlohmann %7.1f MB/s  tape %7.1f MB/s  lazy %7.1f MB/s\n",
+               body.size(), domMbs, tapeMbs, lazyMbs);
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/stl/simd_find.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Cost of a missed lookup (the whole array scanned) for fd sized and id sized items, scalar
+ * loop against the simdFind dispatch.
+ */
+
+static constexpr uint32 ITEMS  = 4096;
+static constexpr uint32 ROUNDS = 20000;
+
+static volatile int sink;
+
+template< class ItemType, class Find >
+static double nanosPerScan(const ItemType* items, uint32 length, Find find) {
+    int found = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 round = 0; round < ROUNDS; ++round) {
+        found += find(items, length, (ItemType)(ITEMS + round));
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    sink = found;
+    return std::chrono::duration< double, std::nano >(stop - start).count() / ROUNDS;
+}
+
+template< class ItemType >
+static void bench(const char* name) {
+    static ItemType items[ITEMS];
+    for (uint32 idx = 0; idx < ITEMS; ++idx) {
+        items[idx] = (ItemType) idx;
+    }
+
+    for (uint32 length : {16u, 64u, 512u, ITEMS}) {
+        // Through a volatile pointer so the compiler cannot vectorize the scalar loop either
+        int (* volatile scalar)(const ItemType*, uint32, ItemType) = simdFindScalar< ItemType >;
+
+        double scalarNs = nanosPerScan(items, length, scalar);
+        double simdNs   = nanosPerScan(items, length, simdFind< ItemType >);
+        printf("%-7s %5u items  scalar %8.1f ns  simd %7.1f ns\n", name, length, scalarNs, simdNs);
+    }
+}
+
+int main() {
+    bench< int >("int");
+    bench< uint64 >("uint64");
+    bench< short >("short");
+    return 0;
+}
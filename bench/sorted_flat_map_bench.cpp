@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/stl/associative_container.hpp"
+#include "../src/stl/small_vector.hpp"
+#include "../src/stl/sorted_flat_map.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+ * Lookup cost of SortedFlatMap against the linear scan of AssociativeContainer, from a
+ * handful of entries up to a 10k entries table, with integer keys and string keys. The MIME
+ * names all share their first 8 bytes, the worst case for the prefixes: every lookup ends
+ * with a binary search on the full keys.
+ */
+
+static constexpr uint32 LOOKUPS = 2000000;
+
+static volatile uint64 sink;
+
+template< class Lookup >
+static double nanosPerLookup(uint32 size, Lookup lookup) {
+    uint32 lookups = size > 1000 ? LOOKUPS / 50 : LOOKUPS;
+    uint64 found   = 0;
+    uint32 seed    = 7;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 op = 0; op < lookups; ++op) {
+        seed   = seed * 1664525u + 1013904223u;
+        found += lookup((seed >> 8) % size);
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    sink = found;
+    return std::chrono::duration< double, std::nano >(stop - start).count() / lookups;
+}
+
+static std::string mimeName(uint32 idx) {
+    return "application/vnd.sa-" + std::to_string(idx) + "+json";
+}
+
+static void benchStrings(uint32 size) {
+    SmallVector< std::string > names;
+    SmallVector< uint32 >      values;
+    AssociativeContainer< std::string, uint32, 8, SmallVector > linear;
+
+    for (uint32 idx = 0; idx < size; ++idx) {
+        names.add(mimeName(idx));
+        values.add(idx);
+        linear.add(names[idx], idx);
+    }
+
+    SortedFlatMap< std::string, uint32 > sorted;
+    sorted.build(names.items, values.items, size);
+
+    double linearNs = nanosPerLookup(size, [&](uint32 idx) { return linear.at(names[idx]); });
+    double sortedNs = nanosPerLookup(size, [&](uint32 idx) { return sorted.at(names[idx]); });
+
+    printf("string  %6u entries  linear %9.1f ns  sorted %7.1f ns\n", size, linearNs, sortedNs);
+}
+
+static void benchIntegers(uint32 size) {
+    SmallVector< uint32 > keys;
+    AssociativeContainer< uint32, uint32, 8, SmallVector > linear;
+
+    for (uint32 idx = 0; idx < size; ++idx) {
+        keys.add(idx * 2654435761u);
+        linear.add(keys[idx], idx);
+    }
+
+    SortedFlatMap< uint32, uint32 > sorted;
+    sorted.build(keys.items, keys.items, size);
+
+    double linearNs = nanosPerLookup(size, [&](uint32 idx) { return linear.at(keys[idx]); });
+    double sortedNs = nanosPerLookup(size, [&](uint32 idx) { return sorted.at(keys[idx]); });
+
+    printf("integer %6u entries  linear %9.1f ns  sorted %7.1f ns\n", size, linearNs, sortedNs);
+}
+
+int main() {
+    for (uint32 size : {8u, 32u, 128u, 1000u, 10000u}) {
+        benchStrings(size);
+    }
+    for (uint32 size : {8u, 32u, 128u, 1000u, 10000u}) {
+        benchIntegers(size);
+    }
+    return 0;
+}
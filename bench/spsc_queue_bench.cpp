@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "../src/stl/queue.hpp"
+#include "../src/stl/spsc_queue.hpp"
+
+#include <pthread.h>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+/**
+ * One producer and one consumer passing integers: SpscQueue one item at a time and in
+ * batches of 32, against Queue behind a mutex (the TaskQueue setup).
+ */
+
+static constexpr uint32 ITEMS = 20000000;
+static constexpr uint32 BATCH = 32;
+
+struct MutexQueue {
+    Queue< uint32, 1024 > queue;
+    pthread_mutex_t       mutex;
+
+    MutexQueue()  { pthread_mutex_init(&mutex, nullptr); }
+    ~MutexQueue() { pthread_mutex_destroy(&mutex); }
+
+    bool enqueue(uint32 item) {
+        pthread_mutex_lock(&mutex);
+        bool done = queue.enqueue(item);
+        pthread_mutex_unlock(&mutex);
+        return done;
+    }
+
+    bool dequeue(uint32& item) {
+        pthread_mutex_lock(&mutex);
+        bool done = !queue.isEmpty();
+        if (done) {
+            item = queue.dequeue();
+        }
+        pthread_mutex_unlock(&mutex);
+        return done;
+    }
+};
+
+template< class Produce, class Consume >
+static void run(const char* name, Produce produce, Consume consume) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer(produce);
+    uint64 checksum = consume();
+    producer.join();
+
+    double seconds = std::chrono::duration< double >(std::chrono::steady_clock::now() - start).count();
+    printf("%-14s %8.1f Mops/s  (checksum %llu)\n", name, ITEMS / seconds / 1e6, checksum);
+}
+
+int main() {
+    {
+        MutexQueue queue;
+        run("mutex Queue",
+            [&]() { for (uint32 i = 0; i < ITEMS; ) { if (queue.enqueue(i)) i++; else std::this_thread::yield(); } },
+            [&]() {
+                uint64 sum = 0;
+                uint32 item;
+                for (uint32 i = 0; i < ITEMS; ) { if (queue.dequeue(item)) { sum += item; i++; } else std::this_thread::yield(); }
+                return sum;
+            });
+    }
+    {
+        SpscQueue< uint32, 1024 >* queue = new SpscQueue< uint32, 1024 >();
+        run("spsc single",
+            [&]() { for (uint32 i = 0; i < ITEMS; ) { if (queue->enqueue(i)) i++; else std::this_thread::yield(); } },
+            [&]() {
+                uint64 sum = 0;
+                uint32 item;
+                for (uint32 i = 0; i < ITEMS; ) { if (queue->dequeue(item)) { sum += item; i++; } else std::this_thread::yield(); }
+                return sum;
+            });
+        delete queue;
+    }
+    {
+        SpscQueue< uint32, 1024 >* queue = new SpscQueue< uint32, 1024 >();
+        run("spsc bulk",
+            [&]() {
+                uint32 batch[BATCH];
+                for (uint32 i = 0; i < ITEMS; ) {
+                    uint32 count = 0;
+                    for (; count < BATCH && i + count < ITEMS; count++) batch[count] = i + count;
+                    uint32 sent = queue->enqueueBulk(batch, count);
+                    i += sent;
+                    if (sent == 0) std::this_thread::yield();
+                }
+            },
+            [&]() {
+                uint64 sum = 0;
+                uint32 batch[BATCH];
+                for (uint32 i = 0; i < ITEMS; ) {
+                    uint32 count = queue->dequeueBulk(batch, BATCH);
+                    for (uint32 idx = 0; idx < count; idx++) sum += batch[idx];
+                    i += count;
+                    if (count == 0) std::this_thread::yield();
+                }
+                return sum;
+            });
+        delete queue;
+    }
+    return 0;
+}
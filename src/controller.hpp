@@ -6,9 +6,7 @@ constexpr const uint32 HTTP_STATUS_BAD_REQUEST = 400;
 
 #include "./server/interfaces/irequest.hpp"
 #include "./server/interfaces/iresponse.hpp"
-#include <nlohmann/json.hpp>
-
-using json = nlohmann::json;
+#include "./server/types/http_body.hpp"
 
 static void handleHello(IRequest* req, IResponse* res) {
     String responseBody = format("Hello, API World! : {}", req->getPath().c_str());
@@ -17,20 +15,39 @@ static void handleHello(IRequest* req, IResponse* res) {
     res->setBody(responseBody.c_str());
 }
 
+struct HelloRequest {
+    String name;
+};
+SA_JSON_BINDING(HelloRequest,
+    SA_JSON_FIELD(HelloRequest, name))
+
 static void handlePost(IRequest* req, IResponse* res) {
-    try {
-        json reqJson = json::parse(req->getBody().c_str());
-        
-        if (reqJson.contains("name")) {
-            String responseBody = format("JSON parsed successfully: hello {}", reqJson["name"].get<String>().c_str());
-            res->setStatus(HTTP_STATUS_OK, "OK");
-            res->setBody(responseBody.c_str());
-        }
-    } catch (const json::exception& e) {
-        String responseBody{"Invalid Json format"};
-        res->setStatus(HTTP_STATUS_BAD_REQUEST, "BadRequest");
-        res->setBody(responseBody.c_str());
+    HelloRequest hello;
+
+    if (!readBody(req, res, hello)) {
+        return;
+    }
+
+    String responseBody = format("JSON parsed successfully: hello {}", hello.name.c_str());
+    res->setStatus(HTTP_STATUS_OK, "OK");
+    res->setBody(responseBody.c_str());
+}
+
+struct HelloResponse {
+    String message;
+};
+SA_JSON_BINDING(HelloResponse,
+    SA_JSON_FIELD(HelloResponse, message))
+
+/** Same input as handlePost, answered as a typed body: JSON, CBOR or MessagePack per Accept. */
+static void handleGreeting(IRequest* req, IResponse* res) {
+    HelloRequest hello;
+
+    if (!readBody(req, res, hello)) {
+        return;
     }
+
+    sendBody(req, res, HelloResponse{ format("hello {}", hello.name.c_str()) });
 }
 
 static void handleStatus(IRequest *req, IResponse *res) {
@@ -0,0 +1,33 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef arena_json_hpp
+#define arena_json_hpp
+
+#include "../stl/monotonic_arena.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * ArenaJson - nlohmann::basic_json whose objects, arrays and strings all live in the
+ * thread's current MonotonicArena, for when a handler really needs a DOM.
+ *
+ * Parsing no longer goes through malloc for every node, and freeing the document costs
+ * nothing: the worker resets its arena as soon as the handler returns (or throws), before
+ * the response is compressed and sent. Build and drop an ArenaJson inside the handler (an
+ * ArenaScope is bound around it); never keep one past it, nor build one inside a
+ * parallelFor body, which runs with no arena bound.
+ */
+
+typedef std::basic_string< char, std::char_traits< char >, ArenaStlAllocator< char > > ArenaString;
+
+typedef nlohmann::basic_json< std::map, std::vector, ArenaString, bool, std::int64_t, std::uint64_t,
+                              double, ArenaStlAllocator > ArenaJson;
+
+#endif // arena_json_hpp
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef body_format_hpp
+#define body_format_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+
+#include <string_view>
+
+/**
+ * Body formats a handler can read and write, and their negotiation: Content-Type names the
+ * format of a request body, Accept picks the format of the response. Service to service
+ * traffic uses CBOR or MessagePack to skip text parsing; everything else stays JSON.
+ */
+enum BodyFormat : uint8 {
+    BODY_FORMAT_JSON,
+    BODY_FORMAT_CBOR,
+    BODY_FORMAT_MSGPACK,
+    BODY_FORMAT_UNSUPPORTED
+};
+
+/** Lower cased media type of a header value, parameters dropped. */
+inline String _bodyMediaType(std::string_view value) {
+    return lowerCased(trimmed(value.substr(0, value.find(';'))));
+}
+
+inline BodyFormat _bodyFormatOfMediaType(std::string_view mediaType) {
+    if (mediaType == "application/json" || (mediaType.size() > 5 && mediaType.ends_with("+json"))) {
+        return BODY_FORMAT_JSON;
+    }
+    if (mediaType == "application/cbor") {
+        return BODY_FORMAT_CBOR;
+    }
+    if (mediaType == "application/msgpack" || mediaType == "application/x-msgpack" || mediaType == "application/vnd.msgpack") {
+        return BODY_FORMAT_MSGPACK;
+    }
+    return BODY_FORMAT_UNSUPPORTED;
+}
+
+/** Format of a request body. No Content-Type at all is taken as JSON. */
+inline BodyFormat bodyFormatOfContentType(std::string_view contentType) {
+    if (trimmed(contentType).empty()) {
+        return BODY_FORMAT_JSON;
+    }
+    return _bodyFormatOfMediaType(_bodyMediaType(contentType));
+}
+
+/**
+ * The q parameter of an Accept style entry (media range, coding...), in thousandths; 1000
+ * when absent or malformed.
+ */
+inline uint32 parseQuality(std::string_view range) {
+    for (size_t semicolon = range.find(';'); semicolon != std::string_view::npos; semicolon = range.find(';', semicolon + 1)) {
+        std::string_view param = trimmed(range.substr(semicolon + 1, range.find(';', semicolon + 1) - semicolon - 1));
+
+        if (param.size() < 3 || (param[0] | 0x20) != 'q' || param[1] != '=') continue;
+
+        std::string_view number  = param.substr(2);
+        uint32           quality = 0;
+        if (number.empty() || (number[0] != '0' && number[0] != '1')) return 1000;
+
+        quality = (uint32)(number[0] - '0') * 1000;
+        if (number.size() > 1 && number[1] == '.') {
+            uint32 scale = 100;
+            for (size_t idx = 2; idx < number.size() && idx < 5 && number[idx] >= '0' && number[idx] <= '9'; idx++, scale /= 10) {
+                quality += (uint32)(number[idx] - '0') * scale;
+            }
+        }
+        return quality > 1000 ? 1000 : quality;
+    }
+    return 1000;
+}
+
+/**
+ * Format of the response: the supported media range with the highest q, the first one on a
+ * tie; wildcards mean JSON. No Accept at all is JSON, nothing acceptable is UNSUPPORTED.
+ */
+inline BodyFormat bodyFormatForAccept(std::string_view accept) {
+    if (trimmed(accept).empty()) {
+        return BODY_FORMAT_JSON;
+    }
+
+    BodyFormat best        = BODY_FORMAT_UNSUPPORTED;
+    uint32     bestQuality = 0;
+
+    while (!accept.empty()) {
+        size_t           comma = accept.find(',');
+        std::string_view range = accept.substr(0, comma);
+        accept = (comma == std::string_view::npos) ? std::string_view() : accept.substr(comma + 1);
+
+        String     mediaType = _bodyMediaType(range);
+        BodyFormat format    = (mediaType == "*/*" || mediaType == "application/*") ? BODY_FORMAT_JSON : _bodyFormatOfMediaType(mediaType);
+        uint32     quality   = parseQuality(range);
+
+        if (format != BODY_FORMAT_UNSUPPORTED && quality > bestQuality) {
+            best        = format;
+            bestQuality = quality;
+        }
+    }
+
+    return best;
+}
+
+inline const char* bodyFormatMediaType(BodyFormat format) {
+    switch (format) {
+        case BODY_FORMAT_CBOR:    return "application/cbor";
+        case BODY_FORMAT_MSGPACK: return "application/msgpack";
+        default:                  return "application/json";
+    }
+}
+
+#endif // body_format_hpp
@@ -0,0 +1,365 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef fast_number_hpp
+#define fast_number_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+#include "./fast_number_tables.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Fast JSON number conversion, straight from the input span: no token copy, no locale, one
+ * pass for grammar and value.
+ *
+ * Digits are read 8 at a time with SWAR (one 64 bit load, three multiplies). Integers that
+ * fit come back as int64 (uint64 past INT64_MAX); everything else as a double, correctly
+ * rounded: Clinger's fast path when mantissa and power of ten are both exact doubles,
+ * otherwise Eisel-Lemire (a 64x128 bit product against a table of powers of five). The rare
+ * inputs neither can decide (more than 19 significant digits, a product too close to a
+ * halfway point) go to std::from_chars.
+ *
+ * Numbers that overflow a double are rejected, underflow rounds to zero, as in nlohmann.
+ */
+
+/** GCC/Clang 128 bit integer; __extension__ keeps -Wpedantic quiet. */
+__extension__ typedef unsigned __int128 uint128;
+
+enum JsonNumberKind : uint8 {
+    JSON_NUMBER_INT64,
+    JSON_NUMBER_UINT64,
+    JSON_NUMBER_DOUBLE
+};
+
+struct JsonNumber {
+    JsonNumberKind kind = JSON_NUMBER_INT64;
+    union {
+        long long  asInt64 = 0;
+        uint64     asUint64;
+        double     asDouble;
+    };
+
+    template< class T >
+    bool get(T& out) const;
+};
+
+/** Parses the number at ptr, strict JSON grammar. Returns past it, nullptr if invalid. */
+inline const char* jsonParseNumber(const char* ptr, const char* end, JsonNumber& out);
+
+/**
+ * Digits...
+ */
+
+inline bool _jsonIsDigit(const char* ptr, const char* end) {
+    return ptr < end && (uint8)(*ptr - '0') <= 9;
+}
+
+inline uint64 _jsonLoadEight(const char* ptr) {
+    uint64 chunk;
+    ::memcpy(&chunk, ptr, sizeof(chunk));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+
+/** True when all 8 bytes are '0'..'9': high nibbles are 3, and adding 6 carries out of none. */
+inline bool _jsonIsEightDigits(uint64 chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+/** Value of 8 ASCII digits, first digit in the lowest byte: pairs, then quads, then the whole. */
+inline uint32 _jsonParseEightDigits(uint64 chunk) {
+    const uint64 mask = 0x000000FF000000FFull;
+    const uint64 mul1 = 0x000F424000000064ull;   // 100 + (1000000 << 32)
+    const uint64 mul2 = 0x0000271000000001ull;   // 1 + (10000 << 32)
+
+    chunk -= 0x3030303030303030ull;
+    chunk  = (chunk * 10) + (chunk >> 8);
+    chunk  = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+    return (uint32) chunk;
+}
+
+/** Appends the digits at ptr to mantissa (wrapping past 19 digits; callers count). */
+inline const char* _jsonReadDigits(const char* ptr, const char* end, uint64& mantissa) {
+    while (end - ptr >= 8) {
+        uint64 chunk = _jsonLoadEight(ptr);
+        if (!_jsonIsEightDigits(chunk)) break;
+
+        mantissa = mantissa * 100000000 + _jsonParseEightDigits(chunk);
+        ptr += 8;
+    }
+    while (_jsonIsDigit(ptr, end)) {
+        mantissa = mantissa * 10 + (uint64)(*ptr - '0');
+        ptr++;
+    }
+    return ptr;
+}
+
+/**
+ * Doubles...
+ */
+
+inline double _jsonFromBits(uint64 bits, bool negative) {
+    bits |= (uint64) negative << 63;
+
+    double value;
+    ::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Eisel-Lemire: mantissa * 10^exponent as the nearest double, mantissa != 0. False when the
+ * truncated product cannot tell which way to round (callers fall back to from_chars).
+ */
+inline bool _jsonEiselLemire(uint64 mantissa, long long exponent, bool negative, double& out) {
+    if (exponent < JSON_POW5_MIN_EXPONENT) {
+        out = _jsonFromBits(0, negative);
+        return true;
+    }
+    if (exponent > JSON_POW5_MAX_EXPONENT) {
+        out = _jsonFromBits(0x7FFull << 52, negative);
+        return true;
+    }
+
+    uint32 leadingZeros = __builtin_clzll(mantissa);
+    uint64 normalized   = mantissa << leadingZeros;
+    uint32 index        = 2 * (uint32)(exponent - JSON_POW5_MIN_EXPONENT);
+
+    uint128           first = (uint128) normalized * JSON_POW5_128[index];
+    uint64            high  = (uint64)(first >> 64);
+    uint64            low   = (uint64) first;
+
+    // Only 55 bits of high are needed: refine with the low half of 5^q when they may be off
+    const uint64 PRECISION_MASK = 0xFFFFFFFFFFFFFFFFull >> 55;
+    if ((high & PRECISION_MASK) == PRECISION_MASK) {
+        uint128           second     = (uint128) normalized * JSON_POW5_128[index + 1];
+        uint64            secondHigh = (uint64)(second >> 64);
+
+        low += secondHigh;
+        if (secondHigh > low) high++;
+
+        if (low == 0xFFFFFFFFFFFFFFFFull && (exponent < -27 || exponent > 55)) {
+            return false;
+        }
+    }
+
+    uint32    upperBit = (uint32)(high >> 63);
+    uint32    shift    = upperBit + 64 - 52 - 3;
+    uint64    bits     = high >> shift;
+    long long power2   = ((((152170 + 65536) * exponent) >> 16) + 63) + upperBit - (long long) leadingZeros + 1023;
+
+    if (power2 <= 0) {
+        // Subnormal
+        if (-power2 + 1 >= 64) {
+            out = _jsonFromBits(0, negative);
+            return true;
+        }
+        bits >>= -power2 + 1;
+        bits  += bits & 1;
+        bits >>= 1;
+        power2 = (bits < (1ull << 52)) ? 0 : 1;
+
+        out = _jsonFromBits(bits | ((uint64) power2 << 52), negative);
+        return true;
+    }
+
+    // Exactly halfway between two doubles (only possible for small powers): round to even
+    if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1 && (bits << shift) == high) {
+        bits &= ~1ull;
+    }
+
+    bits  += bits & 1;
+    bits >>= 1;
+    if (bits >= (2ull << 52)) {
+        bits = 1ull << 52;
+        power2++;
+    }
+    bits &= ~(1ull << 52);
+
+    if (power2 >= 0x7FF) {
+        bits   = 0;
+        power2 = 0x7FF;
+    }
+
+    out = _jsonFromBits(bits | ((uint64) power2 << 52), negative);
+    return true;
+}
+
+/** Correctly rounded in every case, for what the fast paths leave over. */
+inline bool _jsonParseDoubleSlow(const char* begin, const char* end, double& out) {
+    auto result = std::from_chars(begin, end, out);
+
+    if (result.ec == std::errc::result_out_of_range) {
+        // from_chars leaves out untouched: underflow rounds to zero, overflow is an error
+        String text(begin, end);
+        out = std::strtod(text.c_str(), nullptr);
+        return !std::isinf(out);
+    }
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+inline bool _jsonToDouble(uint64 mantissa, long long exponent, bool negative, double& out) {
+    static const double EXACT_POWERS_OF_TEN[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (mantissa == 0) {
+        out = _jsonFromBits(0, negative);
+        return true;
+    }
+
+    // Clinger: both operands exact, so one IEEE operation rounds correctly
+    if (exponent >= -22 && exponent <= 22 && mantissa <= (1ull << 53)) {
+        double value = (double) mantissa;
+        value = exponent < 0 ? value / EXACT_POWERS_OF_TEN[-exponent] : value * EXACT_POWERS_OF_TEN[exponent];
+        out   = negative ? -value : value;
+        return true;
+    }
+
+    return _jsonEiselLemire(mantissa, exponent, negative, out);
+}
+
+/** Leading zeros (and the dot) do not count against the 19 digits a uint64 mantissa holds. */
+inline uint32 _jsonSignificantDigits(const char* ptr, const char* end) {
+    while (ptr < end && (*ptr == '0' || *ptr == '.')) ptr++;
+
+    uint32 count = 0;
+    for (; ptr < end && (*ptr | 0x20) != 'e'; ptr++) {
+        count += *ptr != '.';
+    }
+    return count;
+}
+
+/**
+ * JsonNumber...
+ */
+
+inline const char* jsonParseNumber(const char* ptr, const char* end, JsonNumber& out) {
+    const char* begin    = ptr;
+    bool        negative = ptr < end && *ptr == '-';
+
+    if (negative) ptr++;
+    if (!_jsonIsDigit(ptr, end)) return nullptr;
+
+    const char* integerBegin = ptr;
+    uint64      mantissa     = 0;
+
+    if (*ptr == '0') {
+        ptr++;   // a leading zero stands alone
+    } else {
+        ptr = _jsonReadDigits(ptr, end, mantissa);
+    }
+
+    uint32    digitCount = (uint32)(ptr - integerBegin);
+    long long exponent   = 0;
+    bool      real       = false;
+
+    if (ptr < end && *ptr == '.') {
+        const char* fractionBegin = ++ptr;
+
+        ptr = _jsonReadDigits(ptr, end, mantissa);
+        if (ptr == fractionBegin) return nullptr;
+
+        digitCount += (uint32)(ptr - fractionBegin);
+        exponent    = -(long long)(ptr - fractionBegin);
+        real        = true;
+    }
+
+    if (ptr < end && (*ptr | 0x20) == 'e') {
+        ptr++;
+        bool negativeExponent = ptr < end && *ptr == '-';
+        if (ptr < end && (*ptr == '+' || *ptr == '-')) ptr++;
+        if (!_jsonIsDigit(ptr, end)) return nullptr;
+
+        // Saturates: past 10^65536 every mantissa is zero or infinity anyway
+        long long explicitExponent = 0;
+        for (; _jsonIsDigit(ptr, end); ptr++) {
+            if (explicitExponent < 0x10000) explicitExponent = explicitExponent * 10 + (*ptr - '0');
+        }
+
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        real      = true;
+    }
+
+    if (!real) {
+        if (digitCount <= 19) {
+            if (!negative) {
+                out.kind = mantissa <= (uint64) std::numeric_limits< long long >::max() ? JSON_NUMBER_INT64 : JSON_NUMBER_UINT64;
+                out.asUint64 = mantissa;
+                return ptr;
+            }
+            if (mantissa <= (1ull << 63)) {
+                out.kind    = JSON_NUMBER_INT64;
+                out.asInt64 = (long long)(0 - mantissa);
+                return ptr;
+            }
+        } else if (digitCount == 20 && !negative) {
+            uint64 value = 0;
+            bool   overflow = false;
+            for (const char* digit = integerBegin; digit < ptr; digit++) {
+                overflow |= __builtin_mul_overflow(value, 10, &value);
+                overflow |= __builtin_add_overflow(value, (uint64)(*digit - '0'), &value);
+            }
+            if (!overflow) {
+                out.kind     = JSON_NUMBER_UINT64;
+                out.asUint64 = value;
+                return ptr;
+            }
+        }
+    }
+
+    out.kind = JSON_NUMBER_DOUBLE;
+
+    if (digitCount <= 19 || _jsonSignificantDigits(integerBegin, ptr) <= 19) {
+        if (_jsonToDouble(mantissa, exponent, negative, out.asDouble)) {
+            return std::isinf(out.asDouble) ? nullptr : ptr;
+        }
+    }
+
+    return _jsonParseDoubleSlow(begin, ptr, out.asDouble) ? ptr : nullptr;
+}
+
+/**
+ * Into any arithmetic type: integers only from integral numbers in their range, floating
+ * point from any number that fits.
+ */
+template< class T >
+bool JsonNumber::get(T& out) const {
+    static_assert(std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "JsonNumber::get needs a number type");
+
+    switch (kind) {
+        case JSON_NUMBER_INT64:
+            if constexpr (std::is_integral_v< T >) {
+                if (!std::in_range< T >(asInt64)) return false;
+            }
+            out = (T) asInt64;
+            return true;
+        case JSON_NUMBER_UINT64:
+            if constexpr (std::is_integral_v< T >) {
+                if (!std::in_range< T >(asUint64)) return false;
+            }
+            out = (T) asUint64;
+            return true;
+        default:
+            if constexpr (std::is_integral_v< T >) {
+                return false;
+            } else {
+                if (std::fabs(asDouble) > (double) std::numeric_limits< T >::max()) return false;
+                out = (T) asDouble;
+                return true;
+            }
+    }
+}
+
+#endif // fast_number_hpp
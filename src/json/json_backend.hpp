@@ -0,0 +1,22 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef json_backend_hpp
+#define json_backend_hpp
+
+#include "../stl/common.hpp"
+
+/**
+ * Which parser reads a route's JSON body (see IRouter::add and jsonRead).
+ *
+ * LAZY (lazy_json.hpp) only checks the structure and reads fields on demand: best for small
+ * bodies of which a handler reads a few fields. TAPE (json_tape.hpp) parses everything up
+ * front with SIMD: best for bulk bodies that are read in full.
+ */
+enum JsonBackend : uint8 {
+    JSON_BACKEND_LAZY,
+    JSON_BACKEND_TAPE
+};
+
+#endif // json_backend_hpp
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef json_binary_writer_hpp
+#define json_binary_writer_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+#include "./body_format.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * JsonBinaryWriter - JsonWriter's counterpart for CBOR (RFC 8949) and MessagePack: streams
+ * the same data model straight into a caller's buffer.
+ *
+ *     JsonBinaryWriter cbor(res->getBodyBuffer(), BODY_FORMAT_CBOR);
+ *     cbor.beginObject(2).key("id").value(id).key("tags").beginArray(tags.size());
+ *
+ * Both formats put the length of a container in front of it, so beginObject and beginArray
+ * take their member / item count. Integers use the shortest encoding; doubles are written
+ * as 32 bit floats when that is exact, as nlohmann does.
+ */
+struct JsonBinaryWriter {
+    JsonBinaryWriter(String& buffer, BodyFormat format);
+
+    JsonBinaryWriter&  beginObject(uint32 count);
+    JsonBinaryWriter&  endObject(void);
+    JsonBinaryWriter&  beginArray(uint32 count);
+    JsonBinaryWriter&  endArray(void);
+    JsonBinaryWriter&  key(std::string_view name);
+
+    JsonBinaryWriter&  value(std::string_view text);
+    JsonBinaryWriter&  value(const char* text);
+    JsonBinaryWriter&  value(const String& text);
+    JsonBinaryWriter&  value(bool flag);
+    JsonBinaryWriter&  value(double number);
+    JsonBinaryWriter&  null(void);
+    template< class T >
+        requires (std::is_integral_v< T > && !std::is_same_v< T, bool >)
+    JsonBinaryWriter&  value(T number);
+
+    String&            out;
+    BodyFormat         format;
+
+private:
+    void               _bigEndian(uint64 number, uint32 bytes);
+    void               _cborHead(uint8 major, uint64 argument);
+    void               _msgpackLength(uint8 fixMarker, uint32 fixLimit, uint8 marker8, uint8 marker16, uint8 marker32, uint64 length);
+    void               _unsigned(uint64 number);
+    void               _negative(long long number);
+};
+
+inline JsonBinaryWriter::JsonBinaryWriter(String& buffer, BodyFormat bodyFormat) : out(buffer), format(bodyFormat) {
+    SA_ASSERT((format == BODY_FORMAT_CBOR || format == BODY_FORMAT_MSGPACK), "JsonBinaryWriter writes CBOR or MessagePack");
+}
+
+inline void JsonBinaryWriter::_bigEndian(uint64 number, uint32 bytes) {
+    char encoded[8];
+
+    for (uint32 idx = 0; idx < bytes; idx++) {
+        encoded[idx] = (char)(number >> (8 * (bytes - 1 - idx)));
+    }
+    out.append(encoded, bytes);
+}
+
+/** Initial byte of a CBOR item and its argument, in the shortest form. */
+inline void JsonBinaryWriter::_cborHead(uint8 major, uint64 argument) {
+    uint8 type = (uint8)(major << 5);
+
+    if (argument < 24) {
+        out += (char)(type | argument);
+    } else if (argument <= 0xFF) {
+        out += (char)(type | 24);
+        _bigEndian(argument, 1);
+    } else if (argument <= 0xFFFF) {
+        out += (char)(type | 25);
+        _bigEndian(argument, 2);
+    } else if (argument <= 0xFFFFFFFF) {
+        out += (char)(type | 26);
+        _bigEndian(argument, 4);
+    } else {
+        out += (char)(type | 27);
+        _bigEndian(argument, 8);
+    }
+}
+
+/** MessagePack strings, arrays and maps: a fix form for short ones, else 8 (strings only), 16 or 32 bit lengths. */
+inline void JsonBinaryWriter::_msgpackLength(uint8 fixMarker, uint32 fixLimit, uint8 marker8, uint8 marker16, uint8 marker32, uint64 length) {
+    if (length < fixLimit) {
+        out += (char)(fixMarker | length);
+    } else if (marker8 != 0 && length <= 0xFF) {
+        out += (char) marker8;
+        _bigEndian(length, 1);
+    } else if (length <= 0xFFFF) {
+        out += (char) marker16;
+        _bigEndian(length, 2);
+    } else {
+        out += (char) marker32;
+        _bigEndian(length, 4);
+    }
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::beginObject(uint32 count) {
+    if (format == BODY_FORMAT_CBOR) {
+        _cborHead(5, count);
+    } else {
+        _msgpackLength(0x80, 16, 0, 0xDE, 0xDF, count);
+    }
+    return *this;
+}
+
+/** Lengths come first in both formats: nothing to close. */
+inline JsonBinaryWriter& JsonBinaryWriter::endObject(void) {
+    return *this;
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::beginArray(uint32 count) {
+    if (format == BODY_FORMAT_CBOR) {
+        _cborHead(4, count);
+    } else {
+        _msgpackLength(0x90, 16, 0, 0xDC, 0xDD, count);
+    }
+    return *this;
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::endArray(void) {
+    return *this;
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::key(std::string_view name) {
+    return value(name);
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::value(std::string_view text) {
+    if (format == BODY_FORMAT_CBOR) {
+        _cborHead(3, text.size());
+    } else {
+        _msgpackLength(0xA0, 32, 0xD9, 0xDA, 0xDB, text.size());
+    }
+    out.append(text.data(), text.size());
+    return *this;
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::value(const char* text) {
+    return value(std::string_view(text));
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::value(const String& text) {
+    return value(std::string_view(text));
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::value(bool flag) {
+    if (format == BODY_FORMAT_CBOR) {
+        out += (char)(flag ? 0xF5 : 0xF4);
+    } else {
+        out += (char)(flag ? 0xC3 : 0xC2);
+    }
+    return *this;
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::null(void) {
+    out += (char)(format == BODY_FORMAT_CBOR ? 0xF6 : 0xC0);
+    return *this;
+}
+
+inline JsonBinaryWriter& JsonBinaryWriter::value(double number) {
+    float single = (float) number;
+
+    if (std::isfinite(number) && (double) single == number) {
+        uint32 bits;
+        ::memcpy(&bits, &single, sizeof(bits));
+        out += (char)(format == BODY_FORMAT_CBOR ? 0xFA : 0xCA);
+        _bigEndian(bits, 4);
+    } else {
+        uint64 bits;
+        ::memcpy(&bits, &number, sizeof(bits));
+        out += (char)(format == BODY_FORMAT_CBOR ? 0xFB : 0xCB);
+        _bigEndian(bits, 8);
+    }
+    return *this;
+}
+
+inline void JsonBinaryWriter::_unsigned(uint64 number) {
+    if (format == BODY_FORMAT_CBOR) {
+        _cborHead(0, number);
+    } else if (number < 0x80) {
+        out += (char) number;
+    } else if (number <= 0xFF) {
+        out += (char) 0xCC;
+        _bigEndian(number, 1);
+    } else if (number <= 0xFFFF) {
+        out += (char) 0xCD;
+        _bigEndian(number, 2);
+    } else if (number <= 0xFFFFFFFF) {
+        out += (char) 0xCE;
+        _bigEndian(number, 4);
+    } else {
+        out += (char) 0xCF;
+        _bigEndian(number, 8);
+    }
+}
+
+inline void JsonBinaryWriter::_negative(long long number) {
+    if (format == BODY_FORMAT_CBOR) {
+        _cborHead(1, (uint64)(-(number + 1)));
+    } else if (number >= -32) {
+        out += (char)(uint8) number;
+    } else if (number >= -128) {
+        out += (char) 0xD0;
+        _bigEndian((uint64) number, 1);
+    } else if (number >= -32768) {
+        out += (char) 0xD1;
+        _bigEndian((uint64) number, 2);
+    } else if (number >= -2147483648ll) {
+        out += (char) 0xD2;
+        _bigEndian((uint64) number, 4);
+    } else {
+        out += (char) 0xD3;
+        _bigEndian((uint64) number, 8);
+    }
+}
+
+template< class T >
+    requires (std::is_integral_v< T > && !std::is_same_v< T, bool >)
+JsonBinaryWriter& JsonBinaryWriter::value(T number) {
+    if constexpr (std::is_signed_v< T >) {
+        if (number < 0) {
+            _negative((long long) number);
+            return *this;
+        }
+    }
+    _unsigned((uint64) number);
+    return *this;
+}
+
+#endif // json_binary_writer_hpp
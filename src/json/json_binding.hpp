@@ -0,0 +1,439 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef json_binding_hpp
+#define json_binding_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+#include "./body_format.hpp"
+#include "./json_backend.hpp"
+#include "./json_binary_writer.hpp"
+#include "./json_tape.hpp"
+#include "./json_writer.hpp"
+#include "./lazy_json.hpp"
+
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Typed JSON binding - reads a body straight into the members of a struct, and writes it
+ * back, without a DOM.
+ *
+ * A struct opts in by listing its members once, next to its declaration:
+ *
+ *     struct HelloRequest {
+ *         String    name;
+ *         long long age = 0;
+ *     };
+ *     SA_JSON_BINDING(HelloRequest,
+ *         SA_JSON_FIELD(HelloRequest, name),
+ *         SA_JSON_FIELD(HelloRequest, age, JSON_OPTIONAL))
+ *
+ * The key hashes are computed at compile time; reading walks the members of the object once,
+ * hashes each key and jumps over the values of unknown keys. Fields are required unless
+ * JSON_OPTIONAL (then absent or null keeps the member's default). A missing required field or
+ * a value of the wrong type fails the read and names the field in JsonReadError.
+ *
+ * Members may be String, bool, integers (range checked), floating point, std::vector of any
+ * of these (std::vector< bool > included), and other bound structs.
+ *
+ * The same binding reads from either backend (JsonBackend): a lazy JsonValue or a JsonTapeValue.
+ * bodyRead and bodyWrite extend it to CBOR and MessagePack bodies (BodyFormat).
+ */
+
+enum JsonFieldFlags : uint32 {
+    JSON_REQUIRED = 0,
+    JSON_OPTIONAL = 1
+};
+
+/** FNV-1a, usable at compile time on the declared keys and at run time on the body's keys. */
+constexpr uint64 jsonKeyHash(std::string_view key) {
+    uint64 hash = 0xcbf29ce484222325ull;
+    for (char ch : key) {
+        hash = (hash ^ (uint8) ch) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+template< class Owner, class Member >
+struct JsonField {
+    std::string_view  key;
+    uint64            hash;
+    Member Owner::*   member;
+    uint32            flags;
+};
+
+template< class Owner, class Member >
+constexpr JsonField< Owner, Member > jsonField(std::string_view key, Member Owner::* member, uint32 flags = JSON_REQUIRED) {
+    return JsonField< Owner, Member >{ key, jsonKeyHash(key), member, flags };
+}
+
+/** Specialized by SA_JSON_BINDING with a constexpr tuple of JsonField named fields. */
+template< class T >
+struct JsonBinding;
+
+template< class T >
+concept JsonBound = requires { JsonBinding< T >::fields; };
+
+template< class Fields, size_t... IDX >
+constexpr bool _jsonDistinctKeys(const Fields& fields, std::index_sequence< IDX... >) {
+    uint64 hashes[] = { std::get< IDX >(fields).hash... };
+
+    for (size_t lhs = 0; lhs < sizeof...(IDX); lhs++) {
+        for (size_t rhs = lhs + 1; rhs < sizeof...(IDX); rhs++) {
+            if (hashes[lhs] == hashes[rhs]) return false;
+        }
+    }
+    return true;
+}
+
+#define SA_JSON_FIELD(Type, member, ...) jsonField(#member, &Type::member __VA_OPT__(,) __VA_ARGS__)
+
+#define SA_JSON_BINDING(Type, ...)                                                                              \
+    template<>                                                                                                  \
+    struct JsonBinding< Type > {                                                                                \
+        static constexpr auto fields = std::make_tuple(__VA_ARGS__);                                            \
+        static constexpr size_t COUNT = std::tuple_size_v< std::remove_const_t< decltype(fields) > >;           \
+        static_assert(COUNT > 0 && COUNT <= 64, "A JSON binding holds 1 to 64 fields");                         \
+        static_assert(_jsonDistinctKeys(fields, std::make_index_sequence< COUNT >()), "Duplicate JSON key");    \
+    };
+
+struct JsonReadError {
+    std::string_view  field;
+    const char*       reason = nullptr;
+};
+
+template< JsonBound T >
+bool jsonRead(std::string_view body, T& out, JsonReadError* error = nullptr, JsonBackend backend = JSON_BACKEND_LAZY, bool prevalidated = false);
+template< JsonBound T >
+bool jsonRead(const JsonValue& object, T& out, JsonReadError* error = nullptr);
+template< JsonBound T >
+bool jsonRead(const JsonTapeValue& object, T& out, JsonReadError* error = nullptr);
+
+template< JsonBound T >
+void jsonWrite(JsonWriter& writer, const T& value);
+template< JsonBound T >
+void jsonWrite(JsonBinaryWriter& writer, const T& value);
+template< JsonBound T >
+void jsonWrite(String& out, const T& value);
+template< JsonBound T >
+String jsonWrite(const T& value);
+
+template< JsonBound T >
+bool bodyRead(std::string_view body, BodyFormat format, T& out, JsonReadError* error = nullptr, JsonBackend backend = JSON_BACKEND_LAZY, bool prevalidated = false);
+template< JsonBound T >
+void bodyWrite(String& out, BodyFormat format, const T& value);
+
+/**
+ * Reading...
+ */
+
+/** Reading is written once against the interface JsonValue and JsonTapeValue share. */
+template< class Value >
+bool _jsonReadValue(const Value& value, String& out, JsonReadError&) {
+    return value.getString(out);
+}
+
+template< class Value >
+bool _jsonReadValue(const Value& value, bool& out, JsonReadError&) {
+    return value.getBool(out);
+}
+
+template< class Value, class T >
+    requires (std::is_arithmetic_v< T > && !std::is_same_v< T, bool >)
+bool _jsonReadValue(const Value& value, T& out, JsonReadError&) {
+    return value.getNumber(out);
+}
+
+template< class Value, class T >
+bool _jsonReadValue(const Value& value, std::vector< T >& out, JsonReadError& error) {
+    bool ok = true;
+
+    out.clear();
+    bool wellFormed = value.forEachItem([&](const Value& item) {
+        if constexpr (std::is_same_v< T, bool >) {
+            // std::vector< bool >::back() is a proxy, not a bool&
+            bool flag = false;
+            ok = _jsonReadValue(item, flag, error);
+            out.push_back(flag);
+        } else {
+            out.emplace_back();
+            ok = _jsonReadValue(item, out.back(), error);
+        }
+        return ok;
+    });
+
+    return ok && wellFormed;
+}
+
+template< class Value, JsonBound T >
+bool _jsonReadValue(const Value& value, T& out, JsonReadError& error);
+
+template< class Value, class T, class Field >
+bool _jsonReadField(const Field& field, const Value& value, T& out, JsonReadError& error) {
+    if ((field.flags & JSON_OPTIONAL) && value.isNull()) {
+        return true;
+    }
+    if (_jsonReadValue(value, out.*field.member, error)) {
+        return true;
+    }
+
+    // The innermost field is the one worth reporting
+    if (error.reason == nullptr) {
+        error.field  = field.key;
+        error.reason = "has the wrong type";
+    }
+    return false;
+}
+
+/** Reads value into the field named key, if any; marks it seen. */
+template< class Value, class T, size_t... IDX >
+bool _jsonReadMember(T& out, std::string_view key, uint64 hash, const Value& value,
+                     uint64& seen, JsonReadError& error, std::index_sequence< IDX... >) {
+    constexpr const auto& fields = JsonBinding< T >::fields;
+    bool ok = true;
+
+    (void) ((std::get< IDX >(fields).hash == hash && std::get< IDX >(fields).key == key &&
+             (seen |= 1ull << IDX, ok = _jsonReadField(std::get< IDX >(fields), value, out, error), true)) || ...);
+
+    return ok;
+}
+
+template< class T, size_t... IDX >
+constexpr uint64 _jsonRequiredMask(std::index_sequence< IDX... >) {
+    return (((std::get< IDX >(JsonBinding< T >::fields).flags & JSON_OPTIONAL) ? 0ull : 1ull << IDX) | ... | 0ull);
+}
+
+template< class T, size_t... IDX >
+std::string_view _jsonFieldKey(size_t idx, std::index_sequence< IDX... >) {
+    std::string_view keys[] = { std::get< IDX >(JsonBinding< T >::fields).key... };
+    return keys[idx];
+}
+
+/** The decoded text of a member key: lazy keys may still hold escapes, tape keys never do. */
+inline bool _jsonKeyName(const JsonString& key, String& decoded, std::string_view& name) {
+    if (!key.escaped) {
+        name = key.raw;
+        return true;
+    }
+
+    decoded.clear();
+    if (!key.decode(decoded)) return false;
+
+    name = decoded;
+    return true;
+}
+
+inline bool _jsonKeyName(std::string_view key, String&, std::string_view& name) {
+    name = key;
+    return true;
+}
+
+template< class Value, JsonBound T >
+bool _jsonReadValue(const Value& value, T& out, JsonReadError& error) {
+    constexpr auto   INDEXES  = std::make_index_sequence< JsonBinding< T >::COUNT >();
+    constexpr uint64 REQUIRED = _jsonRequiredMask< T >(INDEXES);
+
+    if (value.type() != JSON_OBJECT) {
+        return false;
+    }
+
+    uint64 seen = 0;
+    bool   ok   = true;
+    String decoded;
+
+    bool wellFormed = value.forEachMember([&](const auto& key, const Value& member) {
+        std::string_view name;
+
+        if (!_jsonKeyName(key, decoded, name)) {
+            error.reason = "has an invalid key";
+            ok = false;
+            return false;
+        }
+
+        ok = _jsonReadMember(out, name, jsonKeyHash(name), member, seen, error, INDEXES);
+        return ok;
+    });
+
+    if (!ok) {
+        return false;
+    }
+    if (!wellFormed) {
+        error.reason = "is malformed";
+        return false;
+    }
+    if ((seen & REQUIRED) != REQUIRED) {
+        error.field  = _jsonFieldKey< T >(__builtin_ctzll(REQUIRED & ~seen), INDEXES);
+        error.reason = "is missing";
+        return false;
+    }
+
+    return true;
+}
+
+template< class Value, JsonBound T >
+bool _jsonReadRoot(const Value& object, T& out, JsonReadError* error) {
+    JsonReadError local;
+
+    if (_jsonReadValue(object, out, local)) {
+        return true;
+    }
+
+    if (local.reason == nullptr) {
+        local.reason = "is not an object";
+    }
+    if (error) *error = local;
+    return false;
+}
+
+template< JsonBound T >
+bool jsonRead(const JsonValue& object, T& out, JsonReadError* error) {
+    return _jsonReadRoot(object, out, error);
+}
+
+template< JsonBound T >
+bool jsonRead(const JsonTapeValue& object, T& out, JsonReadError* error) {
+    return _jsonReadRoot(object, out, error);
+}
+
+/** The tape the body readers parse into, one per thread so its buffers are reused across requests. */
+inline JsonTape& _jsonThreadTape(void) {
+    static thread_local JsonTape tape;
+    return tape;
+}
+
+/**
+ * Fails with an empty field and "is not valid JSON" when the structure is broken. A
+ * prevalidated body (already run through JsonPushParser) skips the lazy backend's structure
+ * check; the tape still parses it, that parse is what builds the tape.
+ */
+template< JsonBound T >
+bool jsonRead(std::string_view body, T& out, JsonReadError* error, JsonBackend backend, bool prevalidated) {
+    if (backend == JSON_BACKEND_TAPE) {
+        JsonTape& tape = _jsonThreadTape();
+
+        if (!tape.parse(body)) {
+            if (error) *error = JsonReadError{ std::string_view(), "is not valid JSON" };
+            return false;
+        }
+        return jsonRead(tape.root(), out, error);
+    }
+
+    JsonDocument doc(body, prevalidated);
+
+    if (!doc.isValid()) {
+        if (error) *error = JsonReadError{ std::string_view(), "is not valid JSON" };
+        return false;
+    }
+    return jsonRead(doc.root(), out, error);
+}
+
+/**
+ * Writing...
+ */
+
+/** Text JSON needs no counts; the binary formats put them ahead of each container. */
+inline void _jsonBeginObject(JsonWriter& writer, uint32)                 { writer.beginObject(); }
+inline void _jsonBeginObject(JsonBinaryWriter& writer, uint32 count)     { writer.beginObject(count); }
+inline void _jsonBeginArray(JsonWriter& writer, uint32)                  { writer.beginArray(); }
+inline void _jsonBeginArray(JsonBinaryWriter& writer, uint32 count)      { writer.beginArray(count); }
+
+template< class Writer >
+void _jsonWriteValue(Writer& writer, const String& value) {
+    writer.value(value);
+}
+
+template< class Writer, class T >
+    requires std::is_arithmetic_v< T >
+void _jsonWriteValue(Writer& writer, T value) {
+    writer.value(value);
+}
+
+template< class Writer, class T >
+void _jsonWriteValue(Writer& writer, const std::vector< T >& values) {
+    _jsonBeginArray(writer, (uint32) values.size());
+    for (const T& value : values) {
+        _jsonWriteValue(writer, value);
+    }
+    writer.endArray();
+}
+
+template< class Writer, JsonBound T >
+void _jsonWriteValue(Writer& writer, const T& value) {
+    _jsonBeginObject(writer, (uint32) JsonBinding< T >::COUNT);
+    std::apply([&](const auto&... field) {
+        ((writer.key(field.key), _jsonWriteValue(writer, value.*field.member)), ...);
+    }, JsonBinding< T >::fields);
+    writer.endObject();
+}
+
+/** Writes value as a JSON object with every bound field, in declaration order. */
+template< JsonBound T >
+void jsonWrite(JsonWriter& writer, const T& value) {
+    _jsonWriteValue(writer, value);
+}
+
+template< JsonBound T >
+void jsonWrite(JsonBinaryWriter& writer, const T& value) {
+    _jsonWriteValue(writer, value);
+}
+
+template< JsonBound T >
+void jsonWrite(String& out, const T& value) {
+    JsonWriter writer(out);
+    _jsonWriteValue(writer, value);
+}
+
+template< JsonBound T >
+String jsonWrite(const T& value) {
+    String out;
+    jsonWrite(out, value);
+    return out;
+}
+
+/**
+ * Bodies in any BodyFormat...
+ */
+
+/**
+ * Reads a body of the given format. CBOR and MessagePack are decoded into the thread's tape
+ * (backend and prevalidated only apply to JSON text); errors are reported as by jsonRead, with
+ * "is not valid JSON" for a malformed document of any format.
+ */
+template< JsonBound T >
+bool bodyRead(std::string_view body, BodyFormat format, T& out, JsonReadError* error, JsonBackend backend, bool prevalidated) {
+    if (format == BODY_FORMAT_JSON) {
+        return jsonRead(body, out, error, backend, prevalidated);
+    }
+
+    JsonTape& tape   = _jsonThreadTape();
+    bool      parsed = false;
+    if (format == BODY_FORMAT_CBOR)    parsed = tape.parseCbor(body);
+    if (format == BODY_FORMAT_MSGPACK) parsed = tape.parseMsgpack(body);
+
+    if (!parsed) {
+        if (error) *error = JsonReadError{ std::string_view(), "is not valid JSON" };
+        return false;
+    }
+    return jsonRead(tape.root(), out, error);
+}
+
+/** Appends value to out in the given format (JSON for UNSUPPORTED). */
+template< JsonBound T >
+void bodyWrite(String& out, BodyFormat format, const T& value) {
+    if (format == BODY_FORMAT_CBOR || format == BODY_FORMAT_MSGPACK) {
+        JsonBinaryWriter writer(out, format);
+        _jsonWriteValue(writer, value);
+        return;
+    }
+
+    JsonWriter writer(out);
+    _jsonWriteValue(writer, value);
+}
+
+#endif // json_binding_hpp
@@ -0,0 +1,398 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef json_push_parser_hpp
+#define json_push_parser_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+
+#include <string_view>
+
+/**
+ * JsonPushParser - Validates the full JSON grammar of a document fed in arbitrary chunks, as
+ * they come off the socket, so a body is checked by the time its last byte arrives and a
+ * malformed one is rejected at the first bad byte instead of after the upload.
+ *
+ * feed() never looks back at previous chunks: the whole state is a few bytes plus the
+ * container stack (one bit per level). The Handler receives SAX style events; strings, keys
+ * and numbers are passed as views of their raw text (escapes not decoded), valid only during
+ * the call. A token split across chunks is reassembled in a small side buffer first, unless
+ * Handler::WANTS_TEXT is false, in which case no text is kept at all.
+ *
+ * Every handler method returns false to abort the parse (status becomes JSON_PUSH_ERROR).
+ */
+
+enum JsonPushStatus : uint8 {
+    JSON_PUSH_INCOMPLETE,
+    JSON_PUSH_COMPLETE,
+    JSON_PUSH_ERROR
+};
+
+/** Only validates. */
+struct JsonNullHandler {
+    static constexpr bool WANTS_TEXT = false;
+
+    bool onNull(void)                 { return true; }
+    bool onBool(bool)                 { return true; }
+    bool onNumber(std::string_view)   { return true; }
+    bool onString(std::string_view)   { return true; }
+    bool onKey(std::string_view)      { return true; }
+    bool onBeginObject(void)          { return true; }
+    bool onEndObject(void)            { return true; }
+    bool onBeginArray(void)           { return true; }
+    bool onEndArray(void)             { return true; }
+};
+
+template< class Handler = JsonNullHandler >
+struct JsonPushParser {
+    enum { MAX_DEPTH = 1024 };
+
+    JsonPushParser();
+    explicit JsonPushParser(const Handler& eventHandler);
+
+    JsonPushStatus  feed(std::string_view chunk);
+    JsonPushStatus  finish(void);
+    JsonPushStatus  status(void) const;
+    uint64          consumed(void) const;
+    void            reset(void);
+
+    Handler         handler;
+
+private:
+    enum State : uint8 {
+        EXPECT_VALUE,
+        EXPECT_VALUE_OR_CLOSE,
+        EXPECT_KEY,
+        EXPECT_KEY_OR_CLOSE,
+        EXPECT_COLON,
+        EXPECT_COMMA_OR_CLOSE,
+        EXPECT_END,
+        IN_STRING,
+        IN_ESCAPE,
+        IN_UNICODE,
+        IN_LITERAL,
+        NUMBER_MINUS,
+        NUMBER_ZERO,
+        NUMBER_INT,
+        NUMBER_DOT,
+        NUMBER_FRACTION,
+        NUMBER_E,
+        NUMBER_E_SIGN,
+        NUMBER_EXPONENT,
+        FAILED
+    };
+
+    bool            _isObject(void) const;
+    bool            _push(bool isObject);
+    bool            _value(void);
+    bool            _emitLiteral(void);
+    bool            _emitNumber(std::string_view text);
+    std::string_view _text(const char* chunk, ulong tokenStart, ulong tokenEnd);
+
+    uint64          containers[MAX_DEPTH / 64];
+    uint64          total         = 0;
+    uint32          depth         = 0;
+    State           state         = EXPECT_VALUE;
+    bool            stringIsKey   = false;
+    bool            splitToken    = false;
+    uint8           unicodeLeft   = 0;
+    uint8           literalKind   = 0;       // true, false, null
+    const char*     literal       = nullptr; // rest of the literal to match
+    String          pending;
+};
+
+template< class Handler >
+JsonPushParser< Handler >::JsonPushParser() {}
+
+template< class Handler >
+JsonPushParser< Handler >::JsonPushParser(const Handler& eventHandler) : handler(eventHandler) {}
+
+template< class Handler >
+void JsonPushParser< Handler >::reset(void) {
+    total       = 0;
+    depth       = 0;
+    state       = EXPECT_VALUE;
+    stringIsKey = false;
+    splitToken  = false;
+    pending.clear();
+}
+
+template< class Handler >
+JsonPushStatus JsonPushParser< Handler >::status(void) const {
+    if (state == FAILED)     return JSON_PUSH_ERROR;
+    if (state == EXPECT_END) return JSON_PUSH_COMPLETE;
+    return JSON_PUSH_INCOMPLETE;
+}
+
+/** Bytes accepted so far; on error, the offset of the offending byte. */
+template< class Handler >
+uint64 JsonPushParser< Handler >::consumed(void) const {
+    return total;
+}
+
+template< class Handler >
+bool JsonPushParser< Handler >::_isObject(void) const {
+    return (containers[(depth - 1) >> 6] >> ((depth - 1) & 63)) & 1;
+}
+
+template< class Handler >
+bool JsonPushParser< Handler >::_push(bool isObject) {
+    if (depth == MAX_DEPTH) {
+        return false;
+    }
+
+    uint64 bit = 1ull << (depth & 63);
+    containers[depth >> 6] = isObject ? (containers[depth >> 6] | bit) : (containers[depth >> 6] & ~bit);
+    depth++;
+    return true;
+}
+
+/** A value just ended: what may follow depends on the enclosing container. */
+template< class Handler >
+bool JsonPushParser< Handler >::_value(void) {
+    state = (depth == 0) ? EXPECT_END : EXPECT_COMMA_OR_CLOSE;
+    return true;
+}
+
+template< class Handler >
+bool JsonPushParser< Handler >::_emitLiteral(void) {
+    bool ok = (literalKind == 2) ? handler.onNull() : handler.onBool(literalKind == 0);
+    return ok && _value();
+}
+
+template< class Handler >
+bool JsonPushParser< Handler >::_emitNumber(std::string_view text) {
+    return handler.onNumber(text) && _value();
+}
+
+/** Text of the token from tokenStart in this chunk (or an earlier one) up to tokenEnd. */
+template< class Handler >
+std::string_view JsonPushParser< Handler >::_text(const char* chunk, ulong tokenStart, ulong tokenEnd) {
+    if constexpr (!Handler::WANTS_TEXT) {
+        return std::string_view();
+    }
+
+    if (!splitToken) {
+        return std::string_view(chunk + tokenStart, tokenEnd - tokenStart);
+    }
+
+    pending.append(chunk + tokenStart, tokenEnd - tokenStart);
+    splitToken = false;
+    return pending;
+}
+
+template< class Handler >
+JsonPushStatus JsonPushParser< Handler >::feed(std::string_view chunk) {
+    const char* data       = chunk.data();
+    ulong       size       = chunk.size();
+    ulong       pos        = 0;
+    ulong       tokenStart = 0;
+
+    if (state == FAILED) {
+        return JSON_PUSH_ERROR;
+    }
+
+    while (pos < size) {
+        char ch = data[pos];
+
+        switch (state) {
+            case IN_STRING: {
+                // Plain characters are the bulk of any body: run over them
+                while (pos < size && data[pos] != '"' && data[pos] != '\\' && (uint8) data[pos] >= 0x20) pos++;
+                if (pos == size) continue;
+
+                ch = data[pos];
+                if (ch == '\\') {
+                    state = IN_ESCAPE;
+                } else if (ch == '"') {
+                    std::string_view text = _text(data, tokenStart, pos);
+                    bool ok = stringIsKey ? handler.onKey(text) : handler.onString(text);
+                    if (!ok) goto fail;
+
+                    if (stringIsKey) {
+                        state = EXPECT_COLON;
+                    } else {
+                        _value();
+                    }
+                } else {
+                    goto fail;
+                }
+                pos++;
+                continue;
+            }
+
+            case IN_ESCAPE:
+                if (ch == 'u') {
+                    state       = IN_UNICODE;
+                    unicodeLeft = 4;
+                } else if (ch == '"' || ch == '\\' || ch == '/' || ch == 'b' || ch == 'f' || ch == 'n' || ch == 'r' || ch == 't') {
+                    state = IN_STRING;
+                } else {
+                    goto fail;
+                }
+                pos++;
+                continue;
+
+            case IN_UNICODE:
+                if (!((ch >= '0' && ch <= '9') || ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f'))) goto fail;
+                if (--unicodeLeft == 0) state = IN_STRING;
+                pos++;
+                continue;
+
+            case IN_LITERAL:
+                if (ch != *literal) goto fail;
+                literal++;
+                pos++;
+                if (*literal == '\0' && !_emitLiteral()) goto fail;
+                continue;
+
+            case NUMBER_MINUS:
+            case NUMBER_ZERO:
+            case NUMBER_INT:
+            case NUMBER_DOT:
+            case NUMBER_FRACTION:
+            case NUMBER_E:
+            case NUMBER_E_SIGN:
+            case NUMBER_EXPONENT: {
+                bool digit = ch >= '0' && ch <= '9';
+
+                if (digit && state != NUMBER_ZERO) {
+                    state = (state == NUMBER_MINUS) ? (ch == '0' ? NUMBER_ZERO : NUMBER_INT)
+                          : (state == NUMBER_DOT) ? NUMBER_FRACTION
+                          : (state == NUMBER_E || state == NUMBER_E_SIGN) ? NUMBER_EXPONENT
+                          : state;
+                } else if (ch == '.' && (state == NUMBER_ZERO || state == NUMBER_INT)) {
+                    state = NUMBER_DOT;
+                } else if ((ch | 0x20) == 'e' && (state == NUMBER_ZERO || state == NUMBER_INT || state == NUMBER_FRACTION)) {
+                    state = NUMBER_E;
+                } else if ((ch == '+' || ch == '-') && state == NUMBER_E) {
+                    state = NUMBER_E_SIGN;
+                } else if (state == NUMBER_ZERO || state == NUMBER_INT || state == NUMBER_FRACTION || state == NUMBER_EXPONENT) {
+                    // The number ended: reread this byte as what follows it
+                    if (!_emitNumber(_text(data, tokenStart, pos))) goto fail;
+                    continue;
+                } else {
+                    goto fail;
+                }
+                pos++;
+                continue;
+            }
+
+            default:
+                break;
+        }
+
+        if (ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t') {
+            pos++;
+            continue;
+        }
+
+        switch (state) {
+            case EXPECT_VALUE:
+            case EXPECT_VALUE_OR_CLOSE:
+                if (ch == ']' && state == EXPECT_VALUE_OR_CLOSE) {
+                    depth--;
+                    if (!handler.onEndArray()) goto fail;
+                    _value();
+                } else if (ch == '{') {
+                    if (!_push(true) || !handler.onBeginObject()) goto fail;
+                    state = EXPECT_KEY_OR_CLOSE;
+                } else if (ch == '[') {
+                    if (!_push(false) || !handler.onBeginArray()) goto fail;
+                    state = EXPECT_VALUE_OR_CLOSE;
+                } else if (ch == '"') {
+                    state       = IN_STRING;
+                    stringIsKey = false;
+                    tokenStart  = pos + 1;
+                } else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+                    state      = (ch == '-') ? NUMBER_MINUS : (ch == '0') ? NUMBER_ZERO : NUMBER_INT;
+                    tokenStart = pos;
+                } else if (ch == 't' || ch == 'f' || ch == 'n') {
+                    static const char* const LITERALS[] = { "true", "false", "null" };
+                    literalKind = (ch == 't') ? 0 : (ch == 'f') ? 1 : 2;
+                    literal     = LITERALS[literalKind] + 1;
+                    state       = IN_LITERAL;
+                } else {
+                    goto fail;
+                }
+                break;
+
+            case EXPECT_KEY:
+            case EXPECT_KEY_OR_CLOSE:
+                if (ch == '}' && state == EXPECT_KEY_OR_CLOSE) {
+                    depth--;
+                    if (!handler.onEndObject()) goto fail;
+                    _value();
+                } else if (ch == '"') {
+                    state       = IN_STRING;
+                    stringIsKey = true;
+                    tokenStart  = pos + 1;
+                } else {
+                    goto fail;
+                }
+                break;
+
+            case EXPECT_COLON:
+                if (ch != ':') goto fail;
+                state = EXPECT_VALUE;
+                break;
+
+            case EXPECT_COMMA_OR_CLOSE:
+                if (ch == ',') {
+                    state = _isObject() ? EXPECT_KEY : EXPECT_VALUE;
+                } else if (ch == (_isObject() ? '}' : ']')) {
+                    bool isObject = _isObject();
+                    depth--;
+                    if (!(isObject ? handler.onEndObject() : handler.onEndArray())) goto fail;
+                    _value();
+                } else {
+                    goto fail;
+                }
+                break;
+
+            default:
+                // EXPECT_END: only whitespace may follow the root value
+                goto fail;
+        }
+        pos++;
+    }
+
+    // Keep the head of a token that continues in the next chunk
+    if constexpr (Handler::WANTS_TEXT) {
+        bool inText = state == IN_STRING || state == IN_ESCAPE || state == IN_UNICODE || (state >= NUMBER_MINUS && state <= NUMBER_EXPONENT);
+        if (inText) {
+            if (!splitToken) pending.clear();
+            pending.append(data + tokenStart, size - tokenStart);
+            splitToken = true;
+        }
+    }
+
+    total += size;
+    return status();
+
+fail:
+    total += pos;
+    state  = FAILED;
+    return JSON_PUSH_ERROR;
+}
+
+/** End of input: a root number may end here; anything unfinished is an error. */
+template< class Handler >
+JsonPushStatus JsonPushParser< Handler >::finish(void) {
+    bool numberDone = state == NUMBER_ZERO || state == NUMBER_INT || state == NUMBER_FRACTION || state == NUMBER_EXPONENT;
+
+    if (numberDone && depth == 0) {
+        std::string_view text = splitToken ? std::string_view(pending) : std::string_view();
+        splitToken = false;
+        if (!_emitNumber(text)) state = FAILED;
+    }
+
+    if (state != EXPECT_END) {
+        state = FAILED;
+    }
+    return status();
+}
+
+#endif // json_push_parser_hpp
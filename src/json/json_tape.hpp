@@ -0,0 +1,1149 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef json_tape_hpp
+#define json_tape_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+#include "../stl/simd_find.hpp"
+#include "./fast_number.hpp"
+#include "./lazy_json.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+/**
+ * JsonTape - Two stage JSON parser for bulk bodies, after simdjson.
+ *
+ * Stage 1 classifies the input 64 bytes at a time (AVX2 when the CPU has it, SSE2 otherwise):
+ * quotes, backslashes, operators, whitespace. Escapes and string regions are resolved with
+ * bit tricks, and the positions of every structural character (operators, opening quotes,
+ * first byte of each number or literal) are written to an index. UTF-8 is validated from
+ * the first non-ASCII block on.
+ *
+ * Stage 2 walks the index only, checks the grammar and writes the tape: one 64 bit word per
+ * value (two for numbers), tag in the top byte. Containers hold the index past their end, so
+ * any subtree is skipped in one step, and their item count. Strings are decoded into a side
+ * buffer, so getString is a view and never allocates.
+ *
+ * parseCbor and parseMsgpack build the same tape from binary bodies.
+ *
+ * A JsonTape keeps its buffers between parses: keep one per worker and the steady state does
+ * not allocate. Values (JsonTapeValue) are views, valid until the next parse.
+ */
+
+enum JsonTapeTag : uint8 {
+    TAPE_OBJECT       = '{',
+    TAPE_OBJECT_END   = '}',
+    TAPE_ARRAY        = '[',
+    TAPE_ARRAY_END    = ']',
+    TAPE_STRING       = '"',
+    TAPE_INT64        = 'l',
+    TAPE_UINT64       = 'u',
+    TAPE_DOUBLE       = 'd',
+    TAPE_TRUE         = 't',
+    TAPE_FALSE        = 'f',
+    TAPE_NULL         = 'n'
+};
+
+struct JsonTape;
+
+struct JsonTapeValue {
+    const JsonTape* tape  = nullptr;
+    uint32          index = 0;
+
+    JsonTapeValue() {}
+    JsonTapeValue(const JsonTape* owner, uint32 idx) : tape(owner), index(idx) {}
+
+    JsonType        type(void) const;
+    bool            exists(void) const;
+    uint32          size(void) const;
+
+    JsonTapeValue   operator [] (std::string_view key) const;
+    JsonTapeValue   operator [] (uint32 idx) const;
+
+    bool            getString(std::string_view& out) const;
+    bool            getString(String& out) const;
+    bool            getInt64(long long& out) const;
+    bool            getUint64(unsigned long long& out) const;
+    bool            getDouble(double& out) const;
+    bool            getBool(bool& out) const;
+    bool            isNull(void) const;
+    template< class T >
+    bool            getNumber(T& out) const;
+
+    template< class Visitor >
+    bool            forEachItem(Visitor visitor) const;
+    template< class Visitor >
+    bool            forEachMember(Visitor visitor) const;
+
+    nlohmann::json  toNlohmann(void) const;
+
+    uint8           _tag(void) const;
+    uint64          _payload(void) const;
+    uint32          _after(void) const;
+};
+
+struct JsonTape {
+    enum { MAX_DEPTH = 1024 };
+
+    JsonTape();
+
+    bool            parse(std::string_view json);
+    bool            parseCbor(std::string_view body);
+    bool            parseMsgpack(std::string_view body);
+    JsonTapeValue   root(void) const;
+    const char*     error(void) const;
+    uint32          errorOffset(void) const;
+
+    uint32          _indexStructurals(void);
+    bool            _buildTape(void);
+    bool            _fail(const char* message, uint32 offset);
+    bool            _parseString(uint32 pos);
+    bool            _parseNumber(uint32 pos);
+    bool            _parseLiteral(uint32 pos);
+    bool            _isDelimiter(uint32 pos) const;
+    bool            _parseBinary(std::string_view body, bool isCbor);
+    bool            _decodeCbor(uint32& pos, bool wantKey);
+    bool            _decodeMsgpack(uint32& pos, bool wantKey);
+    bool            _readBigEndian(uint32& pos, uint32 bytes, uint64& out);
+    bool            _binaryContainer(bool isObject, uint64 count, uint32 at, uint32 pos);
+    bool            _binaryString(uint32& pos, uint64 size, bool isKey);
+    void            _binaryItemDone(bool wasKey);
+    void            _emitInteger(uint64 bits, bool isSigned);
+    bool            _emitDouble(double real, uint32 at);
+    bool            _begin(std::string_view input);
+    void            _emit(uint8 tag, uint64 payload);
+    void            _emitNumber(const JsonNumber& number);
+    void            _emitString(std::string_view text);
+    bool            _openContainer(bool isObject, uint32 at);
+    void            _closeContainer(void);
+    void            _countValue(void);
+
+    template< class T >
+    static void     _grow(std::unique_ptr< T[] >& buffer, ulong& capacity, ulong needed);
+
+    static constexpr uint64 BINARY_INDEFINITE = ~0ull;
+
+    struct Frame {
+        uint32 opening;
+        uint32 count;
+        bool   isObject;
+        bool   expectKey;   // binary formats only: items left, and whether a key comes next
+        uint64 remaining;
+    };
+
+    const char*     data        = nullptr;
+    uint32          length      = 0;
+
+    std::unique_ptr< uint32[] > indexes;
+    std::unique_ptr< uint64[] > words;
+    std::unique_ptr< char[] >   strings;
+    ulong                       indexCapacity  = 0;
+    ulong                       wordCapacity   = 0;
+    ulong                       stringCapacity = 0;
+    uint32                      indexCount     = 0;
+    uint32                      wordCount      = 0;
+    ulong                       stringsUsed    = 0;
+
+    Frame           frames[MAX_DEPTH];
+    uint32          depth       = 0;
+
+    const char*     message     = nullptr;
+    uint32          offset      = 0;
+};
+
+/**
+ * Stage 1 kernels...
+ */
+
+struct _JsonBlockBits {
+    uint64 quote;
+    uint64 backslash;
+    uint64 op;        // { } [ ] : ,
+    uint64 space;
+    uint64 control;   // below 0x20
+    uint64 nonAscii;
+};
+
+inline void _jsonClassifyScalar(const char* block, _JsonBlockBits& bits) {
+    bits = _JsonBlockBits{ 0, 0, 0, 0, 0, 0 };
+
+    for (uint32 idx = 0; idx < 64; idx++) {
+        uint8  ch  = (uint8) block[idx];
+        uint64 bit = 1ull << idx;
+
+        if (ch == '"')  bits.quote     |= bit;
+        if (ch == '\\') bits.backslash |= bit;
+        if (ch == '{' || ch == '}' || ch == '[' || ch == ']' || ch == ':' || ch == ',') bits.op |= bit;
+        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') bits.space |= bit;
+        if (ch < 0x20)  bits.control   |= bit;
+        if (ch >= 0x80) bits.nonAscii  |= bit;
+    }
+}
+
+#ifdef SA_SIMD_X86
+
+inline void _jsonClassifySse2(const char* block, _JsonBlockBits& bits) {
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    bits = _JsonBlockBits{ 0, 0, 0, 0, 0, 0 };
+
+    for (uint32 lane = 0; lane < 4; lane++) {
+        __m128i bytes  = _mm_loadu_si128((const __m128i*)(block + 16 * lane));
+        // '[' and ']' are '{' and '}' without 0x20, nothing else folds onto them
+        __m128i folded = _mm_or_si128(bytes, caseBit);
+        __m128i op     = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))));
+        __m128i space  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))),
+                                      _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))));
+        __m128i control = _mm_and_si128(_mm_cmpgt_epi8(caseBit, bytes), _mm_cmpgt_epi8(bytes, _mm_set1_epi8(-1)));
+        uint32  shift  = 16 * lane;
+
+        bits.quote     |= (uint64)(uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'))) << shift;
+        bits.backslash |= (uint64)(uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))) << shift;
+        bits.op        |= (uint64)(uint32) _mm_movemask_epi8(op) << shift;
+        bits.space     |= (uint64)(uint32) _mm_movemask_epi8(space) << shift;
+        bits.control   |= (uint64)(uint32) _mm_movemask_epi8(control) << shift;
+        bits.nonAscii  |= (uint64)(uint32) _mm_movemask_epi8(bytes) << shift;
+    }
+}
+
+__attribute__((target("avx2"))) inline void _jsonClassifyAvx2(const char* block, _JsonBlockBits& bits) {
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    bits = _JsonBlockBits{ 0, 0, 0, 0, 0, 0 };
+
+    for (uint32 lane = 0; lane < 2; lane++) {
+        __m256i bytes  = _mm256_loadu_si256((const __m256i*)(block + 32 * lane));
+        __m256i folded = _mm256_or_si256(bytes, caseBit);
+        __m256i op     = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))));
+        __m256i space  = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'))));
+        __m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(caseBit, bytes), _mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(-1)));
+        uint32  shift  = 32 * lane;
+
+        bits.quote     |= (uint64)(uint32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'))) << shift;
+        bits.backslash |= (uint64)(uint32) _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'))) << shift;
+        bits.op        |= (uint64)(uint32) _mm256_movemask_epi8(op) << shift;
+        bits.space     |= (uint64)(uint32) _mm256_movemask_epi8(space) << shift;
+        bits.control   |= (uint64)(uint32) _mm256_movemask_epi8(control) << shift;
+        bits.nonAscii  |= (uint64)(uint32) _mm256_movemask_epi8(bytes) << shift;
+    }
+}
+
+#endif // SA_SIMD_X86
+
+/** Strict UTF-8: no overlong forms, no surrogates, nothing past U+10FFFF. */
+inline bool jsonValidUtf8(const char* text, ulong size) {
+    const uint8* ptr = (const uint8*) text;
+    const uint8* end = ptr + size;
+
+    while (ptr < end) {
+        // ASCII runs, 8 bytes at a time
+        while (end - ptr >= 8) {
+            uint64 word;
+            ::memcpy(&word, ptr, 8);
+            if (word & 0x8080808080808080ull) break;
+            ptr += 8;
+        }
+        if (ptr == end) break;
+
+        uint8 lead = *ptr;
+        if (lead < 0x80) {
+            ptr++;
+            continue;
+        }
+
+        uint32 count, codePoint;
+        if ((lead & 0xE0) == 0xC0)      { count = 2; codePoint = lead & 0x1F; }
+        else if ((lead & 0xF0) == 0xE0) { count = 3; codePoint = lead & 0x0F; }
+        else if ((lead & 0xF8) == 0xF0) { count = 4; codePoint = lead & 0x07; }
+        else return false;
+
+        if ((ulong)(end - ptr) < count) return false;
+        for (uint32 idx = 1; idx < count; idx++) {
+            if ((ptr[idx] & 0xC0) != 0x80) return false;
+            codePoint = (codePoint << 6) | (ptr[idx] & 0x3F);
+        }
+
+        static const uint32 MIN_CODE_POINT[] = { 0, 0, 0x80, 0x800, 0x10000 };
+        if (codePoint < MIN_CODE_POINT[count] || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return false;
+        }
+        ptr += count;
+    }
+
+    return true;
+}
+
+/**
+ * JsonTape...
+ */
+
+inline JsonTape::JsonTape() {}
+
+inline const char* JsonTape::error(void) const {
+    return message;
+}
+
+/** Byte offset in the input where the error was detected. */
+inline uint32 JsonTape::errorOffset(void) const {
+    return offset;
+}
+
+inline JsonTapeValue JsonTape::root(void) const {
+    return message == nullptr && wordCount > 0 ? JsonTapeValue(this, 0) : JsonTapeValue();
+}
+
+inline bool JsonTape::_fail(const char* why, uint32 at) {
+    message = why;
+    offset  = at;
+    return false;
+}
+
+template< class T >
+void JsonTape::_grow(std::unique_ptr< T[] >& buffer, ulong& capacity, ulong needed) {
+    if (needed <= capacity) {
+        return;
+    }
+
+    capacity = needed + needed / 2;
+    buffer.reset(new T[capacity]);
+}
+
+/** Resets the tape for a new input; the buffers are sized by each parser. */
+inline bool JsonTape::_begin(std::string_view input) {
+    data        = input.data();
+    length      = (uint32) input.size();
+    indexCount  = 0;
+    wordCount   = 0;
+    stringsUsed = 0;
+    depth       = 0;
+    message     = nullptr;
+    offset      = 0;
+
+    if (input.size() >= 0xFFFFFFFFu) {
+        return _fail("Document too large", 0);
+    }
+    return true;
+}
+
+/**
+ * Worst cases: every byte structural; a number per two bytes (two words each); decoded
+ * strings never longer than their source plus a 4 byte length and a NUL each, and 16 bytes
+ * of slack for the vector copy.
+ */
+inline bool JsonTape::parse(std::string_view json) {
+    if (!_begin(json)) {
+        return false;
+    }
+
+    _grow(indexes, indexCapacity, (ulong) length + 1);
+    _grow(words, wordCapacity, (ulong) length + length / 2 + 2);
+    _grow(strings, stringCapacity, (ulong) length * 3 + 64);
+
+    uint32 firstNonAscii = _indexStructurals();
+    if (message != nullptr) {
+        return false;
+    }
+    if (firstNonAscii < length && !jsonValidUtf8(data + firstNonAscii, length - firstNonAscii)) {
+        return _fail("Invalid UTF-8", firstNonAscii);
+    }
+
+    return _buildTape();
+}
+
+/** Stage 1. Returns the offset of the first block holding a non-ASCII byte (length if none). */
+inline uint32 JsonTape::_indexStructurals(void) {
+    void (*classify)(const char*, _JsonBlockBits&) = _jsonClassifyScalar;
+#ifdef SA_SIMD_X86
+    classify = simdHasAvx2() ? _jsonClassifyAvx2 : _jsonClassifySse2;
+#endif // SA_SIMD_X86
+
+    uint64   escapeCarry   = 0;
+    uint64   inStringCarry = 0;
+    uint64   scalarCarry   = 0;
+    uint32   firstNonAscii = length;
+    uint32*  out           = indexes.get();
+    char     padded[64];
+
+    for (uint32 base = 0; base < length; base += 64) {
+        const char* block = data + base;
+        if (length - base < 64) {
+            ::memset(padded, ' ', sizeof(padded));
+            ::memcpy(padded, block, length - base);
+            block = padded;
+        }
+
+        _JsonBlockBits bits;
+        classify(block, bits);
+
+        uint64 escaped  = _jsonEscapedBits(bits.backslash, escapeCarry);
+        uint64 quotes   = bits.quote & ~escaped;
+        uint64 inString = _jsonPrefixXor(quotes) ^ inStringCarry;
+        inStringCarry   = (uint64)((long long) inString >> 63);
+
+        if (bits.control & inString) {
+            _fail("Unescaped control character in string", base + __builtin_ctzll(bits.control & inString));
+            return length;
+        }
+        if (bits.nonAscii && firstNonAscii == length) {
+            firstNonAscii = base;
+        }
+
+        // Numbers and literals: runs of anything else outside strings, indexed by their first byte
+        uint64 scalar      = ~(bits.op | bits.space | bits.quote) & ~inString;
+        uint64 scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+        scalarCarry        = scalar >> 63;
+
+        uint64 structural = (bits.op & ~inString) | (quotes & inString) | scalarStart;
+        while (structural != 0) {
+            *out++ = base + __builtin_ctzll(structural);
+            structural &= structural - 1;
+        }
+    }
+
+    if (inStringCarry) {
+        _fail("Unterminated string", length);
+        return length;
+    }
+
+    indexCount = (uint32)(out - indexes.get());
+    return firstNonAscii;
+}
+
+inline void JsonTape::_emit(uint8 tag, uint64 payload) {
+    words[wordCount++] = ((uint64) tag << 56) | payload;
+}
+
+inline void JsonTape::_emitNumber(const JsonNumber& number) {
+    static const uint8 TAGS[] = { TAPE_INT64, TAPE_UINT64, TAPE_DOUBLE };
+
+    _emit(TAGS[number.kind], 0);
+    ::memcpy(&words[wordCount++], &number.asUint64, sizeof(uint64));
+}
+
+/** Appends an already decoded string: a uint32 length, the bytes, a NUL. */
+inline void JsonTape::_emitString(std::string_view text) {
+    char*  start = strings.get() + stringsUsed;
+    uint32 size  = (uint32) text.size();
+
+    ::memcpy(start, &size, sizeof(size));
+    ::memcpy(start + sizeof(size), text.data(), size);
+    start[sizeof(size) + size] = '\0';
+
+    _emit(TAPE_STRING, stringsUsed);
+    stringsUsed += sizeof(size) + size + 1;
+}
+
+inline bool JsonTape::_openContainer(bool isObject, uint32 at) {
+    if (depth == MAX_DEPTH) {
+        return _fail("Document too deep", at);
+    }
+
+    frames[depth++] = Frame{ wordCount, 0, isObject, false, 0 };
+    _emit(isObject ? TAPE_OBJECT : TAPE_ARRAY, 0);
+    return true;
+}
+
+/** Emits the closing word and patches the opening one with the end index and item count. */
+inline void JsonTape::_closeContainer(void) {
+    Frame  frame = frames[--depth];
+    uint64 count = frame.count < 0xFFFFFF ? frame.count : 0xFFFFFF;
+
+    _emit(frame.isObject ? TAPE_OBJECT_END : TAPE_ARRAY_END, frame.opening);
+    words[frame.opening] |= (count << 32) | wordCount;
+}
+
+inline void JsonTape::_countValue(void) {
+    if (depth > 0) {
+        frames[depth - 1].count++;
+    }
+}
+
+inline bool JsonTape::_isDelimiter(uint32 pos) const {
+    if (pos >= length) return true;
+
+    char ch = data[pos];
+    return ch == ',' || ch == '}' || ch == ']' || ch == ':' || _jsonIsSpace(ch);
+}
+
+inline bool JsonTape::_parseLiteral(uint32 pos) {
+    std::string_view rest(data + pos, length - pos);
+
+    if (rest.starts_with("true") && _isDelimiter(pos + 4))  { _emit(TAPE_TRUE, 0);  return true; }
+    if (rest.starts_with("false") && _isDelimiter(pos + 5)) { _emit(TAPE_FALSE, 0); return true; }
+    if (rest.starts_with("null") && _isDelimiter(pos + 4))  { _emit(TAPE_NULL, 0);  return true; }
+
+    return _fail("Invalid literal", pos);
+}
+
+/** Stores an int64, a uint64 if it only fits there, or a double; the value in the next word. */
+inline bool JsonTape::_parseNumber(uint32 pos) {
+    JsonNumber  number;
+    const char* numberEnd = jsonParseNumber(data + pos, data + length, number);
+
+    if (numberEnd == nullptr || !_isDelimiter((uint32)(numberEnd - data))) {
+        return _fail("Invalid number", pos);
+    }
+
+    _emitNumber(number);
+    return true;
+}
+
+/** Decodes the string opening at pos into the strings buffer: a uint32 length, bytes, a NUL. */
+inline bool JsonTape::_parseString(uint32 pos) {
+    const char* src   = data + pos + 1;
+    const char* end   = data + length;
+    char*       start = strings.get() + stringsUsed;
+    char*       dst   = start + sizeof(uint32);
+
+    while (true) {
+#ifdef SA_SIMD_X86
+        const __m128i quote     = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+
+        while (src + 16 <= end) {
+            __m128i chunk = _mm_loadu_si128((const __m128i*) src);
+            _mm_storeu_si128((__m128i*) dst, chunk);
+
+            uint32 mask = (uint32) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+            if (mask != 0) {
+                src += __builtin_ctz(mask);
+                dst += __builtin_ctz(mask);
+                break;
+            }
+            src += 16;
+            dst += 16;
+        }
+#endif // SA_SIMD_X86
+
+        while (src < end && *src != '"' && *src != '\\') {
+            *dst++ = *src++;
+        }
+
+        if (src == end) {
+            return _fail("Unterminated string", pos);
+        }
+        if (*src == '"') {
+            break;
+        }
+
+        src++;
+        uint32 decoded = _jsonDecodeEscape(src, end, dst);
+        if (decoded == 0) {
+            return _fail("Invalid escape sequence", (uint32)(src - data));
+        }
+        dst += decoded;
+    }
+
+    uint32 size = (uint32)(dst - start - sizeof(uint32));
+    ::memcpy(start, &size, sizeof(size));
+    *dst = '\0';
+
+    _emit(TAPE_STRING, stringsUsed);
+    stringsUsed = dst + 1 - strings.get();
+    return true;
+}
+
+/**
+ * Stage 2: the grammar as a state machine over the structural index. Containers are opened on
+ * a stack; closing one patches its opening word with the end index and item count.
+ */
+inline bool JsonTape::_buildTape(void) {
+    uint32  next = 0;
+    uint32  pos;
+
+    if (indexCount == 0) {
+        return _fail("Empty document", 0);
+    }
+
+    #define SA_TAPE_ADVANCE()                                                               \
+        if (next == indexCount) return _fail("Unexpected end of document", length);        \
+        pos = indexes[next++];
+
+    SA_TAPE_ADVANCE();
+
+parseValue:
+    switch (data[pos]) {
+        case '{':
+        case '[': {
+            bool isObject = data[pos] == '{';
+            if (!_openContainer(isObject, pos)) return false;
+
+            SA_TAPE_ADVANCE();
+            if (data[pos] == (isObject ? '}' : ']')) goto closeContainer;
+            if (isObject) goto parseKey;
+            goto parseValue;
+        }
+        case '"':
+            if (!_parseString(pos)) return false;
+            goto afterValue;
+        case 't':
+        case 'f':
+        case 'n':
+            if (!_parseLiteral(pos)) return false;
+            goto afterValue;
+        default:
+            if (data[pos] != '-' && (data[pos] < '0' || data[pos] > '9')) return _fail("Unexpected character", pos);
+            if (!_parseNumber(pos)) return false;
+            goto afterValue;
+    }
+
+parseKey:
+    if (data[pos] != '"') return _fail("Expected a key", pos);
+    if (!_parseString(pos)) return false;
+    SA_TAPE_ADVANCE();
+    if (data[pos] != ':') return _fail("Expected ':'", pos);
+    SA_TAPE_ADVANCE();
+    goto parseValue;
+
+afterValue:
+    if (depth == 0) {
+        if (next != indexCount) return _fail("Trailing content after the document", indexes[next]);
+        return true;
+    }
+
+    frames[depth - 1].count++;
+    SA_TAPE_ADVANCE();
+
+    if (data[pos] == ',') {
+        SA_TAPE_ADVANCE();
+        if (frames[depth - 1].isObject) goto parseKey;
+        goto parseValue;
+    }
+    if (data[pos] != (frames[depth - 1].isObject ? '}' : ']')) {
+        return _fail("Expected ',' or the end of the container", pos);
+    }
+
+closeContainer:
+    _closeContainer();
+    goto afterValue;
+
+    #undef SA_TAPE_ADVANCE
+}
+
+/**
+ * CBOR and MessagePack decode straight into the tape, so binary bodies land in the same
+ * JsonTapeValue view as text: no DOM, no text JSON in between. Both formats put lengths
+ * first, so the frames count down the items left instead of looking for a closing byte.
+ * Only the JSON data model is accepted: binary strings, extensions, non-string keys and
+ * non-finite numbers are rejected, and text strings are checked for UTF-8.
+ */
+
+inline bool JsonTape::parseCbor(std::string_view body) {
+    return _parseBinary(body, true);
+}
+
+inline bool JsonTape::parseMsgpack(std::string_view body) {
+    return _parseBinary(body, false);
+}
+
+/**
+ * Every item takes at least one input byte: at most two words each (numbers), and at most
+ * five string bytes (an empty string: its length and NUL).
+ */
+inline bool JsonTape::_parseBinary(std::string_view body, bool isCbor) {
+    if (!_begin(body)) {
+        return false;
+    }
+    if (body.empty()) {
+        return _fail("Empty document", 0);
+    }
+
+    _grow(words, wordCapacity, (ulong) length * 2 + 2);
+    _grow(strings, stringCapacity, (ulong) length * 5 + 64);
+
+    uint32 pos = 0;
+    do {
+        bool wantKey = depth > 0 && frames[depth - 1].isObject && frames[depth - 1].expectKey;
+        if (!(isCbor ? _decodeCbor(pos, wantKey) : _decodeMsgpack(pos, wantKey))) {
+            return false;
+        }
+
+        while (depth > 0 && frames[depth - 1].remaining == 0) {
+            _closeContainer();
+            _binaryItemDone(false);
+        }
+    } while (depth > 0);
+
+    if (pos != length) {
+        return _fail("Trailing content after the document", pos);
+    }
+    return true;
+}
+
+inline bool JsonTape::_readBigEndian(uint32& pos, uint32 bytes, uint64& out) {
+    if (bytes > length - pos) {
+        return _fail("Unexpected end of document", length);
+    }
+
+    out = 0;
+    for (uint32 idx = 0; idx < bytes; idx++) {
+        out = (out << 8) | (uint8) data[pos++];
+    }
+    return true;
+}
+
+/** Counts a finished item against its container: keys and values alternate in objects. */
+inline void JsonTape::_binaryItemDone(bool wasKey) {
+    if (depth == 0) {
+        return;
+    }
+
+    Frame& frame = frames[depth - 1];
+    if (frame.remaining != BINARY_INDEFINITE) frame.remaining--;
+    if (frame.isObject) frame.expectKey = !wasKey;
+    if (!wasKey) frame.count++;
+}
+
+/** Opens a container of count entries (pairs for objects), BINARY_INDEFINITE until a break. */
+inline bool JsonTape::_binaryContainer(bool isObject, uint64 count, uint32 at, uint32 pos) {
+    if (count != BINARY_INDEFINITE && count > (length - pos) / (isObject ? 2 : 1)) {
+        return _fail("Container longer than the document", at);
+    }
+    if (!_openContainer(isObject, at)) {
+        return false;
+    }
+
+    frames[depth - 1].remaining = (count != BINARY_INDEFINITE && isObject) ? count * 2 : count;
+    frames[depth - 1].expectKey = isObject;
+    return true;
+}
+
+inline bool JsonTape::_binaryString(uint32& pos, uint64 size, bool isKey) {
+    if (size > length - pos) {
+        return _fail("Unexpected end of document", length);
+    }
+    if (!jsonValidUtf8(data + pos, size)) {
+        return _fail("Invalid UTF-8", pos);
+    }
+
+    _emitString(std::string_view(data + pos, size));
+    pos += (uint32) size;
+    _binaryItemDone(isKey);
+    return true;
+}
+
+inline void JsonTape::_emitInteger(uint64 bits, bool isSigned) {
+    JsonNumber number;
+    number.kind     = (isSigned || bits <= (uint64) std::numeric_limits< long long >::max()) ? JSON_NUMBER_INT64 : JSON_NUMBER_UINT64;
+    number.asUint64 = bits;
+    _emitNumber(number);
+}
+
+inline bool JsonTape::_emitDouble(double real, uint32 at) {
+    if (!std::isfinite(real)) {
+        return _fail("Number out of range", at);
+    }
+
+    JsonNumber number;
+    number.kind     = JSON_NUMBER_DOUBLE;
+    number.asDouble = real;
+    _emitNumber(number);
+    return true;
+}
+
+inline bool JsonTape::_decodeCbor(uint32& pos, bool wantKey) {
+    uint32 at;
+    uint8  initial;
+    uint8  major;
+    uint8  info;
+    uint64 argument;
+
+    // Tags only annotate the item that follows; JSON sees the item
+    do {
+        at = pos;
+        if (pos >= length) {
+            return _fail("Unexpected end of document", pos);
+        }
+
+        initial  = (uint8) data[pos++];
+        major    = initial >> 5;
+        info     = initial & 0x1F;
+        argument = info;
+
+        if (info >= 24 && info <= 27) {
+            if (!_readBigEndian(pos, 1u << (info - 24), argument)) return false;
+        } else if ((info >= 28 && info <= 30) || (info == 31 && (major < 2 || major == 6))) {
+            return _fail("Malformed binary document", at);
+        }
+    } while (major == 6);
+
+    if (initial == 0xFF) {
+        Frame* frame = depth > 0 ? &frames[depth - 1] : nullptr;
+        if (frame == nullptr || frame->remaining != BINARY_INDEFINITE || (frame->isObject && !frame->expectKey)) {
+            return _fail("Unexpected break", at);
+        }
+        _closeContainer();
+        _binaryItemDone(false);
+        return true;
+    }
+    if (wantKey && major != 3) {
+        return _fail("Object keys must be strings", at);
+    }
+
+    switch (major) {
+        case 0:
+            _emitInteger(argument, false);
+            break;
+        case 1:
+            if (argument > (uint64) std::numeric_limits< long long >::max()) {
+                return _fail("Number out of range", at);
+            }
+            _emitInteger((uint64)(-1 - (long long) argument), true);
+            break;
+        case 2:
+            return _fail("Binary values are not supported", at);
+        case 3: {
+            if (info != 31) {
+                return _binaryString(pos, argument, wantKey);
+            }
+
+            // Indefinite length: definite text chunks up to a break, joined in place
+            char*  start = strings.get() + stringsUsed;
+            uint32 size  = 0;
+            uint64 chunk;
+
+            while (pos < length && (uint8) data[pos] != 0xFF) {
+                uint8 head = (uint8) data[pos++];
+                if ((head >> 5) != 3 || (head & 0x1F) > 27) {
+                    return _fail("Malformed binary document", pos - 1);
+                }
+
+                chunk = head & 0x1F;
+                if (chunk >= 24 && !_readBigEndian(pos, 1u << (chunk - 24), chunk)) return false;
+                if (chunk > length - pos) return _fail("Unexpected end of document", length);
+
+                ::memcpy(start + sizeof(size) + size, data + pos, chunk);
+                size += (uint32) chunk;
+                pos  += (uint32) chunk;
+            }
+            if (pos++ >= length) {
+                return _fail("Unexpected end of document", length);
+            }
+            if (!jsonValidUtf8(start + sizeof(size), size)) {
+                return _fail("Invalid UTF-8", at);
+            }
+
+            ::memcpy(start, &size, sizeof(size));
+            start[sizeof(size) + size] = '\0';
+            _emit(TAPE_STRING, stringsUsed);
+            stringsUsed += sizeof(size) + size + 1;
+            _binaryItemDone(wantKey);
+            return true;
+        }
+        case 4:
+            return _binaryContainer(false, info == 31 ? BINARY_INDEFINITE : argument, at, pos);
+        case 5:
+            return _binaryContainer(true, info == 31 ? BINARY_INDEFINITE : argument, at, pos);
+        default:
+            if (info == 20 || info == 21) {
+                _emit(info == 21 ? TAPE_TRUE : TAPE_FALSE, 0);
+            } else if (info == 22) {
+                _emit(TAPE_NULL, 0);
+            } else if (info == 25) {
+                uint32 exponent = (argument >> 10) & 0x1F;
+                uint32 mantissa = argument & 0x3FF;
+                double real     = exponent == 0  ? std::ldexp(mantissa, -24)
+                                : exponent != 31 ? std::ldexp(mantissa + 1024, (int) exponent - 25)
+                                : std::numeric_limits< double >::infinity();
+                if (!_emitDouble((argument & 0x8000) ? -real : real, at)) return false;
+            } else if (info == 26) {
+                uint32 bits = (uint32) argument;
+                float  single;
+                ::memcpy(&single, &bits, sizeof(single));
+                if (!_emitDouble(single, at)) return false;
+            } else if (info == 27) {
+                double real;
+                ::memcpy(&real, &argument, sizeof(real));
+                if (!_emitDouble(real, at)) return false;
+            } else {
+                return _fail("Unsupported simple value", at);
+            }
+            break;
+    }
+
+    _binaryItemDone(false);
+    return true;
+}
+
+inline bool JsonTape::_decodeMsgpack(uint32& pos, bool wantKey) {
+    uint32 at = pos;
+    if (pos >= length) {
+        return _fail("Unexpected end of document", pos);
+    }
+
+    uint8  marker   = (uint8) data[pos++];
+    uint64 argument = 0;
+    bool   isString = (marker >= 0xA0 && marker <= 0xBF) || (marker >= 0xD9 && marker <= 0xDB);
+
+    if (wantKey && !isString) {
+        return _fail("Object keys must be strings", at);
+    }
+
+    if (marker <= 0x7F) {
+        _emitInteger(marker, false);
+    } else if (marker <= 0x8F) {
+        return _binaryContainer(true, marker & 0x0F, at, pos);
+    } else if (marker <= 0x9F) {
+        return _binaryContainer(false, marker & 0x0F, at, pos);
+    } else if (marker <= 0xBF) {
+        return _binaryString(pos, marker & 0x1F, wantKey);
+    } else if (marker >= 0xE0) {
+        _emitInteger((uint64)(long long)(signed char) marker, true);
+    } else {
+        switch (marker) {
+            case 0xC0: _emit(TAPE_NULL, 0);  break;
+            case 0xC2: _emit(TAPE_FALSE, 0); break;
+            case 0xC3: _emit(TAPE_TRUE, 0);  break;
+            case 0xCA: {
+                if (!_readBigEndian(pos, 4, argument)) return false;
+                uint32 bits = (uint32) argument;
+                float  single;
+                ::memcpy(&single, &bits, sizeof(single));
+                if (!_emitDouble(single, at)) return false;
+                break;
+            }
+            case 0xCB: {
+                if (!_readBigEndian(pos, 8, argument)) return false;
+                double real;
+                ::memcpy(&real, &argument, sizeof(real));
+                if (!_emitDouble(real, at)) return false;
+                break;
+            }
+            case 0xCC: case 0xCD: case 0xCE: case 0xCF:
+                if (!_readBigEndian(pos, 1u << (marker - 0xCC), argument)) return false;
+                _emitInteger(argument, false);
+                break;
+            case 0xD0: case 0xD1: case 0xD2: case 0xD3: {
+                uint32 shift = 64 - (8u << (marker - 0xD0));
+                if (!_readBigEndian(pos, 1u << (marker - 0xD0), argument)) return false;
+                _emitInteger((uint64)((long long)(argument << shift) >> shift), true);
+                break;
+            }
+            case 0xD9: case 0xDA: case 0xDB:
+                if (!_readBigEndian(pos, 1u << (marker - 0xD9), argument)) return false;
+                return _binaryString(pos, argument, wantKey);
+            case 0xDC: case 0xDD:
+                if (!_readBigEndian(pos, marker == 0xDC ? 2 : 4, argument)) return false;
+                return _binaryContainer(false, argument, at, pos);
+            case 0xDE: case 0xDF:
+                if (!_readBigEndian(pos, marker == 0xDE ? 2 : 4, argument)) return false;
+                return _binaryContainer(true, argument, at, pos);
+            case 0xC1:
+                return _fail("Malformed binary document", at);
+            default:
+                return _fail("Binary values are not supported", at);
+        }
+    }
+
+    _binaryItemDone(false);
+    return true;
+}
+
+/**
+ * JsonTapeValue...
+ */
+
+inline uint8 JsonTapeValue::_tag(void) const {
+    return (uint8)(tape->words[index] >> 56);
+}
+
+inline uint64 JsonTapeValue::_payload(void) const {
+    return tape->words[index] & 0x00FFFFFFFFFFFFFFull;
+}
+
+/** Index of the word after this value. */
+inline uint32 JsonTapeValue::_after(void) const {
+    switch (_tag()) {
+        case TAPE_OBJECT:
+        case TAPE_ARRAY:  return (uint32) _payload();
+        case TAPE_INT64:
+        case TAPE_UINT64:
+        case TAPE_DOUBLE: return index + 2;
+        default:          return index + 1;
+    }
+}
+
+inline JsonType JsonTapeValue::type(void) const {
+    if (tape == nullptr) return JSON_MISSING;
+
+    switch (_tag()) {
+        case TAPE_OBJECT: return JSON_OBJECT;
+        case TAPE_ARRAY:  return JSON_ARRAY;
+        case TAPE_STRING: return JSON_STRING;
+        case TAPE_TRUE:
+        case TAPE_FALSE:  return JSON_BOOL;
+        case TAPE_NULL:   return JSON_NULL;
+        default:          return JSON_NUMBER;
+    }
+}
+
+inline bool JsonTapeValue::exists(void) const {
+    return tape != nullptr;
+}
+
+/** Items of an array or members of an object (saturates at 2^24 - 1); 0 for scalars. */
+inline uint32 JsonTapeValue::size(void) const {
+    JsonType kind = type();
+    return (kind == JSON_OBJECT || kind == JSON_ARRAY) ? (uint32)((_payload() >> 32) & 0xFFFFFF) : 0;
+}
+
+template< class Visitor >
+bool JsonTapeValue::forEachItem(Visitor visitor) const {
+    if (type() != JSON_ARRAY) return false;
+
+    for (JsonTapeValue item(tape, index + 1); item._tag() != TAPE_ARRAY_END; item.index = item._after()) {
+        if (!visitor(item)) break;
+    }
+    return true;
+}
+
+/** Calls visitor(key, value); keys are decoded. */
+template< class Visitor >
+bool JsonTapeValue::forEachMember(Visitor visitor) const {
+    if (type() != JSON_OBJECT) return false;
+
+    for (uint32 at = index + 1; (uint8)(tape->words[at] >> 56) != TAPE_OBJECT_END; ) {
+        std::string_view key;
+        JsonTapeValue(tape, at).getString(key);
+
+        JsonTapeValue value(tape, at + 1);
+        if (!visitor(key, value)) break;
+        at = value._after();
+    }
+    return true;
+}
+
+inline JsonTapeValue JsonTapeValue::operator [] (std::string_view key) const {
+    JsonTapeValue found;
+
+    forEachMember([&](std::string_view name, const JsonTapeValue& value) {
+        if (name != key) return true;
+        found = value;
+        return false;
+    });
+
+    return found;
+}
+
+inline JsonTapeValue JsonTapeValue::operator [] (uint32 idx) const {
+    if (idx >= size()) return JsonTapeValue();
+
+    JsonTapeValue item(tape, index + 1);
+    while (idx-- > 0) {
+        item.index = item._after();
+    }
+    return item;
+}
+
+inline bool JsonTapeValue::getString(std::string_view& out) const {
+    if (type() != JSON_STRING) return false;
+
+    const char* at = tape->strings.get() + _payload();
+    uint32      size;
+    ::memcpy(&size, at, sizeof(size));
+
+    out = std::string_view(at + sizeof(size), size);
+    return true;
+}
+
+inline bool JsonTapeValue::getString(String& out) const {
+    std::string_view text;
+    if (!getString(text)) return false;
+
+    out.assign(text);
+    return true;
+}
+
+inline bool JsonTapeValue::getInt64(long long& out) const {
+    return getNumber(out);
+}
+
+inline bool JsonTapeValue::getUint64(unsigned long long& out) const {
+    return getNumber(out);
+}
+
+inline bool JsonTapeValue::getDouble(double& out) const {
+    return getNumber(out);
+}
+
+/**
+ * Into any arithmetic type: integers only from integral JSON numbers in their range, floating
+ * point from any number.
+ */
+template< class T >
+bool JsonTapeValue::getNumber(T& out) const {
+    static_assert(std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "getNumber needs a number type");
+
+    if (type() != JSON_NUMBER) return false;
+
+    JsonNumber number;
+    number.kind = _tag() == TAPE_INT64 ? JSON_NUMBER_INT64 : _tag() == TAPE_UINT64 ? JSON_NUMBER_UINT64 : JSON_NUMBER_DOUBLE;
+    ::memcpy(&number.asUint64, &tape->words[index + 1], sizeof(uint64));
+    return number.get(out);
+}
+
+inline bool JsonTapeValue::getBool(bool& out) const {
+    if (type() != JSON_BOOL) return false;
+
+    out = _tag() == TAPE_TRUE;
+    return true;
+}
+
+inline bool JsonTapeValue::isNull(void) const {
+    return type() == JSON_NULL;
+}
+
+/** Copies the subtree into an nlohmann::json, for code written against the DOM. */
+inline nlohmann::json JsonTapeValue::toNlohmann(void) const {
+    switch (type()) {
+        case JSON_OBJECT: {
+            nlohmann::json object = nlohmann::json::object();
+            forEachMember([&](std::string_view key, const JsonTapeValue& value) {
+                object[std::string(key)] = value.toNlohmann();
+                return true;
+            });
+            return object;
+        }
+        case JSON_ARRAY: {
+            nlohmann::json array = nlohmann::json::array();
+            forEachItem([&](const JsonTapeValue& item) {
+                array.push_back(item.toNlohmann());
+                return true;
+            });
+            return array;
+        }
+        case JSON_STRING: {
+            std::string_view text;
+            getString(text);
+            return nlohmann::json(std::string(text));
+        }
+        case JSON_BOOL:
+            return nlohmann::json(_tag() == TAPE_TRUE);
+        case JSON_NUMBER: {
+            uint64 bits = tape->words[index + 1];
+            if (_tag() == TAPE_INT64)  return nlohmann::json((std::int64_t) bits);
+            if (_tag() == TAPE_UINT64) return nlohmann::json((std::uint64_t) bits);
+
+            double value;
+            ::memcpy(&value, &bits, sizeof(value));
+            return nlohmann::json(value);
+        }
+        case JSON_NULL:
+            return nlohmann::json(nullptr);
+        default:
+            return nlohmann::json();
+    }
+}
+
+#endif // json_tape_hpp
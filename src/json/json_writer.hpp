@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef json_writer_hpp
+#define json_writer_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * JsonWriter - Streams JSON text straight into a caller's buffer, typically the response
+ * body, with no intermediate document or string.
+ *
+ *     JsonWriter json(res->getBodyBuffer());
+ *     json.beginObject().key("items").beginArray();
+ *     for (...) json.beginObject().key("id").value(id).key("name").value(name).endObject();
+ *     json.endArray().endObject();
+ *
+ * Commas and colons are placed by the writer. Integers go through a two digits per step
+ * table, doubles through the shortest round-trip std::to_chars; NaN and infinities are
+ * written as null. Nesting is limited to MAX_DEPTH levels (asserted).
+ */
+struct JsonWriter {
+    enum { MAX_DEPTH = 64 };
+
+    explicit JsonWriter(String& buffer);
+
+    JsonWriter&  beginObject(void);
+    JsonWriter&  endObject(void);
+    JsonWriter&  beginArray(void);
+    JsonWriter&  endArray(void);
+    JsonWriter&  key(std::string_view name);
+
+    JsonWriter&  value(std::string_view text);
+    JsonWriter&  value(const char* text);
+    JsonWriter&  value(const String& text);
+    JsonWriter&  value(bool flag);
+    JsonWriter&  value(double number);
+    JsonWriter&  null(void);
+    template< class T >
+        requires (std::is_integral_v< T > && !std::is_same_v< T, bool >)
+    JsonWriter&  value(T number);
+
+    /** Appends already serialized JSON as one value. */
+    JsonWriter&  raw(std::string_view json);
+
+    bool         isComplete(void) const;
+
+    String&      out;
+
+private:
+    void         _separate(void);
+
+    uint64       hasItems = 0;   // bit N: level N already holds an item
+    uint32       depth    = 0;
+    bool         afterKey = false;
+};
+
+/** Appends text as a quoted JSON string. */
+inline void jsonEscape(String& out, std::string_view text) {
+    static const char HEX[] = "0123456789abcdef";
+
+    out += '"';
+    const char* run = text.data();
+    const char* end = run + text.size();
+
+    for (const char* ptr = run; ptr < end; ptr++) {
+        uint8 ch = (uint8) *ptr;
+        if (ch >= 0x20 && ch != '"' && ch != '\\') continue;
+
+        out.append(run, ptr - run);
+        run = ptr + 1;
+
+        switch (ch) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            case '\b': out += "\\b";  break;
+            case '\f': out += "\\f";  break;
+            default:
+                out += "\\u00";
+                out += HEX[ch >> 4];
+                out += HEX[ch & 0xF];
+        }
+    }
+
+    out.append(run, end - run);
+    out += '"';
+}
+
+/** Writes the decimal digits of value ending at end, returns where they start. */
+inline char* _jsonFormatUnsigned(char* end, uint64 value) {
+    static const char PAIRS[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    while (value >= 100) {
+        uint32 pair = (uint32)(value % 100) * 2;
+        value /= 100;
+        *--end = PAIRS[pair + 1];
+        *--end = PAIRS[pair];
+    }
+    if (value >= 10) {
+        *--end = PAIRS[value * 2 + 1];
+        *--end = PAIRS[value * 2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+inline JsonWriter::JsonWriter(String& buffer) : out(buffer) {}
+
+inline void JsonWriter::_separate(void) {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (hasItems & (1ull << depth)) {
+        out += ',';
+    }
+    hasItems |= 1ull << depth;
+}
+
+inline JsonWriter& JsonWriter::beginObject(void) {
+    SA_ASSERT(depth + 1 < MAX_DEPTH, "JsonWriter nesting too deep!");
+
+    _separate();
+    out += '{';
+    hasItems &= ~(1ull << ++depth);
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::endObject(void) {
+    SA_ASSERT(depth > 0 && !afterKey, "JsonWriter: unbalanced endObject!");
+
+    out += '}';
+    depth--;
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::beginArray(void) {
+    SA_ASSERT(depth + 1 < MAX_DEPTH, "JsonWriter nesting too deep!");
+
+    _separate();
+    out += '[';
+    hasItems &= ~(1ull << ++depth);
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::endArray(void) {
+    SA_ASSERT(depth > 0 && !afterKey, "JsonWriter: unbalanced endArray!");
+
+    out += ']';
+    depth--;
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::key(std::string_view name) {
+    SA_ASSERT(depth > 0 && !afterKey, "JsonWriter: key outside of an object!");
+
+    _separate();
+    jsonEscape(out, name);
+    out += ':';
+    afterKey = true;
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::value(std::string_view text) {
+    _separate();
+    jsonEscape(out, text);
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::value(const char* text) {
+    return value(std::string_view(text));
+}
+
+inline JsonWriter& JsonWriter::value(const String& text) {
+    return value(std::string_view(text));
+}
+
+inline JsonWriter& JsonWriter::value(bool flag) {
+    _separate();
+    out += flag ? "true" : "false";
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) {
+        return null();
+    }
+
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+
+    _separate();
+    out.append(digits, result.ptr - digits);
+    return *this;
+}
+
+template< class T >
+    requires (std::is_integral_v< T > && !std::is_same_v< T, bool >)
+JsonWriter& JsonWriter::value(T number) {
+    char  digits[24];
+    char* end   = digits + sizeof(digits);
+    char* begin;
+
+    if constexpr (std::is_signed_v< T >) {
+        // Negate as unsigned so the minimum value does not overflow
+        uint64 magnitude = number < 0 ? 0 - (uint64) number : (uint64) number;
+        begin = _jsonFormatUnsigned(end, magnitude);
+        if (number < 0) *--begin = '-';
+    } else {
+        begin = _jsonFormatUnsigned(end, (uint64) number);
+    }
+
+    _separate();
+    out.append(begin, end - begin);
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::null(void) {
+    _separate();
+    out += "null";
+    return *this;
+}
+
+inline JsonWriter& JsonWriter::raw(std::string_view json) {
+    _separate();
+    out.append(json);
+    return *this;
+}
+
+/** True once every object and array opened has been closed. */
+inline bool JsonWriter::isComplete(void) const {
+    return depth == 0 && !afterKey;
+}
+
+#endif // json_writer_hpp
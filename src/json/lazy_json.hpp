@@ -0,0 +1,701 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef lazy_json_hpp
+#define lazy_json_hpp
+
+#include "../stl/common.hpp"
+#include "../stl/safe_string.hpp"
+#include "./fast_number.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif // __SSE2__
+
+/**
+ * Lazy JSON - reads a few fields out of a body without building a DOM.
+ *
+ * JsonDocument only checks the structure of the body up front: brackets balanced and
+ * matching, strings terminated, nothing but whitespace after the root value. JsonValue is a
+ * position in the body; looking a field up walks the members of its object and jumps over the
+ * values of the others (nested objects and arrays are skipped 64 bytes at a time). The grammar
+ * of a value is checked when it is read: getInt64 on "12x" fails, it does not throw.
+ *
+ * Nothing is copied: strings come back as JsonString, a view of the raw (still escaped)
+ * characters in the body, decoded on request. The body must outlive the document and values.
+ */
+
+enum JsonType : uint8 {
+    JSON_MISSING,
+    JSON_NULL,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+};
+
+/** Contents of a JSON string, between the quotes, escapes not decoded. */
+struct JsonString {
+    std::string_view raw;
+    bool             escaped = false;
+
+    bool             decode(String& out) const;
+    bool             operator == (std::string_view text) const;
+};
+
+struct JsonValue {
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+
+    JsonValue() {}
+    JsonValue(const char* valueBegin, const char* bodyEnd) : begin(valueBegin), end(bodyEnd) {}
+
+    JsonType   type(void) const;
+    bool       exists(void) const;
+
+    JsonValue  operator [] (std::string_view key) const;
+    JsonValue  operator [] (uint32 idx) const;
+    JsonValue  at(std::string_view pointer) const;
+    uint32     findFields(const std::string_view keys[], JsonValue values[], uint32 count) const;
+
+    bool       getString(JsonString& out) const;
+    bool       getString(String& out) const;
+    bool       getInt64(long long& out) const;
+    bool       getDouble(double& out) const;
+    bool       getBool(bool& out) const;
+    bool       isNull(void) const;
+    std::string_view raw(void) const;
+    template< class T >
+    bool       getNumber(T& out) const;
+
+    template< class Visitor >
+    bool       forEachItem(Visitor visitor) const;
+    template< class Visitor >
+    bool       forEachMember(Visitor visitor) const;
+};
+
+struct JsonDocument {
+    enum { MAX_DEPTH = 1024 };
+
+    explicit JsonDocument(std::string_view body, bool prevalidated = false);
+
+    bool       isValid(void) const;
+    JsonValue  root(void) const;
+
+    std::string_view text;
+    bool             valid;
+
+private:
+    bool       _validate(void) const;
+};
+
+/**
+ * Scanning primitives, on [ptr, end)...
+ */
+
+inline bool _jsonIsSpace(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+inline const char* _jsonSkipSpace(const char* ptr, const char* end) {
+    while (ptr < end && _jsonIsSpace(*ptr)) ptr++;
+    return ptr;
+}
+
+/** Past the closing quote of the string opening at ptr, nullptr if unterminated. */
+inline const char* _jsonSkipString(const char* ptr, const char* end, bool* escaped = nullptr) {
+    ptr++;
+
+#if defined(__SSE2__)
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    while (ptr + 16 <= end) {
+        __m128i block = _mm_loadu_si128((const __m128i*) ptr);
+        uint32  mask  = (uint32) _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)));
+
+        if (mask == 0) {
+            ptr += 16;
+            continue;
+        }
+
+        ptr += __builtin_ctz(mask);
+        if (*ptr == '"') return ptr + 1;
+
+        if (escaped) *escaped = true;
+        ptr += 2;
+    }
+#endif // __SSE2__
+
+    while (ptr < end) {
+        if (*ptr == '"') return ptr + 1;
+        if (*ptr == '\\') {
+            if (escaped) *escaped = true;
+            ptr++;
+        }
+        ptr++;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Bits of a 64 byte block escaped by a backslash. carry: the previous block ended with an
+ * escaping backslash (updated for the next block).
+ */
+inline uint64 _jsonEscapedBits(uint64 backslashes, uint64& carry) {
+    uint64 escaped = carry;
+    carry = 0;
+
+    // Backslashes are rare outside of escaped text: walk them one by one
+    for (uint64 pending = backslashes & ~escaped; pending != 0; pending &= pending - 1) {
+        uint32 idx = __builtin_ctzll(pending);
+        if (escaped & (1ull << idx)) continue;
+
+        if (idx == 63) {
+            carry = 1;
+        } else {
+            escaped |= 1ull << (idx + 1);
+        }
+    }
+    return escaped;
+}
+
+/** Bit i is the XOR of bits 0..i: with the unescaped quotes, the inside of the strings. */
+inline uint64 _jsonPrefixXor(uint64 bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/**
+ * Classifies 64 bytes at a time: which bytes are brackets outside of strings. Escapes are
+ * resolved first (a quote after an odd run of backslashes is content), then the string
+ * regions are the prefix XOR of the remaining quotes. Both carry over to the next block, so
+ * blocks must be fed in order from a position outside any string.
+ */
+struct _JsonBlockScanner {
+    enum { BLOCK_SIZE = 64 };
+
+    uint64 escapeCarry   = 0;
+    uint64 inStringCarry = 0;
+
+    void   scan(const char* block, uint64& opens, uint64& closes);
+
+    /** The last block, padded with spaces. */
+    static const char* pad(const char* ptr, const char* end, char (&padded)[BLOCK_SIZE]);
+};
+
+inline const char* _JsonBlockScanner::pad(const char* ptr, const char* end, char (&padded)[BLOCK_SIZE]) {
+    ::memset(padded, ' ', BLOCK_SIZE);
+    ::memcpy(padded, ptr, end - ptr);
+    return padded;
+}
+
+inline void _JsonBlockScanner::scan(const char* block, uint64& opens, uint64& closes) {
+    uint64 quotes = 0, backslashes = 0;
+    opens = closes = 0;
+
+#if defined(__SSE2__)
+    const __m128i quote      = _mm_set1_epi8('"');
+    const __m128i backslash  = _mm_set1_epi8('\\');
+    const __m128i caseBit    = _mm_set1_epi8(0x20);
+    const __m128i openBrace  = _mm_set1_epi8('{');
+    const __m128i closeBrace = _mm_set1_epi8('}');
+
+    for (uint32 lane = 0; lane < 4; lane++) {
+        __m128i bytes  = _mm_loadu_si128((const __m128i*)(block + 16 * lane));
+        // '[' and ']' are '{' and '}' without 0x20, nothing else folds onto them
+        __m128i folded = _mm_or_si128(bytes, caseBit);
+        uint32  shift  = 16 * lane;
+
+        quotes      |= (uint64)(uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) << shift;
+        backslashes |= (uint64)(uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslash)) << shift;
+        opens       |= (uint64)(uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(folded, openBrace)) << shift;
+        closes      |= (uint64)(uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(folded, closeBrace)) << shift;
+    }
+#else
+    for (uint32 idx = 0; idx < BLOCK_SIZE; idx++) {
+        char   ch  = block[idx];
+        uint64 bit = 1ull << idx;
+
+        if (ch == '"')                  quotes      |= bit;
+        else if (ch == '\\')            backslashes |= bit;
+        else if (ch == '{' || ch == '[') opens      |= bit;
+        else if (ch == '}' || ch == ']') closes     |= bit;
+    }
+#endif // __SSE2__
+
+    uint64 escaped  = _jsonEscapedBits(backslashes, escapeCarry);
+    uint64 inString = _jsonPrefixXor(quotes & ~escaped) ^ inStringCarry;
+
+    inStringCarry = (uint64)((long long) inString >> 63);
+    opens  &= ~inString;
+    closes &= ~inString;
+}
+
+/** Past the bracket closing the object or array opening at ptr, nullptr if there is none. */
+inline const char* _jsonSkipContainer(const char* ptr, const char* end) {
+    _JsonBlockScanner scanner;
+    char              padded[_JsonBlockScanner::BLOCK_SIZE];
+    uint64            depth = 0;
+
+    for (; ptr < end; ptr += _JsonBlockScanner::BLOCK_SIZE) {
+        const char* block = (end - ptr >= _JsonBlockScanner::BLOCK_SIZE) ? ptr : _JsonBlockScanner::pad(ptr, end, padded);
+        uint64      opens, closes;
+
+        scanner.scan(block, opens, closes);
+
+        // The container cannot end in this block: take it whole
+        if (depth > (uint64) __builtin_popcountll(closes)) {
+            depth += __builtin_popcountll(opens) - __builtin_popcountll(closes);
+            continue;
+        }
+
+        for (uint64 brackets = opens | closes; brackets != 0; brackets &= brackets - 1) {
+            uint32 idx = __builtin_ctzll(brackets);
+
+            if (opens & (1ull << idx)) {
+                depth++;
+            } else if (--depth == 0) {
+                return ptr + idx + 1;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/** End of a number or literal: the next separator. */
+inline const char* _jsonScalarEnd(const char* ptr, const char* end) {
+    while (ptr < end && *ptr != ',' && *ptr != '}' && *ptr != ']' && !_jsonIsSpace(*ptr)) ptr++;
+    return ptr;
+}
+
+inline const char* _jsonSkipValue(const char* ptr, const char* end) {
+    if (ptr >= end) return nullptr;
+
+    switch (*ptr) {
+        case '"': return _jsonSkipString(ptr, end);
+        case '{':
+        case '[': return _jsonSkipContainer(ptr, end);
+        default:  return _jsonScalarEnd(ptr, end);
+    }
+}
+
+/**
+ * JsonDocument...
+ */
+
+/** prevalidated: the caller already checked the whole grammar (JsonPushParser), skip the structure pass. */
+inline JsonDocument::JsonDocument(std::string_view body, bool prevalidated) : text(body) {
+    valid = prevalidated || _validate();
+}
+
+inline bool JsonDocument::isValid(void) const {
+    return valid;
+}
+
+inline JsonValue JsonDocument::root(void) const {
+    if (!valid) return JsonValue();
+
+    const char* end = text.data() + text.size();
+    return JsonValue(_jsonSkipSpace(text.data(), end), end);
+}
+
+/**
+ * One pass over the body, a block at a time: brackets outside strings are matched on a stack.
+ */
+inline bool JsonDocument::_validate(void) const {
+    const char* end = text.data() + text.size();
+    const char* ptr = _jsonSkipSpace(text.data(), end);
+
+    if (ptr == end) return false;
+
+    if (*ptr != '{' && *ptr != '[') {
+        ptr = (*ptr == '"') ? _jsonSkipString(ptr, end) : _jsonScalarEnd(ptr, end);
+        return ptr != nullptr && _jsonSkipSpace(ptr, end) == end;
+    }
+
+    _JsonBlockScanner scanner;
+    char              padded[_JsonBlockScanner::BLOCK_SIZE];
+    char              stack[MAX_DEPTH];
+    uint32            depth = 0;
+
+    for (; ptr < end; ptr += _JsonBlockScanner::BLOCK_SIZE) {
+        const char* block = (end - ptr >= _JsonBlockScanner::BLOCK_SIZE) ? ptr : _JsonBlockScanner::pad(ptr, end, padded);
+        uint64      opens, closes;
+
+        scanner.scan(block, opens, closes);
+
+        for (uint64 brackets = opens | closes; brackets != 0; brackets &= brackets - 1) {
+            uint32 idx = __builtin_ctzll(brackets);
+            char   ch  = block[idx];
+
+            if (opens & (1ull << idx)) {
+                if (depth == MAX_DEPTH) return false;
+                stack[depth++] = (ch == '{') ? '}' : ']';
+            } else if (depth == 0 || stack[--depth] != ch) {
+                return false;
+            } else if (depth == 0) {
+                return _jsonSkipSpace(ptr + idx + 1, end) == end;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * JsonString...
+ */
+
+inline bool JsonString::operator == (std::string_view text) const {
+    if (!escaped) return raw == text;
+
+    String decoded;
+    return decode(decoded) && decoded == text;
+}
+
+/** Encodes codePoint at dst, returns the byte count (1 to 4). */
+inline uint32 _jsonWriteUtf8(char* dst, uint32 codePoint) {
+    if (codePoint < 0x80) {
+        dst[0] = (char) codePoint;
+        return 1;
+    }
+    if (codePoint < 0x800) {
+        dst[0] = (char)(0xC0 | (codePoint >> 6));
+        dst[1] = (char)(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000) {
+        dst[0] = (char)(0xE0 | (codePoint >> 12));
+        dst[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        dst[2] = (char)(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    dst[0] = (char)(0xF0 | (codePoint >> 18));
+    dst[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+    dst[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+    dst[3] = (char)(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+inline bool _jsonReadHex4(const char* ptr, const char* end, uint32& value) {
+    if (end - ptr < 4) return false;
+
+    value = 0;
+    for (int idx = 0; idx < 4; idx++) {
+        char ch = ptr[idx];
+        value <<= 4;
+        if (ch >= '0' && ch <= '9')      value |= ch - '0';
+        else if (ch >= 'a' && ch <= 'f') value |= ch - 'a' + 10;
+        else if (ch >= 'A' && ch <= 'F') value |= ch - 'A' + 10;
+        else return false;
+    }
+    return true;
+}
+
+/**
+ * Decodes the escape sequence after a backslash (ptr is past the backslash) into dst.
+ * Returns the bytes written, 0 if the sequence is invalid; ptr moves past the sequence.
+ */
+inline uint32 _jsonDecodeEscape(const char*& ptr, const char* end, char* dst) {
+    if (ptr == end) return 0;
+
+    switch (*ptr++) {
+        case '"':  *dst = '"';  return 1;
+        case '\\': *dst = '\\'; return 1;
+        case '/':  *dst = '/';  return 1;
+        case 'b':  *dst = '\b'; return 1;
+        case 'f':  *dst = '\f'; return 1;
+        case 'n':  *dst = '\n'; return 1;
+        case 'r':  *dst = '\r'; return 1;
+        case 't':  *dst = '\t'; return 1;
+        case 'u':  break;
+        default:   return 0;
+    }
+
+    uint32 codePoint;
+    if (!_jsonReadHex4(ptr, end, codePoint)) return 0;
+    ptr += 4;
+
+    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+        uint32 low;
+        if (end - ptr < 6 || ptr[0] != '\\' || ptr[1] != 'u' || !_jsonReadHex4(ptr + 2, end, low)) return 0;
+        if (low < 0xDC00 || low > 0xDFFF) return 0;
+        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        ptr += 6;
+    } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+        return 0;
+    }
+
+    return _jsonWriteUtf8(dst, codePoint);
+}
+
+/** Appends the decoded characters to out; false on an invalid escape. */
+inline bool JsonString::decode(String& out) const {
+    const char* ptr = raw.data();
+    const char* end = ptr + raw.size();
+
+    out.reserve(out.size() + raw.size());
+
+    while (ptr < end) {
+        const char* backslash = (const char*) ::memchr(ptr, '\\', end - ptr);
+        if (backslash == nullptr) {
+            out.append(ptr, end - ptr);
+            return true;
+        }
+
+        out.append(ptr, backslash - ptr);
+        ptr = backslash + 1;
+
+        char   decoded[4];
+        uint32 length = _jsonDecodeEscape(ptr, end, decoded);
+        if (length == 0) return false;
+        out.append(decoded, length);
+    }
+
+    return true;
+}
+
+/**
+ * JsonValue...
+ */
+
+inline JsonType JsonValue::type(void) const {
+    if (begin == nullptr || begin >= end) return JSON_MISSING;
+
+    switch (*begin) {
+        case '{': return JSON_OBJECT;
+        case '[': return JSON_ARRAY;
+        case '"': return JSON_STRING;
+        case 'n': return JSON_NULL;
+        case 't':
+        case 'f': return JSON_BOOL;
+        default:  return JSON_NUMBER;
+    }
+}
+
+inline bool JsonValue::exists(void) const {
+    return type() != JSON_MISSING;
+}
+
+inline std::string_view JsonValue::raw(void) const {
+    const char* valueEnd = _jsonSkipValue(begin, end);
+    return valueEnd ? std::string_view(begin, valueEnd - begin) : std::string_view();
+}
+
+/**
+ * Calls visitor(key, value) for every member, in order, until it returns false. Returns
+ * false if the value is not an object or is malformed.
+ */
+template< class Visitor >
+bool JsonValue::forEachMember(Visitor visitor) const {
+    if (type() != JSON_OBJECT) return false;
+
+    const char* ptr = _jsonSkipSpace(begin + 1, end);
+    if (ptr < end && *ptr == '}') return true;
+
+    while (ptr < end && *ptr == '"') {
+        JsonString  key;
+        const char* keyEnd = _jsonSkipString(ptr, end, &key.escaped);
+        if (keyEnd == nullptr) return false;
+        key.raw = std::string_view(ptr + 1, keyEnd - ptr - 2);
+
+        ptr = _jsonSkipSpace(keyEnd, end);
+        if (ptr == end || *ptr != ':') return false;
+        ptr = _jsonSkipSpace(ptr + 1, end);
+
+        if (!visitor(key, JsonValue(ptr, end))) return true;
+
+        ptr = _jsonSkipValue(ptr, end);
+        if (ptr == nullptr) return false;
+        ptr = _jsonSkipSpace(ptr, end);
+
+        if (ptr < end && *ptr == '}') return true;
+        if (ptr == end || *ptr != ',') return false;
+        ptr = _jsonSkipSpace(ptr + 1, end);
+    }
+
+    return false;
+}
+
+/** Calls visitor(value) for every item, in order, until it returns false. */
+template< class Visitor >
+bool JsonValue::forEachItem(Visitor visitor) const {
+    if (type() != JSON_ARRAY) return false;
+
+    const char* ptr = _jsonSkipSpace(begin + 1, end);
+    if (ptr < end && *ptr == ']') return true;
+
+    while (ptr < end) {
+        if (!visitor(JsonValue(ptr, end))) return true;
+
+        ptr = _jsonSkipValue(ptr, end);
+        if (ptr == nullptr) return false;
+        ptr = _jsonSkipSpace(ptr, end);
+
+        if (ptr < end && *ptr == ']') return true;
+        if (ptr == end || *ptr != ',') return false;
+        ptr = _jsonSkipSpace(ptr + 1, end);
+    }
+
+    return false;
+}
+
+/** Member key of an object, a missing value if absent (or not an object). */
+inline JsonValue JsonValue::operator [] (std::string_view key) const {
+    JsonValue found;
+
+    forEachMember([&](const JsonString& name, const JsonValue& value) {
+        if (!(name == key)) return true;
+        found = value;
+        return false;
+    });
+
+    return found;
+}
+
+inline JsonValue JsonValue::operator [] (uint32 idx) const {
+    JsonValue found;
+    uint32    current = 0;
+
+    forEachItem([&](const JsonValue& value) {
+        if (current++ != idx) return true;
+        found = value;
+        return false;
+    });
+
+    return found;
+}
+
+/**
+ * Looks several keys up in a single walk of the object, stopping once all are found. Keys
+ * not found leave their value missing. Returns how many were found.
+ */
+inline uint32 JsonValue::findFields(const std::string_view keys[], JsonValue values[], uint32 count) const {
+    uint32 found = 0;
+
+    for (uint32 idx = 0; idx < count; idx++) {
+        values[idx] = JsonValue();
+    }
+
+    forEachMember([&](const JsonString& name, const JsonValue& value) {
+        for (uint32 idx = 0; idx < count; idx++) {
+            if (!values[idx].exists() && name == keys[idx]) {
+                values[idx] = value;
+                found++;
+                break;
+            }
+        }
+        return found < count;
+    });
+
+    return found;
+}
+
+/**
+ * JSON Pointer (RFC 6901) lookup: "/user/emails/0". Segments are member keys, or indexes in
+ * arrays; "~1" and "~0" stand for '/' and '~'.
+ */
+inline JsonValue JsonValue::at(std::string_view pointer) const {
+    JsonValue current = *this;
+
+    while (!pointer.empty() && current.exists()) {
+        if (pointer.front() != '/') return JsonValue();
+        pointer.remove_prefix(1);
+
+        std::string_view::size_type slash = pointer.find('/');
+        std::string_view segment = pointer.substr(0, slash);
+        pointer = (slash == std::string_view::npos) ? std::string_view() : pointer.substr(slash);
+
+        String unescaped;
+        if (segment.find('~') != std::string_view::npos) {
+            for (std::string_view::size_type idx = 0; idx < segment.size(); idx++) {
+                if (segment[idx] == '~' && idx + 1 < segment.size()) {
+                    unescaped += (segment[idx + 1] == '1') ? '/' : '~';
+                    idx++;
+                } else {
+                    unescaped += segment[idx];
+                }
+            }
+            segment = unescaped;
+        }
+
+        if (current.type() == JSON_ARRAY) {
+            uint32 idx = 0;
+            auto   result = std::from_chars(segment.data(), segment.data() + segment.size(), idx);
+            if (result.ec != std::errc() || result.ptr != segment.data() + segment.size()) return JsonValue();
+            current = current[idx];
+        } else {
+            current = current[segment];
+        }
+    }
+
+    return current;
+}
+
+inline bool JsonValue::getString(JsonString& out) const {
+    if (type() != JSON_STRING) return false;
+
+    out.escaped = false;
+    const char* stringEnd = _jsonSkipString(begin, end, &out.escaped);
+    if (stringEnd == nullptr) return false;
+
+    out.raw = std::string_view(begin + 1, stringEnd - begin - 2);
+    return true;
+}
+
+inline bool JsonValue::getString(String& out) const {
+    JsonString text;
+    if (!getString(text)) return false;
+
+    out.clear();
+    return text.decode(out);
+}
+
+inline bool JsonValue::getInt64(long long& out) const {
+    return getNumber(out);
+}
+
+inline bool JsonValue::getDouble(double& out) const {
+    return getNumber(out);
+}
+
+/** Into any arithmetic type; fails when the text is not a number of that type or out of its range. */
+template< class T >
+bool JsonValue::getNumber(T& out) const {
+    static_assert(std::is_arithmetic_v< T > && !std::is_same_v< T, bool >, "getNumber needs a number type");
+
+    if (type() != JSON_NUMBER) return false;
+
+    JsonNumber  number;
+    const char* valueEnd = _jsonScalarEnd(begin, end);
+    return jsonParseNumber(begin, valueEnd, number) == valueEnd && number.get(out);
+}
+
+inline bool JsonValue::getBool(bool& out) const {
+    std::string_view literal(begin, (type() == JSON_BOOL) ? _jsonScalarEnd(begin, end) - begin : 0);
+
+    if (literal == "true")  { out = true;  return true; }
+    if (literal == "false") { out = false; return true; }
+    return false;
+}
+
+inline bool JsonValue::isNull(void) const {
+    return type() == JSON_NULL && std::string_view(begin, _jsonScalarEnd(begin, end) - begin) == "null";
+}
+
+#endif // lazy_json_hpp
@@ -7,6 +7,7 @@
 static inline void assignRoutes(IRouter* router) {
     router->add("GET",  "/",          &handleHello);
     router->add("POST", "/something", &handlePost);
+    router->add("POST", "/greeting",  &handleGreeting);
     router->add("GET",  "/status",    &handleStatus);
 }
 
@@ -0,0 +1,417 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "http_compression.hpp"
+#include "../../json/body_format.hpp"
+#include "../../stl/hash.hpp"
+
+#include <string.h>
+#include <algorithm>
+
+enum {
+    GZIP_WINDOW_BITS    = 15 + 16,  // zlib writes the gzip wrapper
+    DEFLATE_WINDOW_BITS = 15,       // "deflate" is the zlib format (RFC 9110)
+    ZLIB_FAST_LEVEL     = 5,
+    ZLIB_BEST_LEVEL     = 9,
+    ZSTD_FAST_LEVEL     = 3,
+    ZSTD_BEST_LEVEL     = 19
+};
+
+/** Lower cased coding name of an Accept-Encoding entry, parameters dropped. */
+static String codingName(std::string_view entry) {
+    return lowerCased(trimmed(entry.substr(0, entry.find(';'))));
+}
+
+/** Coding of a request body. Only a single coding is supported, not a chain of them. */
+ContentEncoding contentEncodingOf(std::string_view contentEncoding) {
+    String name = codingName(contentEncoding);
+
+    if (name.empty() || name == "identity") return CONTENT_ENCODING_IDENTITY;
+    if (name == "gzip" || name == "x-gzip") return CONTENT_ENCODING_GZIP;
+    if (name == "deflate")                  return CONTENT_ENCODING_DEFLATE;
+#ifdef SA_HAVE_ZSTD
+    if (name == "zstd")                     return CONTENT_ENCODING_ZSTD;
+#endif // SA_HAVE_ZSTD
+    return CONTENT_ENCODING_UNSUPPORTED;
+}
+
+/**
+ * The supported coding with the highest q; on a tie the server's preference wins (zstd,
+ * gzip, deflate). "*" stands for every coding not listed. Identity when nothing is left,
+ * which is always acceptable for us: a client that forbids it still gets a readable body.
+ */
+ContentEncoding contentEncodingForAccept(std::string_view acceptEncoding) {
+    static const ContentEncoding PREFERENCE[] = {
+#ifdef SA_HAVE_ZSTD
+        CONTENT_ENCODING_ZSTD,
+#endif // SA_HAVE_ZSTD
+        CONTENT_ENCODING_GZIP,
+        CONTENT_ENCODING_DEFLATE
+    };
+
+    int quality[CONTENT_ENCODING_UNSUPPORTED] = { -1, -1, -1, -1 };
+    int anyQuality                            = -1;
+
+    while (!acceptEncoding.empty()) {
+        size_t           comma = acceptEncoding.find(',');
+        std::string_view entry = acceptEncoding.substr(0, comma);
+        acceptEncoding = (comma == std::string_view::npos) ? std::string_view() : acceptEncoding.substr(comma + 1);
+
+        String name = codingName(entry);
+        int    q    = (int) parseQuality(entry);
+
+        if (name == "gzip" || name == "x-gzip") quality[CONTENT_ENCODING_GZIP]    = std::max(quality[CONTENT_ENCODING_GZIP], q);
+        else if (name == "deflate")             quality[CONTENT_ENCODING_DEFLATE] = std::max(quality[CONTENT_ENCODING_DEFLATE], q);
+        else if (name == "zstd")                quality[CONTENT_ENCODING_ZSTD]    = std::max(quality[CONTENT_ENCODING_ZSTD], q);
+        else if (name == "*")                   anyQuality                        = std::max(anyQuality, q);
+    }
+
+    ContentEncoding best        = CONTENT_ENCODING_IDENTITY;
+    int             bestQuality = 0;
+
+    for (ContentEncoding encoding : PREFERENCE) {
+        int q = quality[encoding] >= 0 ? quality[encoding] : anyQuality;
+        if (q > bestQuality) {
+            best        = encoding;
+            bestQuality = q;
+        }
+    }
+
+    return best;
+}
+
+const char* contentEncodingName(ContentEncoding encoding) {
+    switch (encoding) {
+        case CONTENT_ENCODING_GZIP:    return "gzip";
+        case CONTENT_ENCODING_DEFLATE: return "deflate";
+        case CONTENT_ENCODING_ZSTD:    return "zstd";
+        default:                       return "identity";
+    }
+}
+
+/** Media that is compressed already (images, audio, video, archives, woff fonts) gains nothing. */
+bool isCompressibleContentType(std::string_view contentType) {
+    static const char* INCOMPRESSIBLE[] = {
+        "image/", "audio/", "video/", "font/woff", "application/zip", "application/gzip",
+        "application/x-gzip", "application/zstd", "application/x-7z-compressed", "application/pdf",
+        "application/octet-stream"
+    };
+
+    String mediaType = lowerCased(trimmed(contentType.substr(0, contentType.find(';'))));
+    if (mediaType == "image/svg+xml") {
+        return true;
+    }
+
+    for (const char* prefix : INCOMPRESSIBLE) {
+        if (mediaType.starts_with(prefix)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * HttpCompressor...
+ */
+
+HttpCompressor::HttpCompressor() : gzipLevel(0), deflateLevel(0), gzipReady(false), deflateReady(false) {
+    ::memset(&gzipStream, 0, sizeof(gzipStream));
+    ::memset(&deflateStream, 0, sizeof(deflateStream));
+#ifdef SA_HAVE_ZSTD
+    zstdContext = ZSTD_createCCtx();
+#endif // SA_HAVE_ZSTD
+}
+
+HttpCompressor::~HttpCompressor() {
+    if (gzipReady) deflateEnd(&gzipStream);
+    if (deflateReady) deflateEnd(&deflateStream);
+#ifdef SA_HAVE_ZSTD
+    ZSTD_freeCCtx(zstdContext);
+#endif // SA_HAVE_ZSTD
+}
+
+bool HttpCompressor::compress(ContentEncoding encoding, std::string_view input, String& out, int effort) {
+    switch (encoding) {
+        case CONTENT_ENCODING_GZIP:
+            return _deflate(gzipStream, gzipReady, gzipLevel, GZIP_WINDOW_BITS, effort == LEVEL_BEST ? ZLIB_BEST_LEVEL : ZLIB_FAST_LEVEL, input, out);
+        case CONTENT_ENCODING_DEFLATE:
+            return _deflate(deflateStream, deflateReady, deflateLevel, DEFLATE_WINDOW_BITS, effort == LEVEL_BEST ? ZLIB_BEST_LEVEL : ZLIB_FAST_LEVEL, input, out);
+#ifdef SA_HAVE_ZSTD
+        case CONTENT_ENCODING_ZSTD: {
+            if (zstdContext == nullptr) {
+                return false;
+            }
+
+            ZSTD_CCtx_reset(zstdContext, ZSTD_reset_session_only);
+            ZSTD_CCtx_setParameter(zstdContext, ZSTD_c_compressionLevel, effort == LEVEL_BEST ? ZSTD_BEST_LEVEL : ZSTD_FAST_LEVEL);
+            ZSTD_CCtx_setPledgedSrcSize(zstdContext, input.size());
+
+            out.resize(ZSTD_compressBound(input.size()));
+            ZSTD_inBuffer  source = { input.data(), input.size(), 0 };
+            ZSTD_outBuffer target = { out.data(), out.size(), 0 };
+
+            size_t left;
+            while ((left = ZSTD_compressStream2(zstdContext, &target, &source, ZSTD_e_end)) != 0) {
+                if (ZSTD_isError(left)) {
+                    return false;
+                }
+                out.resize(out.size() + left);
+                target.dst  = out.data();
+                target.size = out.size();
+            }
+
+            out.resize(target.pos);
+            return true;
+        }
+#endif // SA_HAVE_ZSTD
+        default:
+            return false;
+    }
+}
+
+/**
+ * The stream is reset rather than rebuilt, and re-tuned only when the level changes. Output
+ * is sized with deflateBound, so one deflate call normally finishes the body.
+ */
+bool HttpCompressor::_deflate(z_stream& stream, bool& ready, int& level, int windowBits, int wanted, std::string_view input, String& out) {
+    if (!ready) {
+        if (deflateInit2(&stream, wanted, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+            return false;
+        }
+        ready = true;
+        level = wanted;
+    } else {
+        deflateReset(&stream);
+        if (level != wanted) {
+            if (deflateParams(&stream, wanted, Z_DEFAULT_STRATEGY) != Z_OK) {
+                return false;
+            }
+            level = wanted;
+        }
+    }
+
+    out.resize(deflateBound(&stream, (uLong) input.size()));
+    stream.next_in   = (Bytef*) input.data();
+    stream.avail_in  = (uInt) input.size();
+    stream.next_out  = (Bytef*) out.data();
+    stream.avail_out = (uInt) out.size();
+
+    int status;
+    while ((status = deflate(&stream, Z_FINISH)) == Z_OK || status == Z_BUF_ERROR) {
+        ulong written = stream.total_out;
+        out.resize(out.size() + out.size() / 2 + 64);
+        stream.next_out  = (Bytef*) out.data() + written;
+        stream.avail_out = (uInt)(out.size() - written);
+    }
+    if (status != Z_STREAM_END) {
+        return false;
+    }
+
+    out.resize(stream.total_out);
+    return true;
+}
+
+/**
+ * HttpDecompressor...
+ */
+
+HttpDecompressor::HttpDecompressor() : inflateReady(false), encoding(CONTENT_ENCODING_IDENTITY), finished(false) {
+    ::memset(&inflateStream, 0, sizeof(inflateStream));
+#ifdef SA_HAVE_ZSTD
+    zstdContext = ZSTD_createDCtx();
+    if (zstdContext != nullptr) {
+        ZSTD_DCtx_setParameter(zstdContext, ZSTD_d_windowLogMax, ZSTD_WINDOW_LOG_MAX);
+    }
+#endif // SA_HAVE_ZSTD
+}
+
+HttpDecompressor::~HttpDecompressor() {
+    if (inflateReady) inflateEnd(&inflateStream);
+#ifdef SA_HAVE_ZSTD
+    ZSTD_freeDCtx(zstdContext);
+#endif // SA_HAVE_ZSTD
+}
+
+/** Starts a new body. The inflate stream is reset (and switched between gzip and zlib), not rebuilt. */
+bool HttpDecompressor::begin(ContentEncoding bodyEncoding) {
+    encoding = bodyEncoding;
+    finished = false;
+
+    switch (encoding) {
+        case CONTENT_ENCODING_GZIP:
+        case CONTENT_ENCODING_DEFLATE: {
+            int windowBits = encoding == CONTENT_ENCODING_GZIP ? GZIP_WINDOW_BITS : DEFLATE_WINDOW_BITS;
+            if (!inflateReady) {
+                inflateReady = inflateInit2(&inflateStream, windowBits) == Z_OK;
+                return inflateReady;
+            }
+            return inflateReset2(&inflateStream, windowBits) == Z_OK;
+        }
+#ifdef SA_HAVE_ZSTD
+        case CONTENT_ENCODING_ZSTD:
+            return zstdContext != nullptr && !ZSTD_isError(ZSTD_DCtx_reset(zstdContext, ZSTD_reset_session_only));
+#endif // SA_HAVE_ZSTD
+        default:
+            return false;
+    }
+}
+
+/**
+ * Inflates input, appending to out. Bytes fed once the stream has ended are an error, except
+ * for gzip, where they start the next member of a multi-member body (RFC 1952 2.2).
+ */
+DecompressStatus HttpDecompressor::feed(std::string_view input, String& out, ulong limit) {
+    if (finished) {
+        if (input.empty()) {
+            return DECOMPRESS_DONE;
+        }
+        if (encoding != CONTENT_ENCODING_GZIP || inflateReset(&inflateStream) != Z_OK) {
+            return DECOMPRESS_FAILED;
+        }
+        finished = false;
+    }
+
+#ifdef SA_HAVE_ZSTD
+    if (encoding == CONTENT_ENCODING_ZSTD) {
+        return _zstd(input, out, limit);
+    }
+#endif // SA_HAVE_ZSTD
+    return _inflate(input, out, limit);
+}
+
+/**
+ * Grows out for the next write, by wanted bytes but never more than one past the limit: a
+ * stream that fills that extra byte is too large. used is where the new room starts.
+ */
+bool HttpDecompressor::_makeRoom(String& out, ulong limit, ulong wanted, ulong& used) {
+    used = out.size();
+    if (used > limit) {
+        return false;
+    }
+
+    out.resize(used + std::min(std::max< ulong >(wanted, 16 * 1024), limit + 1 - used));
+    return true;
+}
+
+DecompressStatus HttpDecompressor::_inflate(std::string_view input, String& out, ulong limit) {
+    inflateStream.next_in  = (Bytef*) input.data();
+    inflateStream.avail_in = (uInt) input.size();
+
+    while (true) {
+        ulong used;
+        if (!_makeRoom(out, limit, input.size() * 4, used)) {
+            return DECOMPRESS_TOO_LARGE;
+        }
+
+        inflateStream.next_out  = (Bytef*) out.data() + used;
+        inflateStream.avail_out = (uInt)(out.size() - used);
+
+        int status = inflate(&inflateStream, Z_NO_FLUSH);
+        out.resize(out.size() - inflateStream.avail_out);
+
+        if (status != Z_OK && status != Z_BUF_ERROR && status != Z_STREAM_END) {
+            return DECOMPRESS_FAILED;
+        }
+        if (out.size() > limit) {
+            return DECOMPRESS_TOO_LARGE;
+        }
+        if (status == Z_STREAM_END) {
+            if (inflateStream.avail_in == 0) {
+                finished = true;
+                return DECOMPRESS_DONE;
+            }
+            if (encoding != CONTENT_ENCODING_GZIP || inflateReset(&inflateStream) != Z_OK) {
+                finished = true;
+                return DECOMPRESS_FAILED;
+            }
+        }
+        if (inflateStream.avail_in == 0 && inflateStream.avail_out > 0) {
+            return DECOMPRESS_MORE;
+        }
+    }
+}
+
+#ifdef SA_HAVE_ZSTD
+/** Concatenated frames are one body (RFC 8878); it is complete when a frame ends the input. */
+DecompressStatus HttpDecompressor::_zstd(std::string_view input, String& out, ulong limit) {
+    ZSTD_inBuffer source = { input.data(), input.size(), 0 };
+
+    while (true) {
+        ulong used;
+        if (!_makeRoom(out, limit, input.size() * 4, used)) {
+            return DECOMPRESS_TOO_LARGE;
+        }
+
+        ZSTD_outBuffer target = { out.data() + used, out.size() - used, 0 };
+        size_t         hint   = ZSTD_decompressStream(zstdContext, &target, &source);
+        out.resize(used + target.pos);
+
+        if (ZSTD_isError(hint)) {
+            return DECOMPRESS_FAILED;
+        }
+        if (out.size() > limit) {
+            return DECOMPRESS_TOO_LARGE;
+        }
+        if (source.pos == source.size && target.pos < target.size) {
+            return hint == 0 ? DECOMPRESS_DONE : DECOMPRESS_MORE;
+        }
+    }
+}
+#endif // SA_HAVE_ZSTD
+
+/**
+ * PrecompressedCache...
+ */
+
+static uint64 variantKey(ContentEncoding encoding, std::string_view body) {
+    return wyhash(body.data(), body.size(), encoding);
+}
+
+PrecompressedCache::~PrecompressedCache() {
+    const Variant* variant = all.load(std::memory_order_acquire);
+
+    while (variant != nullptr) {
+        const Variant* next = variant->next;
+        delete variant;
+        variant = next;
+    }
+}
+
+/** The cached variant of exactly this body, or nullptr. */
+const PrecompressedCache::Variant* PrecompressedCache::find(ContentEncoding encoding, std::string_view body) const {
+    const Variant* variant = nullptr;
+
+    if (!variants.find(variantKey(encoding, body), variant) || variant->body != body) {
+        return nullptr;
+    }
+    return variant;
+}
+
+/**
+ * Publishes a variant unless one is there already (another worker won the race, or a
+ * different body with the same hash) or the budget is spent. Returns the variant cached for
+ * this body, if any.
+ */
+const PrecompressedCache::Variant* PrecompressedCache::add(ContentEncoding encoding, std::string_view body, const String& compressed) {
+    ulong size = body.size() + compressed.size();
+    if (bytes.load(std::memory_order_relaxed) + size > MAX_BYTES) {
+        return nullptr;
+    }
+
+    Variant*       mine   = new Variant{ String(body), compressed, nullptr };
+    const Variant* stored = variants.update(variantKey(encoding, body), nullptr, [&](const Variant*& variant) {
+        if (variant == nullptr) variant = mine;
+    });
+
+    if (stored != mine) {
+        delete mine;
+        return stored->body == body ? stored : nullptr;
+    }
+
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    mine->next = all.load(std::memory_order_relaxed);
+    while (!all.compare_exchange_weak(mine->next, mine, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+    return mine;
+}
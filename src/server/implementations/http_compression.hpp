@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef http_compression_hpp
+#define http_compression_hpp
+
+#include "../../stl/common.hpp"
+#include "../../stl/concurrent_hash_map.hpp"
+#include "../../stl/safe_string.hpp"
+
+#include <atomic>
+#include <string_view>
+#include <zlib.h>
+
+#ifdef SA_HAVE_ZSTD
+#    include <zstd.h>
+#endif // SA_HAVE_ZSTD
+
+/**
+ * Content codings of response bodies: negotiated on Accept-Encoding, zstd first when the
+ * build has it (SA_HAVE_ZSTD), then gzip, then deflate.
+ */
+enum ContentEncoding : uint8 {
+    CONTENT_ENCODING_IDENTITY,
+    CONTENT_ENCODING_GZIP,
+    CONTENT_ENCODING_DEFLATE,
+    CONTENT_ENCODING_ZSTD,
+    CONTENT_ENCODING_UNSUPPORTED
+};
+
+enum DecompressStatus : uint8 {
+    DECOMPRESS_MORE,        // everything fed was consumed, the stream goes on
+    DECOMPRESS_DONE,        // the stream (last gzip member, last zstd frame) ended with the last byte fed
+    DECOMPRESS_FAILED,      // corrupt stream, or bytes after the end of a deflate stream
+    DECOMPRESS_TOO_LARGE    // the output would exceed the limit
+};
+
+ContentEncoding contentEncodingOf(std::string_view contentEncoding);
+ContentEncoding contentEncodingForAccept(std::string_view acceptEncoding);
+const char*     contentEncodingName(ContentEncoding encoding);
+bool            isCompressibleContentType(std::string_view contentType);
+
+/**
+ * HttpCompressor - One per worker thread. The zlib streams and the zstd context are set up
+ * once and reset between bodies, so a compression costs no allocation beyond its output.
+ */
+struct HttpCompressor {
+    enum { LEVEL_FAST, LEVEL_BEST };
+
+    HttpCompressor();
+    HttpCompressor(const HttpCompressor&) = delete;
+    HttpCompressor& operator = (const HttpCompressor&) = delete;
+    ~HttpCompressor();
+
+    /** Compresses input into out (replaced). LEVEL_BEST is for bodies compressed once and cached. */
+    bool            compress(ContentEncoding encoding, std::string_view input, String& out, int effort = LEVEL_FAST);
+
+private:
+    bool            _deflate(z_stream& stream, bool& ready, int& level, int windowBits, int wanted, std::string_view input, String& out);
+
+    z_stream        gzipStream;
+    z_stream        deflateStream;
+    int             gzipLevel;
+    int             deflateLevel;
+    bool            gzipReady;
+    bool            deflateReady;
+#ifdef SA_HAVE_ZSTD
+    ZSTD_CCtx*      zstdContext;
+#endif // SA_HAVE_ZSTD
+};
+
+/**
+ * HttpDecompressor - One per worker thread, for Content-Encoding request bodies. The body is
+ * fed as it arrives and inflated into the caller's buffer, never past the limit, so a small
+ * upload that expands into gigabytes (zip bomb) costs limit bytes and is then refused.
+ */
+struct HttpDecompressor {
+    enum { ZSTD_WINDOW_LOG_MAX = 23 };    // 8 MB: refuse frames that want a bigger window
+
+    HttpDecompressor();
+    HttpDecompressor(const HttpDecompressor&) = delete;
+    HttpDecompressor& operator = (const HttpDecompressor&) = delete;
+    ~HttpDecompressor();
+
+    bool             begin(ContentEncoding encoding);
+    DecompressStatus feed(std::string_view input, String& out, ulong limit);
+
+private:
+    static bool      _makeRoom(String& out, ulong limit, ulong wanted, ulong& used);
+    DecompressStatus _inflate(std::string_view input, String& out, ulong limit);
+
+    z_stream         inflateStream;
+    bool             inflateReady;
+    ContentEncoding  encoding;
+    bool             finished;
+#ifdef SA_HAVE_ZSTD
+    DecompressStatus _zstd(std::string_view input, String& out, ulong limit);
+
+    ZSTD_DCtx*       zstdContext;
+#endif // SA_HAVE_ZSTD
+};
+
+/**
+ * PrecompressedCache - Compressed variants of immutable responses (Cache-Control: immutable),
+ * shared by the workers. Entries are keyed by the body itself, so a handler that rebuilds the
+ * same bytes gets them compressed (at LEVEL_BEST) once. Entries are never replaced, and only
+ * freed with the cache, which keeps the lock free readers safe; once MAX_BYTES are held
+ * nothing more is cached.
+ */
+struct PrecompressedCache {
+    enum : ulong { MAX_BYTES = 32 * 1024 * 1024 };
+
+    struct Variant {
+        String          body;
+        String          compressed;
+        const Variant*  next;
+    };
+
+    ~PrecompressedCache();
+
+    const Variant*  find(ContentEncoding encoding, std::string_view body) const;
+    const Variant*  add(ContentEncoding encoding, std::string_view body, const String& compressed);
+
+private:
+    ConcurrentHashMap< uint64, const Variant* > variants;
+    std::atomic< const Variant* >               all { nullptr };
+    std::atomic< ulong >                        bytes { 0 };
+};
+
+#endif // http_compression_hpp
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#include "http_parallel.hpp"
+#include "../../stl/monotonic_arena.hpp"
+
+#include <sched.h>
+
+static std::atomic< TaskQueue* > activePool{nullptr};
+
+void bindParallelPool(TaskQueue* pool) {
+    activePool.store(pool, std::memory_order_release);
+}
+
+TaskQueue* parallelPool(void) {
+    return activePool.load(std::memory_order_acquire);
+}
+
+/**
+ * Pulls chunks until none is left. After a failure the rest are only counted off. Bodies run
+ * with no arena bound: on a helper the bound one would belong to another request.
+ */
+static void drainChunks(ParallelJob& job) {
+    ArenaScope noArena(nullptr);
+    uint32     chunk;
+
+    while ((chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed)) < job.chunkCount) {
+        if (job.failed.load(std::memory_order_relaxed)) continue;
+
+        uint64 from = job.begin + chunk * job.chunkSize;
+        uint64 to   = (job.end - from < job.chunkSize) ? job.end : from + job.chunkSize;
+
+        try {
+            job.runChunk(job, from, to, chunk);
+        } catch (...) {
+            if (!job.failed.exchange(true)) {
+                job.error = std::current_exception();
+            }
+        }
+    }
+}
+
+static void helperTask(void* context, long argument) {
+    (void) argument;
+    ParallelJob* job = (ParallelJob*) context;
+
+    drainChunks(*job);
+    job->helpers.fetch_sub(1, std::memory_order_release);
+}
+
+void runParallelJob(ParallelJob& job) {
+    TaskQueue* pool = parallelPool();
+
+    /** Fork: at most one helper per worker, stop at the first refusal (saturated pool) */
+    uint32 wanted = job.chunkCount - 1;
+    if (pool != nullptr && wanted > pool->workerCount) wanted = pool->workerCount;
+
+    for (uint32 helper = 0; pool != nullptr && helper < wanted; helper++) {
+        job.helpers.fetch_add(1, std::memory_order_relaxed);
+        if (!pool->tryEnqueueJob(Task{ &helperTask, &job, 0 })) {
+            job.helpers.fetch_sub(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    drainChunks(job);
+
+    /** Join: the job lives on this stack until every queued helper has run, help meanwhile */
+    while (job.helpers.load(std::memory_order_acquire) > 0) {
+        Task task;
+        if (pool->tryDequeueJob(task)) {
+            ArenaScope noArena(nullptr);
+            task.run(task.context, task.argument);
+        } else {
+            sched_yield();
+        }
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef http_parallel_hpp
+#define http_parallel_hpp
+
+#include "../../stl/common.hpp"
+#include "../../stl/small_vector.hpp"
+#include "http_task_queue.hpp"
+
+#include <atomic>
+#include <exception>
+
+/**
+ * Fork-join helpers for handlers, run on the server worker pool.
+ *
+ *   parallelFor(begin, end, body(idx))                 body for every index
+ *   parallelForEach(container, body(item))             body for every item of a Collection...
+ *   parallelReduce(begin, end, identity, map, combine)  combine(acc, map(idx)) over the range
+ *   parallelTransform(input, output, count, fn)         output[idx] = fn(input[idx])
+ *
+ * The range is cut in chunks of at least grain indexes (PARALLEL_MAX_CHUNKS at most). The
+ * caller queues up to one helper task per pool worker (one less than the chunks), stopping
+ * at the first the job lane refuses, then works on the chunks itself; helpers and caller
+ * pull chunks from a shared counter. Worker idleness is not checked: a helper queued behind
+ * busy workers simply finds no chunk left when it runs. A range below grain, a full job
+ * lane, or no pool at all (no server running) all end up inline on the calling thread.
+ * While the caller waits for its helpers it runs queued jobs, so nested or concurrent calls
+ * cannot deadlock the pool.
+ *
+ * Partial results are combined in index order: a reduction is deterministic for a given
+ * range and grain. The first exception thrown by a body cancels the remaining chunks and is
+ * rethrown to the caller.
+ *
+ * Bodies run with no MonotonicArena bound, on whichever thread picks up the chunk: they must
+ * not allocate from the request arena (ArenaJson, ArenaStlAllocator), which throws
+ * std::bad_alloc there.
+ */
+
+enum { PARALLEL_DEFAULT_GRAIN = 1024, PARALLEL_MAX_CHUNKS = 256 };
+
+struct ParallelJob {
+    void                 (*runChunk)(ParallelJob& job, uint64 from, uint64 to, uint32 chunk);
+    void*                  body;
+    uint64                 begin;
+    uint64                 end;
+    uint64                 chunkSize;
+    uint32                 chunkCount;
+    std::atomic< uint32 >  nextChunk{0};
+    std::atomic< uint32 >  helpers{0};
+    std::atomic< bool >    failed{false};
+    std::exception_ptr     error;
+};
+
+/** The pool handlers fork onto, bound by the server. nullptr makes every helper run inline. */
+void       bindParallelPool(TaskQueue* pool);
+TaskQueue* parallelPool(void);
+void       runParallelJob(ParallelJob& job);
+
+/** Chunks of at least grain indexes, at most PARALLEL_MAX_CHUNKS of them, none empty. */
+inline uint32 _parallelChunkCount(uint64 count, uint64 grain, uint64& chunkSize) {
+    uint64 chunkCount = (count + grain - 1) / grain;
+    if (chunkCount > PARALLEL_MAX_CHUNKS) chunkCount = PARALLEL_MAX_CHUNKS;
+
+    chunkSize = (count + chunkCount - 1) / chunkCount;
+    return (uint32)((count + chunkSize - 1) / chunkSize);
+}
+
+template< class RunChunk >
+void _parallelRun(uint64 begin, uint64 end, uint64 grain, RunChunk& runChunk) {
+    ParallelJob job;
+    job.body       = &runChunk;
+    job.begin      = begin;
+    job.end        = end;
+    job.chunkCount = _parallelChunkCount(end - begin, grain, job.chunkSize);
+    job.runChunk   = [](ParallelJob& self, uint64 from, uint64 to, uint32 chunk) {
+        (*(RunChunk*) self.body)(from, to, chunk);
+    };
+
+    runParallelJob(job);
+}
+
+template< class Body >
+void parallelFor(uint64 begin, uint64 end, Body body, uint64 grain = PARALLEL_DEFAULT_GRAIN) {
+    if (end <= begin) return;
+
+    if (end - begin <= grain || parallelPool() == nullptr) {
+        for (uint64 idx = begin; idx < end; idx++) body(idx);
+        return;
+    }
+
+    auto runChunk = [&body](uint64 from, uint64 to, uint32) {
+        for (uint64 idx = from; idx < to; idx++) body(idx);
+    };
+    _parallelRun(begin, end, grain, runChunk);
+}
+
+template< class ContainerType, class Body >
+void parallelForEach(ContainerType& container, Body body, uint64 grain = PARALLEL_DEFAULT_GRAIN) {
+    auto* items = container.items + 0;
+    parallelFor(0, container.length, [items, &body](uint64 idx) { body(items[idx]); }, grain);
+}
+
+template< class ValueType, class Map, class Combine >
+ValueType parallelReduce(uint64 begin, uint64 end, ValueType identity, Map map, Combine combine, uint64 grain = PARALLEL_DEFAULT_GRAIN) {
+    if (end <= begin) return identity;
+
+    if (end - begin <= grain || parallelPool() == nullptr) {
+        ValueType accumulator = identity;
+        for (uint64 idx = begin; idx < end; idx++) accumulator = combine(accumulator, map(idx));
+        return accumulator;
+    }
+
+    SmallVector< ValueType, 16 > partials;
+    uint64 chunkSize;
+    uint32 chunkCount = _parallelChunkCount(end - begin, grain, chunkSize);
+    for (uint32 chunk = 0; chunk < chunkCount; chunk++) partials.add(identity);
+
+    auto runChunk = [&](uint64 from, uint64 to, uint32 chunk) {
+        ValueType accumulator = identity;
+        for (uint64 idx = from; idx < to; idx++) accumulator = combine(accumulator, map(idx));
+        partials[chunk] = std::move(accumulator);
+    };
+    _parallelRun(begin, end, grain, runChunk);
+
+    ValueType result = identity;
+    for (uint32 chunk = 0; chunk < partials.length; chunk++) result = combine(result, partials[chunk]);
+    return result;
+}
+
+template< class InputType, class OutputType, class Transform >
+void parallelTransform(const InputType* input, OutputType* output, uint64 count, Transform transform, uint64 grain = PARALLEL_DEFAULT_GRAIN) {
+    parallelFor(0, count, [input, output, &transform](uint64 idx) { output[idx] = transform(input[idx]); }, grain);
+}
+
+#endif // http_parallel_hpp
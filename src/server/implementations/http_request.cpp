@@ -14,12 +14,12 @@ void HttpRequest::dump(void)  {
     RequestHeaderContainer::Iterator it;
     it.init(&headers);
     
-    for (it.begin(); *it.key() != headers.end(); it.next()) {
+    for (it.begin(); it.key() != it.end().key(); it.next()) {
         SA_PRINT("  %s: %s\n", it.key()->c_str(), it.value()->c_str());
     }
 }
 
-const String& HttpRequest::getMethod(void) const {
+const MethodName& HttpRequest::getMethod(void) const {
     return method;
 }
 
@@ -27,7 +27,7 @@ const String& HttpRequest::getPath(void) const {
     return path;
 }
 
-const String& HttpRequest::getVersion(void) const {
+const VersionString& HttpRequest::getVersion(void) const {
     return version;
 }
 
@@ -40,7 +40,7 @@ const String& HttpRequest::getBody(void) const {
 }
 
 
-const bool HttpRequest::addHeader(const String& key, const String& value) {
+bool HttpRequest::addHeader(const HeaderName& key, const String& value) {
     if (!hasHeader(key)) {
         headers.add(key, value);
         return true;
@@ -48,10 +48,29 @@ const bool HttpRequest::addHeader(const String& key, const String& value) {
     return false;
 }
 
-const bool HttpRequest::hasHeader(const String& key) const {
+bool HttpRequest::addHeader(const HeaderName& key, String&& value) {
+    if (!hasHeader(key)) {
+        headers.emplace(key, std::move(value));
+        return true;
+    }
+    return false;
+}
+
+const bool HttpRequest::hasHeader(const HeaderName& key) const {
     return headers.exists(key);
 }
 
-const String& HttpRequest::get(const String& key) const {
+const String& HttpRequest::get(const HeaderName& key) const {
     return headers.at(key);
-}
\ No newline at end of file
+}
+JsonBackend HttpRequest::getJsonBackend(void) const {
+    return jsonBackend;
+}
+
+void HttpRequest::setJsonBackend(JsonBackend backend) {
+    jsonBackend = backend;
+}
+
+bool HttpRequest::isJsonBodyValidated(void) const {
+    return jsonBodyValidated;
+}
@@ -10,21 +10,27 @@
 #include "../types/http_header.hpp"
 
 struct HttpRequest: implements IRequest {
-    String method;
-    String path;
-    String version;
+    MethodName    method;
+    String        path;
+    VersionString version;
     
     RequestHeaderContainer headers;
     String                 body;
+    JsonBackend            jsonBackend = JSON_BACKEND_LAZY;
+    bool                   jsonBodyValidated = false;   // the server checked it as it arrived
 
-    const String&                 getMethod(void) const;
+    const MethodName&             getMethod(void) const;
     const String&                 getPath(void) const;
-    const String&                 getVersion(void) const;
+    const VersionString&          getVersion(void) const;
     const String&                 getBody(void) const;
     const RequestHeaderContainer& getHeaders(void) const;
-    const bool                    addHeader(const String& key, const String& value);
-    const bool                    hasHeader(const String& key) const;
-    const String&                 get(const String& key) const;
+    bool                          addHeader(const HeaderName& key, const String& value);
+    bool                          addHeader(const HeaderName& key, String&& value);
+    const bool                    hasHeader(const HeaderName& key) const;
+    const String&                 get(const HeaderName& key) const;
+    JsonBackend                   getJsonBackend(void) const;
+    void                          setJsonBackend(JsonBackend backend);
+    bool                          isJsonBodyValidated(void) const;
     void                          dump(void);
 };
 
@@ -28,19 +28,37 @@ const ResponseHeaderContainer& HttpResponse::getHeaders(void) {
     return headers;
 }
 
-String HttpResponse::serialize() {
+String& HttpResponse::getBodyBuffer(void) {
+    return body;
+}
+
+/**
+ * Status line and headers up to the blank line. Sent ahead of the body with a gathered write,
+ * so the body is never copied behind them.
+ */
+String HttpResponse::serializeHead(void) const {
     String res;
-    
-    res += "HTTP/1.1 " + std::to_string(statusCode) + " " + statusText + "\r\n";
-    res += "Content-Length: " + std::to_string(body.length()) + "\r\n";
-    res += "Connection: close\r\n";
-    
+    res.reserve(128);
+
+    res += "HTTP/1.1 ";
+    res += std::to_string(statusCode);
+    res += ' ';
+    res += statusText;
+    res += "\r\nContent-Length: ";
+    res += std::to_string(body.length());
+    res += "\r\nConnection: close\r\n";
+
     for (uint32 i = 0; i < headers.length(); ++i) {
-        res += headers.keys.at(i) + ": " + headers.values.at(i) + "\r\n";
+        res += headers.keys.at(i);
+        res += ": ";
+        res += headers.values.at(i);
+        res += "\r\n";
     }
 
     res += "\r\n";
-    res += body;
-
     return res;
-}
\ No newline at end of file
+}
+
+String HttpResponse::serialize() {
+    return serializeHead() + body;
+}
@@ -10,7 +10,7 @@
 #include "../types/http_header.hpp"
 
 struct HttpResponse : implements IResponse{
-    #define MaxResponseHeaders 10
+    #define MaxResponseHeaders 8
     typedef HeaderContainer< MaxResponseHeaders > ResponseHeaderContainer; 
 
     int                     statusCode;
@@ -24,7 +24,9 @@ struct HttpResponse : implements IResponse{
     void                           setStatus(int code, const char* text);
     void                           addHeader(const char* key, const char* value);
     void                           setBody(const char* data);
+    String&                        getBodyBuffer(void);
     const ResponseHeaderContainer& getHeaders(void);
+    String                         serializeHead(void) const;
     String                         serialize();
 };
 
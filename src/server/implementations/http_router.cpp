@@ -1,10 +1,11 @@
 #include "http_router.hpp"
 
-void HttpRouter::add(const char* method, const char* path, RequestHandler handler) {
-    routes.tryAdd({method, path, handler});
+void HttpRouter::add(const char* method, const char* path, RequestHandler handler, JsonBackend jsonBackend) {
+    routes.emplace(method, path, handler, jsonBackend);
 }
 
-bool HttpRouter::handle(IRequest* req, IResponse* res) {
+/** The route for the request's method and path, query string and trailing slash ignored. */
+Route* HttpRouter::_find(const IRequest* req) {
     String reqPath = req->getPath();
     size_t qpos    = reqPath.find('?');
     if (qpos != String::npos) {
@@ -16,11 +17,25 @@ bool HttpRouter::handle(IRequest* req, IResponse* res) {
 
     for (auto&& it = routes.begin(); it != routes.end(); ++it) {
         if (it->method == req->getMethod() && it->path == reqPath) {
-            it->handler(req, res);
-            return true;
+            return &*it;
         }
     }
-    
+    return nullptr;
+}
+
+bool HttpRouter::hasRoute(const IRequest* req) {
+    return _find(req) != nullptr;
+}
+
+bool HttpRouter::handle(IRequest* req, IResponse* res) {
+    Route* route = _find(req);
+
+    if (route != nullptr) {
+        req->setJsonBackend(route->jsonBackend);
+        route->handler(req, res);
+        return true;
+    }
+
     res->setStatus(404, "Not Found");
     res->setBody("Resource not found");
     return false;
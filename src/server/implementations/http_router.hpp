@@ -5,23 +5,29 @@
 #ifndef http_router_hpp
 #define http_router_hpp
 
+#include "../../stl/small_vector.hpp"
 #include "../interfaces/irouter.hpp"
 #include "http_request.hpp"
 #include "http_response.hpp"
 
 struct Route {
-    String         method;
+    MethodName     method;
     String         path;
     RequestHandler handler;
+    JsonBackend    jsonBackend;
 };
 
-#define MAX_ROUTES 20
+#define INLINE_ROUTES 16
 
 struct HttpRouter : implements IRouter {
-    Collection< Route, MAX_ROUTES > routes;
+    SmallVector< Route, INLINE_ROUTES > routes;
 
-    void add(const char* method, const char* path, RequestHandler handler) override;
+    void add(const char* method, const char* path, RequestHandler handler, JsonBackend jsonBackend = JSON_BACKEND_LAZY) override;
+    bool hasRoute(const IRequest* req);
     bool handle(IRequest* req, IResponse* res);
+
+private:
+    Route* _find(const IRequest* req);
 };
 
 #endif // http_router_hpp
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "http_server.hpp"
 #include <errno.h>
+#include <sys/uio.h>
 #include <string.h>
 #include <algorithm>
 #include <cctype>
@@ -9,7 +10,8 @@ void HttpServer::init(uint32 port) {
     this->port   = port;
     listenSocket = -1;
     threadCount  = MAX_THREADS;
-    taskQueue.init();
+    taskQueue.init(threadCount);
+    bindParallelPool(&taskQueue);
 }
 
 void HttpServer::start(void) {
@@ -44,7 +46,7 @@ void HttpServer::start(void) {
             if (retFlag == 3)
                 continue;
 
-            taskQueue.enqueue(clientSocket);
+            taskQueue.enqueue(Task{ &HttpServer::connectionTask, this, clientSocket });
         }
     }
 
@@ -129,24 +131,26 @@ void HttpServer::recicleAddress() {
 /** member function that executes each thread worker... */
 void* HttpServer::workerRoutine(void* arg) {
     HttpServer* server = (HttpServer*) arg;
-    int clientSocket;
     
-    /** while true: each worker waits for jobs */
+    /** while true: each worker waits for tasks (connections or parallel jobs) */
     while (true) {
         /** blocks until there is an available task */
-        clientSocket = server->taskQueue.dequeue();
-        
-        if (clientSocket > 0) {
-            /** handle the connection if there is a task */
-            server->handleConnection(clientSocket);
-            /** the socket is closed inside of handleConnection */
-        }
+        Task task = server->taskQueue.dequeue();
+        task.run(task.context, task.argument);
     }
     return NULL;
 }
 
+void HttpServer::connectionTask(void* context, long clientSocket) {
+    if (clientSocket > 0) {
+        /** the socket is closed inside of handleConnection */
+        ((HttpServer*) context)->handleConnection((int) clientSocket);
+    }
+}
+
 void HttpServer::cleanup() {
     close(listenSocket);
+    bindParallelPool(nullptr);
     taskQueue.destroy();
 }
 
@@ -191,38 +195,33 @@ void HttpServer::debugRequestHeaders(String &headersPart, HttpRequest &req, Stri
 */
 }
 
-Collection<String> split(const String& text, char delimiter, int limit = -1) {
-    Collection<String> tokens;
-    size_t start = 0;
-    size_t end = text.find(delimiter);
+/** Next space separated token of line from pos, pos moves past it. */
+static std::string_view nextToken(std::string_view line, std::string_view::size_type& pos) {
+    std::string_view::size_type end = line.find(' ', pos);
+    std::string_view token = line.substr(pos, end == std::string_view::npos ? std::string_view::npos : end - pos);
 
-    while (end != String::npos) {
-        tokens.add(text.substr(start, end - start));
-        start = end + 1;
-        end = text.find(delimiter, start);
-    }
-
-    tokens.add(text.substr(start, end - start));
-    
-    return tokens;
+    pos = (end == std::string_view::npos) ? line.length() + 1 : end + 1;
+    return token;
 }
 
+/**
+ * Method and version land in inline strings, only the path may need the heap. A method or
+ * version too long for them is left invalid/empty and the router answers 404.
+ */
 void HttpServer::parseMethodPathAndVersion(String &headersPart, HttpRequest &req) {
-    String requestLine;
-    String::size_type firstLineEnd = headersPart.find("\r\n");
+    std::string_view            requestLine(headersPart);
+    std::string_view::size_type firstLineEnd = requestLine.find("\r\n");
 
-    if (firstLineEnd != String::npos) {
-        requestLine = headersPart.substr(0, firstLineEnd);
-        
-        Collection<String> tokens = split(requestLine, ' ');
+    if (firstLineEnd == std::string_view::npos) {
+        return;
+    }
 
-        if (tokens.length >= 1) req.method  = tokens.at(0);
-        if (tokens.length >= 2) req.path    = tokens.at(1);
-        if (tokens.length >= 3) req.version = tokens.at(2);
+    requestLine = requestLine.substr(0, firstLineEnd);
+    std::string_view::size_type pos = 0;
 
-    } else {
-        requestLine = headersPart; 
-    }
+    if (pos <= requestLine.length()) req.method = MethodName(nextToken(requestLine, pos));
+    if (pos <= requestLine.length()) req.path.assign(nextToken(requestLine, pos));
+    if (pos <= requestLine.length()) req.version.assign(nextToken(requestLine, pos));
 }
 
 void HttpServer::setBody(String &bodyPart, HttpRequest &req) {
@@ -242,47 +241,59 @@ void HttpServer::parseBody(String::size_type delimiterPos, String::size_type fir
     }
 }
 
-void HttpServer::parseHeaders(String &headersPart, HttpRequest &req) {
-    String::size_type lineStart = headersPart.find("\r\n");
-    if (lineStart == String::npos) {
-        return;
+/**
+ * Works on views of headersPart: only the values are copied out. HeaderName lower cases and
+ * interns the names. Returns false on a name longer than HeaderName can hold (answered 431),
+ * rather than losing that header.
+ */
+bool HttpServer::parseHeaders(String &headersPart, HttpRequest &req) {
+    std::string_view            headers(headersPart);
+    std::string_view::size_type lineStart = headers.find("\r\n");
+    if (lineStart == std::string_view::npos) {
+        return true;
     }
 
     lineStart += 2;
 
-    while (lineStart < headersPart.length()) {
-        String::size_type lineEnd = headersPart.find("\r\n", lineStart);
-        String::size_type length  = (lineEnd == String::npos) ? (headersPart.length() - lineStart) : (lineEnd - lineStart);
-        String line    = headersPart.substr(lineStart, length);
-        lineStart      = (lineEnd == String::npos) ? headersPart.length() : lineEnd + 2;
+    while (lineStart < headers.length()) {
+        std::string_view::size_type lineEnd = headers.find("\r\n", lineStart);
+        std::string_view::size_type length  = (lineEnd == std::string_view::npos) ? (headers.length() - lineStart) : (lineEnd - lineStart);
+        std::string_view line = headers.substr(lineStart, length);
+        lineStart             = (lineEnd == std::string_view::npos) ? headers.length() : lineEnd + 2;
 
-        if (line.empty()) {
+        std::string_view::size_type colonPos = line.find(':');
+        if (colonPos == std::string_view::npos) {
             continue;
         }
 
-        String::size_type colonPos = line.find(':');
-        if (colonPos == String::npos) {
+        std::string_view key   = trimmed(line.substr(0, colonPos));
+        std::string_view value = trimmed(line.substr(colonPos + 1));
+
+        if (key.empty()) {
             continue;
         }
+        if (!HeaderName::fits(key)) {
+            return false;
+        }
+        req.addHeader(HeaderName(key), String(value));
+    }
 
-        String key   = line.substr(0, colonPos);
-        String value = line.substr(colonPos + 1);
-
-        trim(key);
-        trim(value);
+    return true;
+}
 
-        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char ch) {
-            return static_cast<char>(std::tolower(ch));
-        });
+/** application/json, or any structured +json type (application/problem+json...). */
+bool HttpServer::hasJsonBody(HttpRequest &req) {
+    static const HeaderName contentTypeKey(HEADER_CONTENT_TYPE);
 
-        if (!key.empty()) {
-            req.addHeader(key, value);
-        }
+    if (!req.hasHeader(contentTypeKey)) {
+        return false;
     }
+
+    return bodyFormatOfContentType(req.get(contentTypeKey)) == BODY_FORMAT_JSON;
 }
 
 bool HttpServer::tryParseContentLength(HttpRequest &req, uint32 &contentLength) {
-    static const String contentLengthKey("content-length");
+    static const HeaderName contentLengthKey(HEADER_CONTENT_LENGTH);
 
     if (!req.hasHeader(contentLengthKey)) {
         contentLength = 0;
@@ -309,11 +320,137 @@ void HttpServer::sendErrorAndClose(int clientSocket, int statusCode, const char*
     errRes.addHeader("Content-Type", "text/plain; charset=utf-8");
     errRes.setBody(message);
 
-    String payload = errRes.serialize();
-    send(clientSocket, payload.c_str(), payload.length(), 0);
+    sendResponse(clientSocket, errRes);
     close(clientSocket);
 }
 
+/** One per worker thread, kept across requests so it settles at the size they need. */
+MonotonicArena& HttpServer::requestArena(void) {
+    static thread_local MonotonicArena arena;
+    return arena;
+}
+
+/** One per worker thread: its zlib / zstd state is reused by every response it compresses. */
+HttpCompressor& HttpServer::responseCompressor(void) {
+    static thread_local HttpCompressor compressor;
+    return compressor;
+}
+
+/** One per worker thread, for Content-Encoding request bodies. */
+HttpDecompressor& HttpServer::requestDecompressor(void) {
+    static thread_local HttpDecompressor decompressor;
+    return decompressor;
+}
+
+/** Cache entry to build off the request path: the body of an immutable response. */
+struct PrecompressJob {
+    PrecompressedCache* cache;
+    String              body;
+};
+
+/**
+ * Runs on the job lane: compresses an immutable body at the best level into the cache.
+ * Several requests may race to queue the same body; the cache keeps the first entry.
+ */
+void HttpServer::precompressTask(void* context, long encoding) {
+    PrecompressJob* job = (PrecompressJob*) context;
+    String          compressed;
+
+    if (responseCompressor().compress((ContentEncoding) encoding, job->body, compressed, HttpCompressor::LEVEL_BEST)) {
+        job->cache->add((ContentEncoding) encoding, job->body, compressed);
+    }
+    delete job;
+}
+
+/**
+ * Encodes the body in the best coding the client accepts. Small bodies, bodies encoded by
+ * the handler and incompressible types go out as they are, and so does a body compression
+ * would not shrink. Immutable responses (Cache-Control: immutable) are served from
+ * precompressedCache. On a miss the live response is compressed at the fast level like any
+ * other, and the best level variant is built by a pool job, so the first request does not
+ * pay for it; when the job lane is full the cache is simply filled by a later request.
+ */
+void HttpServer::compressResponse(HttpRequest &req, HttpResponse &res) {
+    static const HeaderName acceptEncodingKey(HEADER_ACCEPT_ENCODING);
+
+    if (res.body.size() < MIN_COMPRESS_BYTES || res.headers.exists("Content-Encoding")) {
+        return;
+    }
+    if (res.headers.exists("Content-Type") && !isCompressibleContentType(res.headers.getValue("Content-Type"))) {
+        return;
+    }
+
+    /** From here the body depends on Accept-Encoding: shared caches must key on it. */
+    String& vary = res.headers.add("Vary", "");
+    vary += vary.empty() ? "Accept-Encoding" : ", Accept-Encoding";
+
+    ContentEncoding encoding = req.hasHeader(acceptEncodingKey) ? contentEncodingForAccept(req.get(acceptEncodingKey)) : CONTENT_ENCODING_IDENTITY;
+    if (encoding == CONTENT_ENCODING_IDENTITY) {
+        return;
+    }
+
+    bool   immutable = res.headers.exists("Cache-Control") && res.headers.getValue("Cache-Control").find("immutable") != String::npos;
+    String compressed;
+
+    const PrecompressedCache::Variant* variant = immutable ? precompressedCache.find(encoding, res.body) : nullptr;
+    if (variant != nullptr) {
+        compressed = variant->compressed;
+    } else {
+        if (immutable) {
+            PrecompressJob* job = new PrecompressJob{ &precompressedCache, res.body };
+            if (!taskQueue.tryEnqueueJob(Task{ &HttpServer::precompressTask, job, (long) encoding })) {
+                delete job;
+            }
+        }
+        if (!responseCompressor().compress(encoding, res.body, compressed, HttpCompressor::LEVEL_FAST)) {
+            return;
+        }
+    }
+
+    if (compressed.size() >= res.body.size()) {
+        return;
+    }
+
+    res.body.swap(compressed);
+    res.addHeader("Content-Encoding", contentEncodingName(encoding));
+}
+
+/**
+ * Head and body go out in one gathered write (two iovecs), the body straight from the buffer
+ * the handler wrote into. Loops over short writes.
+ */
+bool HttpServer::sendResponse(int clientSocket, HttpResponse& response) {
+    String       head     = response.serializeHead();
+    struct iovec parts[2] = {
+        { head.data(), head.size() },
+        { response.body.data(), response.body.size() }
+    };
+
+    struct msghdr message = {};
+    message.msg_iov    = parts;
+    message.msg_iovlen = 2;
+
+    while (message.msg_iovlen > 0) {
+        ssize_t sent = sendmsg(clientSocket, &message, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        while (message.msg_iovlen > 0 && (size_t) sent >= message.msg_iov->iov_len) {
+            sent -= message.msg_iov->iov_len;
+            message.msg_iov++;
+            message.msg_iovlen--;
+        }
+        if (message.msg_iovlen > 0) {
+            message.msg_iov->iov_base  = (char*) message.msg_iov->iov_base + sent;
+            message.msg_iov->iov_len  -= sent;
+        }
+    }
+
+    return true;
+}
+
 void HttpServer::bindRouter(IRouter* routerImpl) {
     router = routerImpl;
 }
@@ -353,9 +490,14 @@ void HttpServer::ConnectionHandler::handle() {
                 headersPart     = fullRequest.substr(0, delimiterPos);
 
                 server.parseMethodPathAndVersion(headersPart, req);
-                server.parseHeaders(headersPart, req);
+                if (!server.parseHeaders(headersPart, req)) {
+                    server.sendErrorAndClose(clientSocket, 431, "Request Header Fields Too Large", "Header name exceeds allowed size");
+                    return;
+                }
 
-                if (req.hasHeader("transfer-encoding")) {
+                static const HeaderName transferEncodingKey(HEADER_TRANSFER_ENCODING);
+
+                if (req.hasHeader(transferEncodingKey)) {
                     server.sendErrorAndClose(clientSocket, 501, "Not Implemented", "Transfer-Encoding is not supported");
                     return;
                 }
@@ -369,6 +511,26 @@ void HttpServer::ConnectionHandler::handle() {
                     server.sendErrorAndClose(clientSocket, 413, "Payload Too Large", "Request body exceeds allowed size");
                     return;
                 }
+
+                static const HeaderName contentEncodingKey(HEADER_CONTENT_ENCODING);
+
+                if (req.hasHeader(contentEncodingKey) && expectedBodyBytes > 0) {
+                    ContentEncoding encoding = contentEncodingOf(req.get(contentEncodingKey));
+
+                    if (encoding == CONTENT_ENCODING_UNSUPPORTED) {
+                        server.sendErrorAndClose(clientSocket, 415, "Unsupported Media Type", "Unsupported Content-Encoding");
+                        return;
+                    }
+
+                    compressedBody = encoding != CONTENT_ENCODING_IDENTITY;
+                    if (compressedBody && !requestDecompressor().begin(encoding)) {
+                        server.sendErrorAndClose(clientSocket, 500, "Internal Server Error", "Decompressor unavailable");
+                        return;
+                    }
+                }
+
+                /** Routed first: a request no route serves gets its 404, whatever its body */
+                validateJsonBody = expectedBodyBytes > 0 && server.hasJsonBody(req) && router->hasRoute(&req);
             } else if (fullRequest.size() > MAX_HEADER_BYTES) {
                 server.sendErrorAndClose(clientSocket, 431, "Request Header Fields Too Large", "Request headers exceed allowed size");
                 return;
@@ -378,8 +540,30 @@ void HttpServer::ConnectionHandler::handle() {
         if (headersComplete) {
             String::size_type headerEnd          = delimiterPos + firstDelimiterSize;
             String::size_type bodyBytesAvailable = (fullRequest.size() > headerEnd) ? (fullRequest.size() - headerEnd) : 0;
+            std::string_view  received(fullRequest.data() + headerEnd, std::min< String::size_type >(bodyBytesAvailable, expectedBodyBytes));
+            bool              complete = bodyBytesAvailable >= expectedBodyBytes;
+
+            /** A compressed body is inflated as it arrives; the JSON check then runs on what it decodes to. */
+            if (compressedBody) {
+                DecompressStatus status = decodeBody(received);
+
+                if (status == DECOMPRESS_TOO_LARGE) {
+                    server.sendErrorAndClose(clientSocket, 413, "Payload Too Large", "Decompressed request body exceeds allowed size");
+                    return;
+                }
+                if (status == DECOMPRESS_FAILED || (complete && status != DECOMPRESS_DONE)) {
+                    server.sendErrorAndClose(clientSocket, 400, "Bad Request", "Malformed compressed body");
+                    return;
+                }
+                received = decodedBody;
+            }
 
-            if (bodyBytesAvailable >= expectedBodyBytes) {
+            if (validateJsonBody && !feedJsonBody(received, complete)) {
+                server.sendErrorAndClose(clientSocket, 400, "Bad Request", "Malformed JSON body");
+                return;
+            }
+
+            if (complete) {
                 break;
             }
         }
@@ -388,6 +572,30 @@ void HttpServer::ConnectionHandler::handle() {
     finalize();
 }
 
+/**
+ * Runs the body bytes received since the last call through the push parser, so the JSON is
+ * validated while the rest is still in flight. False as soon as it is malformed.
+ */
+bool HttpServer::ConnectionHandler::feedJsonBody(std::string_view received, bool complete) {
+    if (received.size() > fedBodyBytes) {
+        bodyParser.feed(received.substr(fedBodyBytes));
+        fedBodyBytes = (uint32) received.size();
+    }
+    if (complete) {
+        bodyParser.finish();
+    }
+
+    return bodyParser.status() != JSON_PUSH_ERROR;
+}
+
+/** Inflates the wire bytes received since the last call into decodedBody, up to MAX_DECODED_BODY_BYTES. */
+DecompressStatus HttpServer::ConnectionHandler::decodeBody(std::string_view received) {
+    DecompressStatus status = requestDecompressor().feed(received.substr(decodedWireBytes), decodedBody, MAX_DECODED_BODY_BYTES);
+
+    decodedWireBytes = (uint32) received.size();
+    return status;
+}
+
 void HttpServer::ConnectionHandler::finalize() {
     if (!headersComplete) {
         server.sendErrorAndClose(clientSocket, 400, "Bad Request", "Malformed HTTP request");
@@ -400,16 +608,38 @@ void HttpServer::ConnectionHandler::finalize() {
         return;
     }
 
-    String bodyPart;
-    server.parseBody(delimiterPos, firstDelimiterSize, fullRequest, bodyPart);
-    server.setBody(bodyPart, req);
+    if (compressedBody) {
+        static const HeaderName contentEncodingKey(HEADER_CONTENT_ENCODING);
+        static const HeaderName contentLengthKey(HEADER_CONTENT_LENGTH);
+
+        /** Handlers see the decoded body, so the headers must describe it rather than the wire bytes. */
+        req.body.swap(decodedBody);
+        req.headers.remove(contentEncodingKey);
+        req.headers.remove(contentLengthKey);
+        req.addHeader(contentLengthKey, std::to_string(req.body.size()));
+    } else {
+        String bodyPart;
+        server.parseBody(delimiterPos, firstDelimiterSize, fullRequest, bodyPart);
+        server.setBody(bodyPart, req);
+    }
+
+    /** The push parser checked the whole grammar, readBody need not check it again. */
+    req.jsonBodyValidated = validateJsonBody && bodyParser.status() == JSON_PUSH_COMPLETE;
 
     server.debugRequestHeaders(headersPart, req, fullRequest);
 
-    router->handle(&req, &res);
-    
-    String responseStr = res.serialize();
-    send(clientSocket, responseStr.c_str(), responseStr.length(), 0);
-    
+    {
+        /** Request scoped DOMs (ArenaJson) live in the worker's arena, released in one go. */
+        MonotonicArena& arena = requestArena();
+        ArenaResetGuard release(arena);
+        ArenaScope      scope(arena);
+
+        router->handle(&req, &res);
+    }
+
+    server.compressResponse(req, res);
+
+    server.sendResponse(clientSocket, res);
+
     close(clientSocket);
 }
\ No newline at end of file
@@ -5,8 +5,13 @@
 #ifndef http_server_hpp
 #define http_server_hpp
 
+#include "../../json/body_format.hpp"
+#include "../../json/json_push_parser.hpp"
 #include "../../stl/common.hpp"
+#include "../../stl/monotonic_arena.hpp"
 #include "../../stl/safe_string.hpp"
+#include "http_compression.hpp"
+#include "http_parallel.hpp"
 #include "http_router.hpp"
 #include "http_task_queue.hpp"
 
@@ -41,6 +46,8 @@ private:
         
     private:
         void finalize();
+        bool feedJsonBody(std::string_view received, bool complete);
+        DecompressStatus decodeBody(std::string_view received);
 
     private:
         HttpServer&  server;
@@ -61,14 +68,28 @@ private:
         const char*         firstDelimiter;
         String::size_type   firstDelimiterSize;
         String              headersPart;
+
+        JsonPushParser<>    bodyParser;
+        bool                validateJsonBody  = false;
+        uint32              fedBodyBytes      = 0;
+
+        bool                compressedBody    = false;
+        uint32              decodedWireBytes  = 0;
+        String              decodedBody;
     };
 
 private:
     static constexpr uint32 MAX_HEADER_BYTES  = 16 * 1024;
     static constexpr uint32 MAX_BODY_BYTES    = 1024 * 1024;
     static constexpr uint32 MAX_REQUEST_BYTES = MAX_HEADER_BYTES + MAX_BODY_BYTES;
+    static constexpr uint32 MIN_COMPRESS_BYTES = 1024;
+    static constexpr uint32 MAX_DECODED_BODY_BYTES = 8 * MAX_BODY_BYTES;
+
+    PrecompressedCache precompressedCache;
 
     static void* workerRoutine(void* arg);
+    static void  connectionTask(void* context, long clientSocket);
+    static void  precompressTask(void* context, long encoding);
     void         handleConnection(int clientSocket);
     void         ensureMaxRequestBytesCapacity(String &fullRequest, int clientSocket);
     void         debugRequestHeaders(String &headersPart, HttpRequest &req, String &fullRequest);
@@ -84,8 +105,14 @@ private:
     void         recicleAddress();
     void         startThreadPool();
     void         sendErrorAndClose(int clientSocket, int statusCode, const char* statusText, const char* message);
-    void         parseHeaders(String &headersPart, HttpRequest &req);
+    bool         sendResponse(int clientSocket, HttpResponse& response);
+    static MonotonicArena& requestArena(void);
+    static HttpCompressor& responseCompressor(void);
+    static HttpDecompressor& requestDecompressor(void);
+    void         compressResponse(HttpRequest &req, HttpResponse &res);
+    bool         parseHeaders(String &headersPart, HttpRequest &req);
     bool         tryParseContentLength(HttpRequest &req, uint32 &contentLength);
+    bool         hasJsonBody(HttpRequest &req);
 };
 
 #endif // http_server_hpp
\ No newline at end of file
@@ -4,7 +4,8 @@
  */
 #include "http_task_queue.hpp"
 
-void TaskQueue::init(void) {
+void TaskQueue::init(uint32 nbWorkers) {
+    workerCount = nbWorkers;
     pthread_mutex_init(&mutex, NULL);
     pthread_cond_init(&cond, NULL);
 }
@@ -14,18 +15,27 @@ void TaskQueue::destroy(void) {
     pthread_cond_destroy(&cond);
 }
 
-void TaskQueue::enqueue(int client_socket) {
+void TaskQueue::enqueue(const Task& connection) {
     pthread_mutex_lock(&mutex);
-    if (!sockets.isFull()) {
-        sockets.enqueue(client_socket);
+    if (!connections.isFull()) {
+        connections.enqueue(connection);
         pthread_cond_signal(&cond);
     }
     pthread_mutex_unlock(&mutex);
 }
 
-int TaskQueue::dequeue(void) {
-    int client_socket = -1;
-    
+/** Never blocks: a full job lane means the pool is saturated and the caller runs the job itself. */
+bool TaskQueue::tryEnqueueJob(const Task& job) {
+    pthread_mutex_lock(&mutex);
+    bool queued = jobs.enqueue(job);
+    if (queued) {
+        pthread_cond_signal(&cond);
+    }
+    pthread_mutex_unlock(&mutex);
+    return queued;
+}
+
+Task TaskQueue::dequeue(void) {
     pthread_mutex_lock(&mutex);
     
     /**
@@ -35,16 +45,26 @@ int TaskQueue::dequeue(void) {
         pthread_cond_wait(&cond, &mutex);
     }
     
-    client_socket = sockets.dequeue(); 
+    Task task = !jobs.isEmpty() ? jobs.dequeue() : connections.dequeue();
     
     pthread_mutex_unlock(&mutex);
-    return client_socket;
+    return task;
+}
+
+bool TaskQueue::tryDequeueJob(Task& job) {
+    pthread_mutex_lock(&mutex);
+    bool found = !jobs.isEmpty();
+    if (found) {
+        job = jobs.dequeue();
+    }
+    pthread_mutex_unlock(&mutex);
+    return found;
 }
 
 bool TaskQueue::isFull(void) {
-    return sockets.isFull();
+    return connections.isFull();
 }
 
 bool TaskQueue::isEmpty(void) {
-    return sockets.isEmpty();
-}
\ No newline at end of file
+    return connections.isEmpty() && jobs.isEmpty();
+}
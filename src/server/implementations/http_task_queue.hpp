@@ -13,17 +13,35 @@
 #include <unistd.h>
 #include <netinet/in.h>
 
+typedef void (*TaskFunction)(void* context, long argument);
+
+/** Unit of work of the pool: run(context, argument), e.g. a connection or a parallel chunk. */
+struct Task {
+    TaskFunction run;
+    void*        context;
+    long         argument;
+};
+
+/**
+ * Work shared by the worker threads, in two lanes: accepted connections, and jobs forked by
+ * handlers (http_parallel.hpp). Workers take jobs first so a handler waiting on its forked
+ * jobs is not stuck behind new connections.
+ */
 struct TaskQueue {
-    Queue< int, 512 > sockets;
-    pthread_mutex_t   mutex;
-    pthread_cond_t    cond;
+    Queue< Task, 512 > connections;
+    Queue< Task, 256 > jobs;
+    pthread_mutex_t    mutex;
+    pthread_cond_t     cond;
+    uint32             workerCount;
 
-    void init(void);
+    void init(uint32 nbWorkers);
     void destroy(void);
-    void enqueue(int client_socket);
-    int  dequeue(void);
+    void enqueue(const Task& connection);
+    bool tryEnqueueJob(const Task& job);
+    Task dequeue(void);
+    bool tryDequeueJob(Task& job);
     bool isFull(void);
     bool isEmpty(void);
 };
 
-#endif // http_task_queue_hpp
\ No newline at end of file
+#endif // http_task_queue_hpp
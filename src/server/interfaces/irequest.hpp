@@ -5,21 +5,28 @@
 #ifndef irequest_hpp
 #define irequest_hpp
 
+#include "../../json/json_backend.hpp"
 #include "../../stl/common.hpp"
+#include "../../stl/inline_string.hpp"
 #include "../../stl/safe_string.hpp"
 #include "../types/http_header.hpp"
 
-typedef HeaderContainer< 30 > RequestHeaderContainer;
+typedef HeaderContainer< 16, HeaderName > RequestHeaderContainer;
+typedef InlineString< 16 >                VersionString;
 
 interface IRequest {
-    virtual const String&                 getMethod(void) const = 0;
+    virtual const MethodName&             getMethod(void) const = 0;
     virtual const String&                 getPath(void) const = 0;
-    virtual const String&                 getVersion(void) const = 0;
+    virtual const VersionString&          getVersion(void) const = 0;
     virtual const String&                 getBody(void) const = 0;
     virtual const RequestHeaderContainer& getHeaders(void) const = 0;
-    virtual const bool                    addHeader(const String& key, const String& value) = 0;
-    virtual const bool                    hasHeader(const String& key) const = 0;
-    virtual const String&                 get(const String& key) const = 0;
+    virtual bool                          addHeader(const HeaderName& key, const String& value) = 0;
+    virtual bool                          addHeader(const HeaderName& key, String&& value) = 0;
+    virtual const bool                    hasHeader(const HeaderName& key) const = 0;
+    virtual const String&                 get(const HeaderName& key) const = 0;
+    virtual JsonBackend                   getJsonBackend(void) const = 0;
+    virtual void                          setJsonBackend(JsonBackend backend) = 0;
+    virtual bool                          isJsonBodyValidated(void) const = 0;
     virtual void                          dump(void) = 0;
 };
 
@@ -9,13 +9,15 @@
 #include "../../stl/safe_string.hpp"
 #include "../types/http_header.hpp"
 
-typedef HeaderContainer< 10 > ResponseHeaderContainer; 
+typedef HeaderContainer< 8 > ResponseHeaderContainer; 
 
 interface IResponse {
     virtual const ResponseHeaderContainer& getHeaders(void) = 0;
     virtual void setStatus(int code, const char* text) = 0;
     virtual void addHeader(const char* key, const char* value) = 0;
     virtual void setBody(const char* data) = 0;
+    /** The body itself, for writers that append in place (see JsonWriter). */
+    virtual String& getBodyBuffer(void) = 0;
 };
 
 #endif // iresponse_hpp
\ No newline at end of file
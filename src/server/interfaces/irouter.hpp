@@ -12,7 +12,8 @@
 typedef void (*RequestHandler)(IRequest* req, IResponse* res);
 
 interface IRouter {
-    virtual void add(const char* method, const char* path, RequestHandler handler) = 0;
+    virtual void add(const char* method, const char* path, RequestHandler handler, JsonBackend jsonBackend = JSON_BACKEND_LAZY) = 0;
+    virtual bool hasRoute(const IRequest* req) = 0;
     virtual bool handle(IRequest* req, IResponse* res) = 0;
 };
 
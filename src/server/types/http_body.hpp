@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef http_body_hpp
+#define http_body_hpp
+
+#include "../../json/body_format.hpp"
+#include "../../json/json_binding.hpp"
+#include "../../stl/safe_string.hpp"
+#include "../interfaces/irequest.hpp"
+#include "../interfaces/iresponse.hpp"
+
+/**
+ * Typed bodies for handlers, in whichever format the client negotiated: the request in its
+ * Content-Type (JSON, CBOR or MessagePack, 415 otherwise), the response in the best format
+ * its Accept allows (406 when none).
+ */
+
+inline const char* _bodyFormatName(BodyFormat format) {
+    switch (format) {
+        case BODY_FORMAT_CBOR:    return "CBOR";
+        case BODY_FORMAT_MSGPACK: return "MessagePack";
+        default:                  return "Json";
+    }
+}
+
+/** Reads the request body into out. On failure the response is already set (400 or 415). */
+template< JsonBound T >
+bool readBody(IRequest* req, IResponse* res, T& out) {
+    static const HeaderName contentTypeKey(HEADER_CONTENT_TYPE);
+
+    BodyFormat bodyFormat = req->hasHeader(contentTypeKey) ? bodyFormatOfContentType(req->get(contentTypeKey)) : BODY_FORMAT_JSON;
+    if (bodyFormat == BODY_FORMAT_UNSUPPORTED) {
+        res->setStatus(415, "Unsupported Media Type");
+        res->setBody("Unsupported Content-Type: send application/json, application/cbor or application/msgpack");
+        return false;
+    }
+
+    JsonReadError error;
+    if (bodyRead(req->getBody(), bodyFormat, out, &error, req->getJsonBackend(), req->isJsonBodyValidated())) {
+        return true;
+    }
+
+    String responseBody = error.field.empty() ? format("Invalid {} format", _bodyFormatName(bodyFormat))
+                                              : format("Invalid request: {} {}", error.field, error.reason);
+    res->setStatus(400, "BadRequest");
+    res->setBody(responseBody.c_str());
+    return false;
+}
+
+/** Answers 200 with value in the format the Accept header prefers, or 406. */
+template< JsonBound T >
+void sendBody(IRequest* req, IResponse* res, const T& value) {
+    static const HeaderName acceptKey(HEADER_ACCEPT);
+
+    BodyFormat bodyFormat = req->hasHeader(acceptKey) ? bodyFormatForAccept(req->get(acceptKey)) : BODY_FORMAT_JSON;
+    if (bodyFormat == BODY_FORMAT_UNSUPPORTED) {
+        res->setStatus(406, "Not Acceptable");
+        res->setBody("Acceptable formats: application/json, application/cbor, application/msgpack");
+        return;
+    }
+
+    res->setStatus(200, "OK");
+    res->addHeader("Content-Type", bodyFormatMediaType(bodyFormat));
+    res->addHeader("Vary", "Accept");
+    bodyWrite(res->getBodyBuffer(), bodyFormat, value);
+}
+
+#endif // http_body_hpp
@@ -7,8 +7,14 @@
 #define http_header_hpp
 
 #include "../../stl/associative_container.hpp"
+#include "../../stl/small_vector.hpp"
+#include "./http_names.hpp"
 
-template< uint32 MaxHeaders = 10 >
-using HeaderContainer = AssociativeContainer< String, String, MaxHeaders>;
+/**
+ * InlineHeaders headers are stored inline, more spill to the heap instead of overflowing.
+ * Request headers are keyed by HeaderName, so well known names compare as integers.
+ */
+template< uint32 InlineHeaders = 10, class NameType = String >
+using HeaderContainer = AssociativeContainer< NameType, String, InlineHeaders, SmallVector >;
 
 #endif // http_header_hpp
\ No newline at end of file
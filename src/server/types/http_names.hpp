@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef http_names_hpp
+#define http_names_hpp
+
+#include "../../stl/common.hpp"
+#include "../../stl/intern_table.hpp"
+
+/**
+ * Interned names of the protocol: the well known header names (lower case) and the methods.
+ * The tables are built and frozen on first use, then shared read-only by every worker.
+ * Keep the enums in the seed order: a constant is the id of its name.
+ */
+
+enum HttpHeaderId : uint32 {
+    HEADER_ACCEPT,
+    HEADER_ACCEPT_ENCODING,
+    HEADER_ACCEPT_LANGUAGE,
+    HEADER_AUTHORIZATION,
+    HEADER_CACHE_CONTROL,
+    HEADER_CONNECTION,
+    HEADER_CONTENT_ENCODING,
+    HEADER_CONTENT_LENGTH,
+    HEADER_CONTENT_TYPE,
+    HEADER_COOKIE,
+    HEADER_EXPECT,
+    HEADER_HOST,
+    HEADER_IF_MODIFIED_SINCE,
+    HEADER_IF_NONE_MATCH,
+    HEADER_ORIGIN,
+    HEADER_PRAGMA,
+    HEADER_RANGE,
+    HEADER_REFERER,
+    HEADER_TRANSFER_ENCODING,
+    HEADER_UPGRADE,
+    HEADER_USER_AGENT,
+    HEADER_X_FORWARDED_FOR,
+    HEADER_X_REQUEST_ID,
+    HEADER_COUNT
+};
+
+enum HttpMethod : uint32 {
+    HTTP_GET,
+    HTTP_HEAD,
+    HTTP_POST,
+    HTTP_PUT,
+    HTTP_DELETE,
+    HTTP_CONNECT,
+    HTTP_OPTIONS,
+    HTTP_TRACE,
+    HTTP_PATCH,
+    HTTP_METHOD_COUNT
+};
+
+typedef InternTable< 64, 64 > HeaderNameTable;
+typedef InternTable< 16, 16 > MethodNameTable;
+
+inline const HeaderNameTable& httpHeaderNames(void) {
+    static const HeaderNameTable table = {
+        "accept", "accept-encoding", "accept-language", "authorization", "cache-control",
+        "connection", "content-encoding", "content-length", "content-type", "cookie", "expect",
+        "host", "if-modified-since", "if-none-match", "origin", "pragma", "range", "referer",
+        "transfer-encoding", "upgrade", "user-agent", "x-forwarded-for", "x-request-id"
+    };
+    return table;
+}
+
+inline const MethodNameTable& httpMethodNames(void) {
+    static const MethodNameTable table = {
+        "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH"
+    };
+    return table;
+}
+
+/** Header names compare case insensitively, so they are lower cased when resolved. */
+typedef InternedName< HeaderNameTable, httpHeaderNames, true >  HeaderName;
+typedef InternedName< MethodNameTable, httpMethodNames, false > MethodName;
+
+#endif // http_names_hpp
@@ -0,0 +1,391 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef algorithm_hpp
+#define algorithm_hpp
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Sorting, ordered search and partitioning over contiguous ranges.
+ *
+ * Every algorithm takes [first, last) as pointers or as any contiguous random access iterator
+ * (Collection::Iterator, SmallVector pointers...), plus an overload taking the container
+ * itself (anything with items and length). Names differ from <algorithm> on purpose, so
+ * unqualified calls on std item types never become ambiguous through ADL.
+ *
+ *   introSort       quicksort (median of three), heapsort past 2*log2(n) levels, insertion
+ *                   sort below INSERTION_CUTOFF items. Not stable.
+ *   radixSort       stable LSD byte radix sort of integer or float items, radixSortBy for
+ *                   records with such a key. Passes where every key has the same byte are
+ *                   skipped. Needs one scratch buffer the size of the range.
+ *   lowerBound      branchless binary searches (conditional moves, no mispredictions)
+ *   upperBound
+ *   nthElement      introselect: partial sort leaving the nth item in place
+ *   partitionBy     moves the items matching a predicate first
+ */
+
+struct OrderedLess {
+    template< class LhsType, class RhsType >
+    bool operator () (const LhsType& lhs, const RhsType& rhs) const {
+        return lhs < rhs;
+    }
+};
+
+enum { INSERTION_CUTOFF = 16, RADIX_CUTOFF = 256 };
+
+/** Collection, SmallVector...: contiguous items and a length. */
+template< class ContainerType >
+concept _isItemContainer = requires(ContainerType& container) {
+    container.items + 0;
+    container.length;
+};
+
+/** Raw pointer of a contiguous iterator, end iterators included. */
+template< class IteratorType >
+inline auto* _rangeBegin(IteratorType first) {
+    if constexpr (std::is_pointer_v< IteratorType >) {
+        return first;
+    } else {
+        return &*first;
+    }
+}
+
+/**
+ * Private family functions...
+ */
+
+template< class ItemType, class Less >
+void _insertionSort(ItemType* first, ItemType* last, Less& less) {
+    for (ItemType* current = first + 1; current < last; ++current) {
+        if (!less(*current, *(current - 1))) continue;
+
+        ItemType  item = std::move(*current);
+        ItemType* hole = current;
+        do {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        } while (hole > first && less(item, *(hole - 1)));
+        *hole = std::move(item);
+    }
+}
+
+template< class ItemType, class Less >
+void _siftDown(ItemType* heap, diffptr root, diffptr count, Less& less) {
+    ItemType item = std::move(heap[root]);
+
+    for (diffptr child = 2 * root + 1; child < count; child = 2 * root + 1) {
+        if (child + 1 < count && less(heap[child], heap[child + 1])) child++;
+        if (!less(item, heap[child])) break;
+
+        heap[root] = std::move(heap[child]);
+        root       = child;
+    }
+    heap[root] = std::move(item);
+}
+
+template< class ItemType, class Less >
+void _heapSort(ItemType* first, ItemType* last, Less& less) {
+    diffptr count = last - first;
+
+    for (diffptr root = count / 2 - 1; root >= 0; root--) {
+        _siftDown(first, root, count, less);
+    }
+    for (diffptr end = count - 1; end > 0; end--) {
+        std::swap(first[0], first[end]);
+        _siftDown(first, 0, end, less);
+    }
+}
+
+/**
+ * Median of first, middle and last moved to first, then Hoare partition around it. Returns the
+ * split point: items before it are <= pivot, items from it are >= pivot.
+ */
+template< class ItemType, class Less >
+ItemType* _partitionAroundPivot(ItemType* first, ItemType* last, Less& less) {
+    ItemType* middle = first + (last - first) / 2;
+    ItemType* back   = last - 1;
+
+    if (less(*middle, *first)) std::swap(*middle, *first);
+    if (less(*back, *middle))  std::swap(*back, *middle);
+    if (less(*middle, *first)) std::swap(*middle, *first);
+    std::swap(*first, *middle);
+
+    ItemType* left  = first;
+    ItemType* right = last;
+    while (true) {
+        do { ++left; } while (less(*left, *first));
+        do { --right; } while (less(*first, *right));
+        if (left >= right) break;
+        std::swap(*left, *right);
+    }
+
+    std::swap(*first, *right);
+    return right;
+}
+
+template< class ItemType, class Less >
+void _introSort(ItemType* first, ItemType* last, uint32 depthLimit, Less& less) {
+    while (last - first > INSERTION_CUTOFF) {
+        if (depthLimit-- == 0) {
+            _heapSort(first, last, less);
+            return;
+        }
+
+        ItemType* pivot = _partitionAroundPivot(first, last, less);
+
+        // Recurse on the smaller side: the stack stays O(log n)
+        if (pivot - first < last - pivot) {
+            _introSort(first, pivot, depthLimit, less);
+            first = pivot + 1;
+        } else {
+            _introSort(pivot + 1, last, depthLimit, less);
+            last = pivot;
+        }
+    }
+
+    _insertionSort(first, last, less);
+}
+
+inline uint32 _depthLimit(diffptr count) {
+    uint32 depth = 0;
+    while (count > 1) {
+        count >>= 1;
+        depth++;
+    }
+    return 2 * depth;
+}
+
+/** Integer or float key as an unsigned integer of the same width, in the same order. */
+template< class KeyType >
+inline auto _radixBits(KeyType key) {
+    static_assert(std::is_arithmetic_v< KeyType > || std::is_enum_v< KeyType >, "radixSort needs integer or float keys");
+
+    if constexpr (std::is_enum_v< KeyType >) {
+        return _radixBits((std::underlying_type_t< KeyType >) key);
+    } else if constexpr (std::is_floating_point_v< KeyType >) {
+        typedef std::conditional_t< sizeof(KeyType) == 8, uint64, uint32 > BitsType;
+        static_assert(sizeof(KeyType) == sizeof(BitsType), "radixSort supports float and double");
+
+        constexpr BitsType SIGN = (BitsType) 1 << (sizeof(BitsType) * 8 - 1);
+        BitsType bits;
+        ::memcpy(&bits, &key, sizeof(bits));
+        // Negative numbers: reverse their order; positive ones: above every negative
+        return (bits & SIGN) ? (BitsType) ~bits : (BitsType)(bits | SIGN);
+    } else {
+        typedef std::make_unsigned_t< KeyType > BitsType;
+        constexpr BitsType SIGN = std::is_signed_v< KeyType > ? (BitsType) 1 << (sizeof(BitsType) * 8 - 1) : 0;
+        return (BitsType)((BitsType) key ^ SIGN);
+    }
+}
+
+/**
+ * Public family functions...
+ */
+
+template< class ItemType, class Less = OrderedLess >
+void introSort(ItemType* first, ItemType* last, Less less = Less()) {
+    if (last - first > 1) {
+        _introSort(first, last, _depthLimit(last - first), less);
+    }
+}
+
+template< class IteratorType, class Less = OrderedLess, std::enable_if_t< !std::is_pointer_v< IteratorType >, int > = 0 >
+void introSort(IteratorType first, IteratorType last, Less less = Less()) {
+    auto* begin = _rangeBegin(first);
+    introSort(begin, begin + (last - first), less);
+}
+
+template< class ContainerType, class Less = OrderedLess >
+    requires _isItemContainer< ContainerType >
+void introSort(ContainerType& container, Less less = Less()) {
+    introSort(container.items + 0, container.items + container.length, less);
+}
+
+/**
+ * Stable sort on keyOf(item), an integer, enum or float (NaNs go to the ends by sign).
+ * Items must be trivially copyable: they are copied between the range and a scratch buffer.
+ * Below RADIX_CUTOFF items an insertion sort on the keys is cheaper, and just as stable.
+ */
+template< class ItemType, class KeyOf >
+void radixSortBy(ItemType* first, ItemType* last, KeyOf keyOf) {
+    static_assert(std::is_trivially_copyable_v< ItemType >, "radixSort copies items bitwise");
+    static_assert(alignof(ItemType) <= alignof(std::max_align_t), "radixSort scratch is not over-aligned");
+
+    typedef decltype(_radixBits(keyOf(*first))) BitsType;
+    constexpr uint32 PASSES = sizeof(BitsType);
+
+    diffptr count = last - first;
+    if (count < RADIX_CUTOFF) {
+        auto less = [&keyOf](const ItemType& lhs, const ItemType& rhs) {
+            return _radixBits(keyOf(lhs)) < _radixBits(keyOf(rhs));
+        };
+        if (count > 1) _insertionSort(first, last, less);
+        return;
+    }
+
+    // One read pass builds the histograms of every byte. Unlike simd_find this stays scalar: the
+    // histogram and scatter loops are indexed increments and stores, which SSE2/AVX2 cannot do
+    // (no scatter, no conflict detection). Vector versions of both measured no faster.
+    static thread_local uint32 histograms[PASSES][256];
+    ::memset(histograms, 0, sizeof(histograms));
+
+    for (diffptr idx = 0; idx < count; idx++) {
+        BitsType bits = _radixBits(keyOf(first[idx]));
+        for (uint32 pass = 0; pass < PASSES; pass++) {
+            histograms[pass][(bits >> (8 * pass)) & 0xFF]++;
+        }
+    }
+
+    ItemType* scratch = (ItemType*) ::operator new(count * sizeof(ItemType));
+    ItemType* source  = first;
+    ItemType* target  = scratch;
+
+    for (uint32 pass = 0; pass < PASSES; pass++) {
+        uint32* histogram = histograms[pass];
+
+        if (histogram[(_radixBits(keyOf(*source)) >> (8 * pass)) & 0xFF] == (uint32) count) {
+            continue;
+        }
+
+        uint32 offset = 0;
+        for (uint32 digit = 0; digit < 256; digit++) {
+            uint32 digitCount  = histogram[digit];
+            histogram[digit]   = offset;
+            offset            += digitCount;
+        }
+
+        for (diffptr idx = 0; idx < count; idx++) {
+            uint32 digit = (_radixBits(keyOf(source[idx])) >> (8 * pass)) & 0xFF;
+            ::memcpy((void*) &target[histogram[digit]++], (const void*) &source[idx], sizeof(ItemType));
+        }
+
+        std::swap(source, target);
+    }
+
+    if (source != first) {
+        ::memcpy((void*) first, (const void*) source, count * sizeof(ItemType));
+    }
+    ::operator delete(scratch);
+}
+
+template< class ItemType >
+void radixSort(ItemType* first, ItemType* last) {
+    radixSortBy(first, last, [](const ItemType& item) { return item; });
+}
+
+template< class IteratorType, std::enable_if_t< !std::is_pointer_v< IteratorType >, int > = 0 >
+void radixSort(IteratorType first, IteratorType last) {
+    auto* begin = _rangeBegin(first);
+    radixSort(begin, begin + (last - first));
+}
+
+template< class ContainerType >
+    requires _isItemContainer< ContainerType >
+void radixSort(ContainerType& container) {
+    radixSort(container.items + 0, container.items + container.length);
+}
+
+/** First item not less than value, last if none. */
+template< class ItemType, class ValueType, class Less = OrderedLess >
+ItemType* lowerBound(ItemType* first, ItemType* last, const ValueType& value, Less less = Less()) {
+    diffptr remaining = last - first;
+    if (remaining == 0) return first;
+
+    while (remaining > 1) {
+        diffptr half = remaining / 2;
+        first        = less(first[half - 1], value) ? first + half : first;
+        remaining   -= half;
+    }
+
+    return first + (less(*first, value) ? 1 : 0);
+}
+
+/** First item greater than value, last if none. */
+template< class ItemType, class ValueType, class Less = OrderedLess >
+ItemType* upperBound(ItemType* first, ItemType* last, const ValueType& value, Less less = Less()) {
+    diffptr remaining = last - first;
+    if (remaining == 0) return first;
+
+    while (remaining > 1) {
+        diffptr half = remaining / 2;
+        first        = less(value, first[half - 1]) ? first : first + half;
+        remaining   -= half;
+    }
+
+    return first + (less(value, *first) ? 0 : 1);
+}
+
+template< class IteratorType, class ValueType, class Less = OrderedLess, std::enable_if_t< !std::is_pointer_v< IteratorType >, int > = 0 >
+IteratorType lowerBound(IteratorType first, IteratorType last, const ValueType& value, Less less = Less()) {
+    auto* begin = _rangeBegin(first);
+    return first + (lowerBound(begin, begin + (last - first), value, less) - begin);
+}
+
+template< class IteratorType, class ValueType, class Less = OrderedLess, std::enable_if_t< !std::is_pointer_v< IteratorType >, int > = 0 >
+IteratorType upperBound(IteratorType first, IteratorType last, const ValueType& value, Less less = Less()) {
+    auto* begin = _rangeBegin(first);
+    return first + (upperBound(begin, begin + (last - first), value, less) - begin);
+}
+
+/**
+ * Reorders [first, last) so nth holds the item a full sort would put there, with no greater
+ * item before it and no smaller one after it.
+ */
+template< class ItemType, class Less = OrderedLess >
+void nthElement(ItemType* first, ItemType* nth, ItemType* last, Less less = Less()) {
+    uint32 depthLimit = _depthLimit(last - first);
+
+    while (last - first > INSERTION_CUTOFF) {
+        if (depthLimit-- == 0) {
+            _heapSort(first, last, less);
+            return;
+        }
+
+        ItemType* pivot = _partitionAroundPivot(first, last, less);
+        if (pivot == nth) return;
+
+        if (nth < pivot) {
+            last = pivot;
+        } else {
+            first = pivot + 1;
+        }
+    }
+
+    _insertionSort(first, last, less);
+}
+
+template< class IteratorType, class Less = OrderedLess, std::enable_if_t< !std::is_pointer_v< IteratorType >, int > = 0 >
+void nthElement(IteratorType first, IteratorType nth, IteratorType last, Less less = Less()) {
+    auto* begin = _rangeBegin(first);
+    nthElement(begin, begin + (nth - first), begin + (last - first), less);
+}
+
+/** Items matching predicate first, in no particular order. Returns the first non matching one. */
+template< class ItemType, class Predicate >
+ItemType* partitionBy(ItemType* first, ItemType* last, Predicate predicate) {
+    while (true) {
+        while (first < last && predicate(*first)) ++first;
+        while (first < last && !predicate(*(last - 1))) --last;
+        if (first >= last) return first;
+
+        std::swap(*first, *(last - 1));
+        ++first;
+        --last;
+    }
+}
+
+template< class IteratorType, class Predicate, std::enable_if_t< !std::is_pointer_v< IteratorType >, int > = 0 >
+IteratorType partitionBy(IteratorType first, IteratorType last, Predicate predicate) {
+    auto* begin = _rangeBegin(first);
+    return first + (partitionBy(begin, begin + (last - first), predicate) - begin);
+}
+
+#endif // algorithm_hpp
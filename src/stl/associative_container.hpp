@@ -12,11 +12,14 @@
  * 
  * This container stores key-value pairs using parallel collections.
  * Current complexity: O(n) for lookups due to linear search.
+ *
+ * StorageType is the sequence holding keys and values: Collection (fixed CAPACITY) by default,
+ * or SmallVector to keep CAPACITY items inline and spill to the heap beyond that.
  */
-template< class KeyType, class ValueType, uint32 CAPACITY = 128 >
+template< class KeyType, class ValueType, uint32 CAPACITY = 128, template< class, uint32 > class StorageType = Collection >
 struct AssociativeContainer {
-    Collection<KeyType,   CAPACITY > keys;
-    Collection<ValueType, CAPACITY > values;
+    StorageType< KeyType,   CAPACITY > keys;
+    StorageType< ValueType, CAPACITY > values;
 
     struct Iterator {
         AssociativeContainer* self;
@@ -32,6 +35,10 @@ struct AssociativeContainer {
     };
 
     ValueType& add(const KeyType& key, const ValueType& value);
+    ValueType& add(KeyType&& key, ValueType&& value);
+    template< class... Args >
+    ValueType& emplace(const KeyType& key, Args&&... args);
+    bool       remove(const KeyType& key);
 
     /** Query family functions... */
     bool             exists(const KeyType& key) const;
@@ -45,112 +52,150 @@ struct AssociativeContainer {
     ValueType&       getValueAt(uint32 idx);
     KeyType&         end(void);
     uint32             length(void) const;
+
+private:
+    template< class KeyArg, class... Args >
+    ValueType& _emplace(KeyArg&& key, Args&&... args);
 };
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-void AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::init(AssociativeContainer< KeyType, ValueType, CAPACITY >* itsAssociativeContainer) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+void AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator::init(AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >* itsAssociativeContainer) {
     self = itsAssociativeContainer;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator& AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::begin(void) {
-    currentKey   = self->keys.begin().current;
-    currentValue = self->values.begin().current;
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator::begin(void) {
+    currentKey   = self->keys.items;
+    currentValue = self->values.items;
     return *this;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::end(void) {
-    AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator it;
-    it.currentKey   = self->keys.end().current;
-    it.currentValue = self->values.end().current;
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator::end(void) {
+    AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator it;
+    it.currentKey   = self->keys.items + self->keys.length;
+    it.currentValue = self->values.items + self->values.length;
     
     return it;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-typename AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator& AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::next(void) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+typename AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator::next(void) {
     currentKey++;
     currentValue++;
     return *this;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-KeyType* AssociativeContainer<KeyType, ValueType, CAPACITY >::Iterator::key(void) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+KeyType* AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator::key(void) {
     return currentKey;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-ValueType* AssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::value(void) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+ValueType* AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::Iterator::value(void) {
     return currentValue;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::add(const KeyType& key, const ValueType& value) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::add(const KeyType& key, const ValueType& value) {
+    return _emplace(key, value);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::add(KeyType&& key, ValueType&& value) {
+    return _emplace(std::move(key), std::move(value));
+}
+
+/**
+ * Constructs the value in place from args when key is missing. Like add, an existing
+ * value is left untouched (and args unused).
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+template< class... Args >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::emplace(const KeyType& key, Args&&... args) {
+    return _emplace(key, std::forward< Args >(args)...);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+template< class KeyArg, class... Args >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::_emplace(KeyArg&& key, Args&&... args) {
     int slotIdx = keys.indexOf(key);
  
     if (slotIdx == -1) {
-        keys.add(key);
-        uint32 keyIdx = keys.indexOf(key);
-        values.addAt(keyIdx, value);
-        slotIdx = keyIdx; 
+        keys.add(std::forward< KeyArg >(key));
+        return values.emplace(std::forward< Args >(args)...);
     }
 
     return values.at(slotIdx);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-bool AssociativeContainer< KeyType, ValueType, CAPACITY >::exists(const KeyType& key) const {
+/** Removes key and its value, keeping the order of the others. False when key is absent. */
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+bool AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::remove(const KeyType& key) {
+    int slotIdx = keys.indexOf(key);
+
+    if (slotIdx == -1) {
+        return false;
+    }
+
+    keys.removeAt((uint32) slotIdx);
+    values.removeAt((uint32) slotIdx);
+    return true;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+bool AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::exists(const KeyType& key) const {
     return keys.indexOf(key) != -1;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-KeyType& AssociativeContainer< KeyType, ValueType, CAPACITY >::getKeyAt(uint32 idx) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+KeyType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::getKeyAt(uint32 idx) {
     return keys.at(idx);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-const KeyType& AssociativeContainer< KeyType, ValueType, CAPACITY >::getKeyAt(uint32 idx) const {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+const KeyType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::getKeyAt(uint32 idx) const {
     return keys.at(idx);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::at(const KeyType& key) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::at(const KeyType& key) {
     return values.at(keys.indexOf(key));
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-const ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::at(const KeyType& key) const {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+const ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::at(const KeyType& key) const {
     return values.at(keys.indexOf(key));
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::getValue(const KeyType& key) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::getValue(const KeyType& key) {
     return at(key);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-const ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::getValue(const KeyType& key) const {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+const ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::getValue(const KeyType& key) const {
     return at(key);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-const ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::getValueAt(uint32 idx) const {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+const ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::getValueAt(uint32 idx) const {
     return values.at(idx);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY >::getValueAt(uint32 idx) {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+ValueType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::getValueAt(uint32 idx) {
     return values.at(idx);
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-KeyType& AssociativeContainer< KeyType, ValueType, CAPACITY >::end(void) {
-    return *keys.end().current;
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+KeyType& AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::end(void) {
+    static KeyType dummy;
+    return dummy;
 }
 
-template< class KeyType, class ValueType, uint32 CAPACITY >
-uint32 AssociativeContainer< KeyType, ValueType, CAPACITY >::length(void) const {
+template< class KeyType, class ValueType, uint32 CAPACITY, template< class, uint32 > class StorageType >
+uint32 AssociativeContainer< KeyType, ValueType, CAPACITY, StorageType >::length(void) const {
     return keys.length;
 }
 
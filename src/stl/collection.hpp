@@ -6,14 +6,24 @@
 #define collection_hpp
 
 #include "common.hpp"
+#include "./simd_find.hpp"
+
+#include <new>
+#include <utility>
 
 /**
  * Collection of items...
+ *
+ * items is raw storage (an anonymous union member is never constructed on its own): only the
+ * live range [0, length) holds constructed items, built on add and destroyed on removal, so a
+ * Collection of strings costs nothing until it's filled.
  */
 template< class ItemType, uint32 CAPACITY = 128 >
 struct Collection {
     enum { DEFAULT_CAPACITY = CAPACITY, MAX_COLLECTION_CAPACITY = DEFAULT_CAPACITY + 1 };
-    ItemType items[MAX_COLLECTION_CAPACITY];
+    union {
+        ItemType items[MAX_COLLECTION_CAPACITY];
+    };
     uint32     length;
     uint32     currentItemPos;
     bool     initialized;
@@ -59,7 +69,11 @@ struct Collection {
     
     Collection();
     Collection(const Collection< ItemType, CAPACITY >& collection); 
+    Collection(Collection< ItemType, CAPACITY >&& collection);
     Collection(ItemType items[], uint32 nbItems);
+    ~Collection();
+    Collection&       operator = (const Collection< ItemType, CAPACITY >& rhs);
+    Collection&       operator = (Collection< ItemType, CAPACITY >&& rhs);
     
     void              init(const ItemType items[], uint32 nbItems);
     void              reset(void);
@@ -86,11 +100,20 @@ struct Collection {
      * Modify family functions...
      */
     const ItemType&   add(const ItemType& item);
+    const ItemType&   add(ItemType&& item);
     const Collection& add(const ItemType items[], uint32 nbItems);
     Collection&       add(Collection& rhs);
+    template< class... Args >
+    ItemType&         emplace(Args&&... args);
     const ItemType&   addAt(uint32 idx, const ItemType& item);
+    const ItemType&   addAt(uint32 idx, ItemType&& item);
+    template< class... Args >
+    ItemType&         emplaceAt(uint32 idx, Args&&... args);
     bool              tryAdd(const ItemType& item);
+    bool              tryAdd(ItemType&& item);
     bool              tryAdd(const ItemType items[], uint32 nbItems);
+    template< class... Args >
+    bool              tryEmplace(Args&&... args);
     void              removeAt(uint32 idx);
     void              forAll(void (*callback)(const ItemType& item));
     template< class ConditionFunctionType, class ActionFunctionType >
@@ -107,8 +130,9 @@ struct Collection {
     inline void _ensureIndexCapacityInBounds(uint32 idx) const;
     inline void _ensureCapacity(uint32 nbItems);
     inline void _ensureCapacityAddingArray(uint32 nbItems);
-    inline void _ensureCapacityAddingArrayWithoutFail(uint32 nbItems);
+    inline bool _ensureCapacityAddingArrayWithoutFail(uint32 nbItems);
     inline void _ensureIsInitialized(void);
+    inline void _destroyRange(uint32 from, uint32 to);
 };
 
 template< class ItemType, uint32 CAPACITY >
@@ -250,11 +274,49 @@ Collection< ItemType, CAPACITY >::Collection(const Collection< ItemType, CAPACIT
     init(collection.items, collection.length);
 }
 
+template< class ItemType, uint32 CAPACITY >
+Collection< ItemType, CAPACITY >::Collection(Collection< ItemType, CAPACITY >&& collection): length(0), currentItemPos(0), initialized(true) {
+    for (uint32 idx = 0; idx < collection.length; idx++) {
+        emplace(std::move(collection.items[idx]));
+    }
+}
+
 template< class ItemType, uint32 CAPACITY >
 Collection< ItemType, CAPACITY >::Collection(ItemType items[], uint32 nbItems): length(0), currentItemPos(0), initialized(true) {
     init(items, nbItems);
 }
 
+template< class ItemType, uint32 CAPACITY >
+Collection< ItemType, CAPACITY >::~Collection() {
+    _destroyRange(0, length);
+}
+
+template< class ItemType, uint32 CAPACITY >
+Collection< ItemType, CAPACITY >& Collection< ItemType, CAPACITY >::operator = (const Collection< ItemType, CAPACITY >& rhs) {
+    if (this == &rhs) return *this;
+
+    _destroyRange(0, length);
+    length = 0;
+    init(rhs.items, rhs.length);
+
+    return *this;
+}
+
+template< class ItemType, uint32 CAPACITY >
+Collection< ItemType, CAPACITY >& Collection< ItemType, CAPACITY >::operator = (Collection< ItemType, CAPACITY >&& rhs) {
+    if (this == &rhs) return *this;
+
+    _destroyRange(0, length);
+    length = 0;
+
+    for (uint32 idx = 0; idx < rhs.length; idx++) {
+        emplace(std::move(rhs.items[idx]));
+    }
+    currentItemPos = 0;
+
+    return *this;
+}
+
 template< class ItemType, uint32 CAPACITY >
 void Collection< ItemType, CAPACITY >::init(const ItemType items[], uint32 nbItems) {
     _ensureCapacity(nbItems);
@@ -297,10 +359,26 @@ const ItemType& Collection< ItemType, CAPACITY >::at(uint32 idx) const {
 
 template< class ItemType, uint32 CAPACITY >
 const ItemType& Collection< ItemType, CAPACITY >::add(const ItemType& item) {
+    _ensureIsInitialized();
+    return emplace(item);
+}
+
+template< class ItemType, uint32 CAPACITY >
+const ItemType& Collection< ItemType, CAPACITY >::add(ItemType&& item) {
+    return emplace(std::move(item));
+}
+
+/**
+ * Constructs the new last item in place from args, no temporary is copied.
+ */
+template< class ItemType, uint32 CAPACITY >
+template< class... Args >
+ItemType& Collection< ItemType, CAPACITY >::emplace(Args&&... args) {
     _ensureIsInitialized();
     _ensureCollectionCapacity();
-    items[length++] = item;
-    return item;
+    ItemType* item = new (&items[length]) ItemType(std::forward< Args >(args)...);
+    length++;
+    return *item;
 }
 
 
@@ -325,10 +403,35 @@ Collection< ItemType, CAPACITY >& Collection< ItemType, CAPACITY >::add(Collecti
 
 template< class ItemType, uint32 CAPACITY >
 const ItemType& Collection< ItemType, CAPACITY >::addAt(uint32 idx, const ItemType& item) {
-    _ensureIndexCapacityInBounds(idx);
-    items[idx] = item;
-    length++;
-    return item;
+    return emplaceAt(idx, item);
+}
+
+template< class ItemType, uint32 CAPACITY >
+const ItemType& Collection< ItemType, CAPACITY >::addAt(uint32 idx, ItemType&& item) {
+    return emplaceAt(idx, std::move(item));
+}
+
+/**
+ * Inserts at idx (0 <= idx <= length), moving the following items up.
+ */
+template< class ItemType, uint32 CAPACITY >
+template< class... Args >
+ItemType& Collection< ItemType, CAPACITY >::emplaceAt(uint32 idx, Args&&... args) {
+    SA_ASSERT(idx <= length, "Index out of bounds!");
+
+    if (idx == length) {
+        return emplace(std::forward< Args >(args)...);
+    }
+
+    ItemType item(std::forward< Args >(args)...);
+
+    emplace(std::move(items[length - 1]));
+    for (uint32 i = length - 2; i > idx; i--) {
+        items[i] = std::move(items[i - 1]);
+    }
+    items[idx] = std::move(item);
+
+    return items[idx];
 }
 
 template< class ItemType, uint32 CAPACITY >
@@ -340,6 +443,25 @@ bool Collection< ItemType, CAPACITY >::tryAdd(const ItemType& item) {
     return true;
 }
 
+template< class ItemType, uint32 CAPACITY >
+bool Collection< ItemType, CAPACITY >::tryAdd(ItemType&& item) {
+    if (!_ensureCollectionCapacityWithoutFail()) return false;
+
+    add(std::move(item));
+
+    return true;
+}
+
+template< class ItemType, uint32 CAPACITY >
+template< class... Args >
+bool Collection< ItemType, CAPACITY >::tryEmplace(Args&&... args) {
+    if (!_ensureCollectionCapacityWithoutFail()) return false;
+
+    emplace(std::forward< Args >(args)...);
+
+    return true;
+}
+
 template< class ItemType, uint32 CAPACITY >
 bool Collection< ItemType, CAPACITY >::tryAdd(const ItemType items[], uint32 nbItems) {
     if (!_ensureCapacityAddingArrayWithoutFail(nbItems)) return false;
@@ -372,16 +494,12 @@ template< class ItemType, uint32 CAPACITY >
 void Collection< ItemType, CAPACITY >::removeAt(uint32 idx) {
     _ensureIndexLengthInBounds(idx);
 
-    if (length == 1) {
-        length = 0;
-        return;
-    }
-
     for (uint32 i = idx; i < length - 1; i++) {
-        items[i] = items[i + 1];
+        items[i] = std::move(items[i + 1]);
     }
     
     length--;
+    _destroyRange(length, length + 1);
 }
 
 template< class ItemType, uint32 CAPACITY >
@@ -415,18 +533,26 @@ bool Collection< ItemType, CAPACITY >::operator != (const Collection< ItemType,
 
 template< class ItemType, uint32 CAPACITY >
 int Collection< ItemType, CAPACITY >::indexOf(const ItemType& item) {
-    for (auto&& it = begin(); it != end(); ++it) {
-        if (*it == item) return it.currentPos();
+    if constexpr (isSimdFindable< ItemType >) {
+        return simdFind(items, length, item);
+    } else {
+        for (auto&& it = begin(); it != end(); ++it) {
+            if (*it == item) return it.currentPos();
+        }
+        return -1;
     }
-    return -1;
 }
 
 template< class ItemType, uint32 CAPACITY >
 const int Collection< ItemType, CAPACITY >::indexOf(const ItemType& item) const {
-    for (uint32 idx = 0; idx < length; idx++) {
-        if (items[idx] == item) return idx;
+    if constexpr (isSimdFindable< ItemType >) {
+        return simdFind(items, length, item);
+    } else {
+        for (uint32 idx = 0; idx < length; idx++) {
+            if (items[idx] == item) return idx;
+        }
+        return -1;
     }
-    return -1;
 }
 
 /**
@@ -470,7 +596,7 @@ inline void Collection< ItemType, CAPACITY >::_ensureCapacityAddingArray(uint32
 }
 
 template< class ItemType, uint32 CAPACITY >
-inline void Collection< ItemType, CAPACITY >::_ensureCapacityAddingArrayWithoutFail(uint32 nbItems) {
+inline bool Collection< ItemType, CAPACITY >::_ensureCapacityAddingArrayWithoutFail(uint32 nbItems) {
     return nbItems + length <= DEFAULT_CAPACITY;
 }
 
@@ -479,4 +605,13 @@ inline void Collection< ItemType, CAPACITY >::_ensureIsInitialized(void) {
     SA_ASSERT(initialized, "Uninitialised collection!");
 }
 
+template < class ItemType, uint32 CAPACITY >
+inline void Collection< ItemType, CAPACITY >::_destroyRange(uint32 from, uint32 to) {
+    if constexpr (!std::is_trivially_destructible_v< ItemType >) {
+        for (uint32 idx = from; idx < to; idx++) {
+            items[idx].~ItemType();
+        }
+    }
+}
+
 #endif // collection_hpp
\ No newline at end of file
@@ -19,10 +19,11 @@
 #    define SA_PRINT_ERR(...)
 #endif
 
-typedef unsigned char uint8;
-typedef unsigned int  uint32;
-typedef unsigned long ulong;
-typedef long long     diffptr;
+typedef unsigned char      uint8;
+typedef unsigned int       uint32;
+typedef unsigned long      ulong;
+typedef unsigned long long uint64;
+typedef long long          diffptr;
 
 #define interface    struct
 #define implements   public
@@ -0,0 +1,490 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef concurrent_hash_map_hpp
+#define concurrent_hash_map_hpp
+
+#include "common.hpp"
+#include "./hash.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <immintrin.h>
+#endif // __x86_64__
+
+/**
+ * ConcurrentHashMap - Hash map shared by all the worker threads (sessions, rate limit
+ * counters, caches...).
+ *
+ * Keys are spread over SHARD_COUNT independent shards, each one a linear probing table with
+ * its own mutex, so writers only contend when they hit the same shard. Readers never take a
+ * lock: every shard carries a sequence counter (seqlock) that writers make odd while they
+ * modify it, and a reader copies the slots it needs and retries if the counter moved.
+ * Reads therefore never block writers nor each other; they only retry while a writer is in
+ * the very same shard.
+ *
+ * Since readers copy slots that may be concurrently written, keys and values must be
+ * trivially copyable (fixed size strings, ids, counters...). Tables that are replaced by a
+ * bigger one are kept until the map is destroyed, so a reader holding an old table pointer
+ * always reads valid memory; the geometric growth bounds that overhead to the live size.
+ *
+ * SHARD_CAPACITY is the initial slot count of each shard, which doubles when 3/4 full.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT = 16, uint32 SHARD_CAPACITY = 64, class Hasher = Hash< KeyType > >
+struct ConcurrentHashMap {
+    static_assert(std::is_trivially_copyable_v< KeyType > && std::is_trivially_copyable_v< ValueType >,
+                  "Seqlock readers copy slots while they may be written, use trivially copyable types");
+    static_assert(SHARD_COUNT > 0 && SHARD_COUNT <= 256 && (SHARD_COUNT & (SHARD_COUNT - 1)) == 0,
+                  "SHARD_COUNT must be a power of two no bigger than 256");
+
+    enum { MIN_SLOTS = 8, SPINS_BEFORE_YIELD = 64 };
+
+    /** hash == 0 marks an empty slot, stored hashes always have the lowest bit set. */
+    struct Slot {
+        uint64    hash;
+        KeyType   key;
+        ValueType value;
+    };
+
+    struct Table {
+        Slot*     slots;
+        uint32    capacity;
+        Table*    retired;
+    };
+
+    struct alignas(64) Shard {
+        std::atomic< uint32 >  sequence;
+        std::atomic< Table* >  table;
+        std::atomic< uint32 >  count;
+        Table*                 retired;
+        pthread_mutex_t        mutex;
+    };
+
+    Shard             shards[SHARD_COUNT];
+
+    ConcurrentHashMap();
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator = (const ConcurrentHashMap&) = delete;
+    ~ConcurrentHashMap();
+
+    /** Query family functions (lock free)... */
+    bool             find(const KeyType& key, ValueType& value) const;
+    bool             exists(const KeyType& key) const;
+    ValueType        getValue(const KeyType& key, const ValueType& fallback = ValueType()) const;
+    uint32           length(void) const;
+
+    /** Modify family functions (lock the key's shard)... */
+    bool             add(const KeyType& key, const ValueType& value);
+    template< class Updater >
+    ValueType        update(const KeyType& key, const ValueType& initial, Updater updater);
+    bool             remove(const KeyType& key);
+    void             clear(void);
+
+private:
+    static uint64     _hash(const KeyType& key);
+    static uint32     _homeOf(uint64 hash, uint32 capacity);
+    static uint32     _roundSlotCount(uint32 nbSlots);
+    static Table*     _allocateTable(uint32 capacity);
+    static void       _releaseTable(Table* table);
+    static bool       _probe(const Table* table, const KeyType& key, uint64 hash, ValueType& value);
+    static void       _cpuRelax(uint32 spins);
+
+    Shard&            _shardOf(uint64 hash);
+    const Shard&      _shardOf(uint64 hash) const;
+    Slot*             _findSlot(Table* table, const KeyType& key, uint64 hash);
+    Slot*             _insertSlot(Shard& shard, const KeyType& key, uint64 hash);
+    void              _grow(Shard& shard);
+    void              _beginWrite(Shard& shard);
+    void              _endWrite(Shard& shard);
+};
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::ConcurrentHashMap() {
+    for (uint32 i = 0; i < SHARD_COUNT; ++i) {
+        shards[i].sequence.store(0, std::memory_order_relaxed);
+        shards[i].table.store(_allocateTable(_roundSlotCount(SHARD_CAPACITY)), std::memory_order_relaxed);
+        shards[i].count.store(0, std::memory_order_relaxed);
+        shards[i].retired = nullptr;
+        pthread_mutex_init(&shards[i].mutex, nullptr);
+    }
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::~ConcurrentHashMap() {
+    for (uint32 i = 0; i < SHARD_COUNT; ++i) {
+        _releaseTable(shards[i].table.load(std::memory_order_relaxed));
+
+        Table* retired = shards[i].retired;
+        while (retired != nullptr) {
+            Table* next = retired->retired;
+            _releaseTable(retired);
+            retired = next;
+        }
+
+        pthread_mutex_destroy(&shards[i].mutex);
+    }
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+uint64 ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_hash(const KeyType& key) {
+    return Hasher()(key) | 1;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+uint32 ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_homeOf(uint64 hash, uint32 capacity) {
+    return (uint32)(hash >> 1) & (capacity - 1);
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+uint32 ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_roundSlotCount(uint32 nbSlots) {
+    uint32 rounded = MIN_SLOTS;
+    while (rounded < nbSlots) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+typename ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::Table*
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_allocateTable(uint32 capacity) {
+    Table* table    = new Table;
+    table->slots    = new Slot[capacity]();
+    table->capacity = capacity;
+    table->retired  = nullptr;
+
+    return table;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+void ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_releaseTable(Table* table) {
+    delete[] table->slots;
+    delete table;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+void ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_cpuRelax(uint32 spins) {
+    if (spins < SPINS_BEFORE_YIELD) {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif // __x86_64__
+    } else {
+        // The writer may have been preempted in the middle of its update
+        sched_yield();
+    }
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+typename ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::Shard&
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_shardOf(uint64 hash) {
+    return shards[(hash >> 56) & (SHARD_COUNT - 1)];
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+const typename ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::Shard&
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_shardOf(uint64 hash) const {
+    return shards[(hash >> 56) & (SHARD_COUNT - 1)];
+}
+
+/**
+ * Reader side probe. Slots are copied out before being looked at, since a writer may be
+ * modifying them; the copy is only trusted once the caller validated the shard sequence.
+ * The probe is bounded by the capacity so a torn read can't loop forever.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+bool ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_probe(
+    const Table* table, const KeyType& key, uint64 hash, ValueType& value) {
+
+    uint32 mask    = table->capacity - 1;
+    uint32 slotIdx = _homeOf(hash, table->capacity);
+    Slot   slot;
+
+    for (uint32 probes = 0; probes < table->capacity; ++probes) {
+        ::memcpy((void*) &slot, (const void*) &table->slots[slotIdx], sizeof(Slot));
+
+        if (slot.hash == 0) {
+            return false;
+        }
+
+        if (slot.hash == hash && slot.key == key) {
+            value = slot.value;
+            return true;
+        }
+
+        slotIdx = (slotIdx + 1) & mask;
+    }
+
+    return false;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+bool ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::find(const KeyType& key, ValueType& value) const {
+    uint64       hash  = _hash(key);
+    const Shard& shard = _shardOf(hash);
+    uint32       spins = 0;
+
+    for (;;) {
+        uint32 sequence = shard.sequence.load(std::memory_order_acquire);
+
+        if (sequence & 1) {
+            _cpuRelax(spins++);
+            continue;
+        }
+
+        ValueType candidate;
+        bool      found = _probe(shard.table.load(std::memory_order_acquire), key, hash, candidate);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shard.sequence.load(std::memory_order_relaxed) == sequence) {
+            if (found) {
+                value = candidate;
+            }
+            return found;
+        }
+
+        _cpuRelax(spins++);
+    }
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+bool ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::exists(const KeyType& key) const {
+    ValueType value;
+    return find(key, value);
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+ValueType ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::getValue(
+    const KeyType& key, const ValueType& fallback) const {
+
+    ValueType value;
+    return find(key, value) ? value : fallback;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+uint32 ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::length(void) const {
+    uint32 total = 0;
+
+    for (uint32 i = 0; i < SHARD_COUNT; ++i) {
+        total += shards[i].count.load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+void ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_beginWrite(Shard& shard) {
+    uint32 sequence = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+void ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_endWrite(Shard& shard) {
+    uint32 sequence = shard.sequence.load(std::memory_order_relaxed);
+    shard.sequence.store(sequence + 1, std::memory_order_release);
+}
+
+/**
+ * Writer side lookup, only called with the shard mutex held.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+typename ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::Slot*
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_findSlot(
+    Table* table, const KeyType& key, uint64 hash) {
+
+    uint32 mask    = table->capacity - 1;
+    uint32 slotIdx = _homeOf(hash, table->capacity);
+
+    while (table->slots[slotIdx].hash != 0) {
+        Slot& slot = table->slots[slotIdx];
+
+        if (slot.hash == hash && slot.key == key) {
+            return &slot;
+        }
+
+        slotIdx = (slotIdx + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Replaces the shard table by one twice as big. Must run inside a write section: the old
+ * table is retired, not freed, because readers may still be probing it.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+void ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_grow(Shard& shard) {
+    Table* oldTable = shard.table.load(std::memory_order_relaxed);
+    Table* newTable = _allocateTable(oldTable->capacity * 2);
+    uint32 mask     = newTable->capacity - 1;
+
+    for (uint32 i = 0; i < oldTable->capacity; ++i) {
+        const Slot& slot = oldTable->slots[i];
+
+        if (slot.hash == 0) {
+            continue;
+        }
+
+        uint32 slotIdx = _homeOf(slot.hash, newTable->capacity);
+        while (newTable->slots[slotIdx].hash != 0) {
+            slotIdx = (slotIdx + 1) & mask;
+        }
+        newTable->slots[slotIdx] = slot;
+    }
+
+    oldTable->retired = shard.retired;
+    shard.retired     = oldTable;
+    shard.table.store(newTable, std::memory_order_release);
+}
+
+/**
+ * Claims the slot of a key known to be missing, growing the shard first if needed.
+ * Must run inside a write section.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+typename ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::Slot*
+ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::_insertSlot(
+    Shard& shard, const KeyType& key, uint64 hash) {
+
+    uint32 count = shard.count.load(std::memory_order_relaxed);
+    Table* table = shard.table.load(std::memory_order_relaxed);
+
+    if ((count + 1) * 4 > table->capacity * 3) {
+        _grow(shard);
+        table = shard.table.load(std::memory_order_relaxed);
+    }
+
+    uint32 mask    = table->capacity - 1;
+    uint32 slotIdx = _homeOf(hash, table->capacity);
+
+    while (table->slots[slotIdx].hash != 0) {
+        slotIdx = (slotIdx + 1) & mask;
+    }
+
+    Slot& slot = table->slots[slotIdx];
+    slot.key   = key;
+    slot.hash  = hash;
+    shard.count.store(count + 1, std::memory_order_relaxed);
+
+    return &slot;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+bool ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::add(const KeyType& key, const ValueType& value) {
+    uint64 hash  = _hash(key);
+    Shard& shard = _shardOf(hash);
+
+    pthread_mutex_lock(&shard.mutex);
+
+    Slot* slot     = _findSlot(shard.table.load(std::memory_order_relaxed), key, hash);
+    bool  inserted = slot == nullptr;
+
+    _beginWrite(shard);
+    if (inserted) {
+        slot = _insertSlot(shard, key, hash);
+    }
+    slot->value = value;
+    _endWrite(shard);
+
+    pthread_mutex_unlock(&shard.mutex);
+    return inserted;
+}
+
+/**
+ * Atomically applies updater(ValueType&) to the value of key, starting from initial when the
+ * key is missing, and returns the updated value. Meant for counters:
+ *     hits.update(clientIp, 0, [](uint32& count) { count++; });
+ * The updater runs with the shard locked, keep it short.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+template< class Updater >
+ValueType ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::update(
+    const KeyType& key, const ValueType& initial, Updater updater) {
+
+    uint64 hash  = _hash(key);
+    Shard& shard = _shardOf(hash);
+
+    pthread_mutex_lock(&shard.mutex);
+
+    Slot*     slot  = _findSlot(shard.table.load(std::memory_order_relaxed), key, hash);
+    ValueType value = slot != nullptr ? slot->value : initial;
+
+    updater(value);
+
+    _beginWrite(shard);
+    if (slot == nullptr) {
+        slot = _insertSlot(shard, key, hash);
+    }
+    slot->value = value;
+    _endWrite(shard);
+
+    pthread_mutex_unlock(&shard.mutex);
+    return value;
+}
+
+/**
+ * Backward shift deletion: the following entries of the probe run are moved back into the
+ * hole, so no tombstone is left behind.
+ */
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+bool ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::remove(const KeyType& key) {
+    uint64 hash  = _hash(key);
+    Shard& shard = _shardOf(hash);
+
+    pthread_mutex_lock(&shard.mutex);
+
+    Table* table = shard.table.load(std::memory_order_relaxed);
+    Slot*  slot  = _findSlot(table, key, hash);
+
+    if (slot == nullptr) {
+        pthread_mutex_unlock(&shard.mutex);
+        return false;
+    }
+
+    uint32 mask    = table->capacity - 1;
+    uint32 holeIdx = (uint32)(slot - table->slots);
+    uint32 nextIdx = (holeIdx + 1) & mask;
+
+    _beginWrite(shard);
+    while (table->slots[nextIdx].hash != 0) {
+        uint32 homeIdx = _homeOf(table->slots[nextIdx].hash, table->capacity);
+
+        // Move back unless the entry's home lies in (hole, next]
+        if (((nextIdx - homeIdx) & mask) >= ((nextIdx - holeIdx) & mask)) {
+            table->slots[holeIdx] = table->slots[nextIdx];
+            holeIdx = nextIdx;
+        }
+        nextIdx = (nextIdx + 1) & mask;
+    }
+    table->slots[holeIdx].hash = 0;
+    shard.count.store(shard.count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    _endWrite(shard);
+
+    pthread_mutex_unlock(&shard.mutex);
+    return true;
+}
+
+template< class KeyType, class ValueType, uint32 SHARD_COUNT, uint32 SHARD_CAPACITY, class Hasher >
+void ConcurrentHashMap< KeyType, ValueType, SHARD_COUNT, SHARD_CAPACITY, Hasher >::clear(void) {
+    for (uint32 i = 0; i < SHARD_COUNT; ++i) {
+        Shard& shard = shards[i];
+
+        pthread_mutex_lock(&shard.mutex);
+        _beginWrite(shard);
+
+        Table* table = shard.table.load(std::memory_order_relaxed);
+        for (uint32 slotIdx = 0; slotIdx < table->capacity; ++slotIdx) {
+            table->slots[slotIdx].hash = 0;
+        }
+        shard.count.store(0, std::memory_order_relaxed);
+
+        _endWrite(shard);
+        pthread_mutex_unlock(&shard.mutex);
+    }
+}
+
+#endif // concurrent_hash_map_hpp
@@ -0,0 +1,558 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef flat_hash_map_hpp
+#define flat_hash_map_hpp
+
+#include "common.hpp"
+#include "./hash.hpp"
+#include "./pool_allocator.hpp"
+
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif // __SSE2__
+
+/**
+ * FlatHashMap - Open addressing hash map in the Swiss table style.
+ *
+ * Every slot has a 1 byte control word: 0x80 when empty, otherwise the low 7 bits of the key
+ * hash. Lookups compare 16 control words at once (SSE2, scalar fallback elsewhere) and only
+ * touch the keys whose 7 bit tag matches. Keys and values live inline in one slot array, so an
+ * insert never allocates unless the table grows.
+ *
+ * Probing is linear (group by group) and deletion shifts the following entries back instead of
+ * leaving tombstones, so lookups never degrade after many removals.
+ *
+ * CAPACITY is the initial number of slots; the table doubles when it gets 7/8 full.
+ * Same add/exists/at/remove API as HashAssociativeContainer.
+ *
+ * Moving a map steals its table; the moved-from map may only be destroyed or assigned to.
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY = 128, class Hasher = Hash< KeyType > >
+struct FlatHashMap {
+    enum { GROUP_WIDTH = 16, MIN_SLOTS = GROUP_WIDTH };
+
+    static constexpr uint8  CTRL_EMPTY = 0x80;
+    static constexpr uint32 NOT_FOUND  = 0xFFFFFFFFu;
+
+    struct Slot {
+        KeyType   key;
+        ValueType value;
+    };
+
+    Slot*             slots;
+    uint8*            ctrl;
+    uint32            slotCount;
+    uint32            entryCount;
+    PoolAllocator*    allocator;
+
+    struct Iterator {
+        FlatHashMap*          self;
+        uint32                currentSlot;
+
+        void                  init(FlatHashMap* container);
+        Iterator&             begin(void);
+        Iterator              end(void);
+        Iterator&             next(void);
+        KeyType*              key(void);
+        ValueType*            value(void);
+    };
+
+    FlatHashMap();
+    FlatHashMap(PoolAllocator* poolAlloc);
+    FlatHashMap(const FlatHashMap&) = delete;
+    FlatHashMap(FlatHashMap&& other);
+    FlatHashMap& operator = (const FlatHashMap&) = delete;
+    FlatHashMap& operator = (FlatHashMap&& other);
+    ~FlatHashMap();
+
+    ValueType& add(const KeyType& key, const ValueType& value);
+    ValueType& add(KeyType&& key, ValueType&& value);
+    template< class... Args >
+    ValueType& emplace(const KeyType& key, Args&&... args);
+
+    /** Query family functions... */
+    bool             exists(const KeyType& key) const;
+    ValueType*       find(const KeyType& key);
+    const ValueType* find(const KeyType& key) const;
+    ValueType&       at(const KeyType& key);
+    const ValueType& at(const KeyType& key) const;
+    ValueType&       getValue(const KeyType& key);
+    const ValueType& getValue(const KeyType& key) const;
+    uint32           length(void) const;
+
+    /** Modify family functions... */
+    bool             remove(const KeyType& key);
+    void             clear(void);
+    void             reserve(uint32 nbItems);
+
+private:
+    struct Group {
+#if defined(__SSE2__)
+        __m128i      bytes;
+#else
+        uint8        bytes[GROUP_WIDTH];
+#endif // __SSE2__
+
+        explicit     Group(const uint8* ctrlPtr);
+        uint32       match(uint8 tag) const;
+        uint32       matchEmpty(void) const;
+    };
+
+    static uint32     _roundSlotCount(uint32 nbItems);
+    static uint32     _tag(uint64 hash);
+    static uint32     _home(uint64 hash, uint32 mask);
+
+    uint32            _findSlot(const KeyType& key, uint64 hash) const;
+    uint32            _findEmptySlot(uint64 hash) const;
+    void              _setCtrl(uint32 idx, uint8 value);
+    void              _allocateTable(uint32 nbSlots);
+    void              _releaseTable(Slot* oldSlots);
+    void              _rehash(uint32 nbSlots);
+    void              _destroyAll(void);
+    void              _steal(FlatHashMap& other);
+    template< class KeyArg, class ValueArg >
+    ValueType&        _assign(KeyArg&& key, ValueArg&& value);
+    template< class KeyArg, class... Args >
+    ValueType&        _emplaceNew(uint64 hash, KeyArg&& key, Args&&... args);
+};
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Group::Group(const uint8* ctrlPtr) {
+#if defined(__SSE2__)
+    bytes = _mm_loadu_si128((const __m128i*) ctrlPtr);
+#else
+    ::memcpy(bytes, ctrlPtr, GROUP_WIDTH);
+#endif // __SSE2__
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Group::match(uint8 tag) const {
+#if defined(__SSE2__)
+    return (uint32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char) tag), bytes));
+#else
+    uint32 mask = 0;
+    for (uint32 i = 0; i < GROUP_WIDTH; ++i) {
+        mask |= (uint32)(bytes[i] == tag) << i;
+    }
+    return mask;
+#endif // __SSE2__
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Group::matchEmpty(void) const {
+#if defined(__SSE2__)
+    return (uint32) _mm_movemask_epi8(bytes);
+#else
+    uint32 mask = 0;
+    for (uint32 i = 0; i < GROUP_WIDTH; ++i) {
+        mask |= (uint32)(bytes[i] >> 7) << i;
+    }
+    return mask;
+#endif // __SSE2__
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::FlatHashMap()
+    : slots(nullptr), ctrl(nullptr), slotCount(0), entryCount(0), allocator(nullptr) {
+    _allocateTable(_roundSlotCount(CAPACITY));
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::FlatHashMap(PoolAllocator* poolAlloc)
+    : slots(nullptr), ctrl(nullptr), slotCount(0), entryCount(0), allocator(poolAlloc) {
+    _allocateTable(_roundSlotCount(CAPACITY));
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::FlatHashMap(FlatHashMap&& other) {
+    _steal(other);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::operator = (FlatHashMap&& other) {
+    if (this != &other) {
+        _destroyAll();
+        _releaseTable(slots);
+        _steal(other);
+    }
+    return *this;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::~FlatHashMap() {
+    _destroyAll();
+    _releaseTable(slots);
+    slots = nullptr;
+    ctrl  = nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_steal(FlatHashMap& other) {
+    slots      = other.slots;
+    ctrl       = other.ctrl;
+    slotCount  = other.slotCount;
+    entryCount = other.entryCount;
+    allocator  = other.allocator;
+
+    other.slots      = nullptr;
+    other.ctrl       = nullptr;
+    other.slotCount  = 0;
+    other.entryCount = 0;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_roundSlotCount(uint32 nbItems) {
+    uint32 nbSlots = MIN_SLOTS;
+    while (nbSlots < nbItems) {
+        nbSlots <<= 1;
+    }
+    return nbSlots;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_tag(uint64 hash) {
+    return (uint32)(hash & 0x7F);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_home(uint64 hash, uint32 mask) {
+    return (uint32)(hash >> 7) & mask;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_allocateTable(uint32 nbSlots) {
+    /** One block: the slots, then the control words plus a mirror of the first GROUP_WIDTH - 1 of them. */
+    uint32 slotBytes = nbSlots * sizeof(Slot);
+    uint32 ctrlBytes = nbSlots + GROUP_WIDTH - 1;
+    void*  block;
+
+    if (allocator != nullptr) {
+        block = allocator->allocAligned(slotBytes + ctrlBytes, alignof(Slot));
+        SA_ASSERT(block != nullptr, "Pool exhausted!");
+        if (block == nullptr) throw std::bad_alloc();
+    } else {
+        block = ::operator new(slotBytes + ctrlBytes, std::align_val_t(alignof(Slot)));
+    }
+
+    slots     = (Slot*) block;
+    ctrl      = (uint8*) block + slotBytes;
+    slotCount = nbSlots;
+
+    ::memset(ctrl, CTRL_EMPTY, ctrlBytes);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_releaseTable(Slot* oldSlots) {
+    if (oldSlots == nullptr) {
+        return;
+    }
+
+    if (allocator != nullptr) {
+        allocator->dealloc(oldSlots);
+    } else {
+        ::operator delete((void*) oldSlots, std::align_val_t(alignof(Slot)));
+    }
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_setCtrl(uint32 idx, uint8 value) {
+    ctrl[idx] = value;
+
+    if (idx < GROUP_WIDTH - 1) {
+        ctrl[slotCount + idx] = value;
+    }
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_findSlot(const KeyType& key, uint64 hash) const {
+    uint32 mask = slotCount - 1;
+    uint32 pos  = _home(hash, mask);
+    uint8  tag  = (uint8) _tag(hash);
+
+    while (true) {
+        Group group(ctrl + pos);
+
+        for (uint32 candidates = group.match(tag); candidates != 0; candidates &= candidates - 1) {
+            uint32 idx = (pos + __builtin_ctz(candidates)) & mask;
+            if (slots[idx].key == key) {
+                return idx;
+            }
+        }
+
+        if (group.matchEmpty() != 0) {
+            return NOT_FOUND;
+        }
+
+        pos = (pos + GROUP_WIDTH) & mask;
+    }
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_findEmptySlot(uint64 hash) const {
+    uint32 mask = slotCount - 1;
+    uint32 pos  = _home(hash, mask);
+
+    while (true) {
+        uint32 empties = Group(ctrl + pos).matchEmpty();
+
+        if (empties != 0) {
+            return (pos + __builtin_ctz(empties)) & mask;
+        }
+
+        pos = (pos + GROUP_WIDTH) & mask;
+    }
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_rehash(uint32 nbSlots) {
+    Slot*  oldSlots     = slots;
+    uint8* oldCtrl      = ctrl;
+    uint32 oldSlotCount = slotCount;
+
+    _allocateTable(nbSlots);
+
+    for (uint32 i = 0; i < oldSlotCount; ++i) {
+        if (oldCtrl[i] == CTRL_EMPTY) {
+            continue;
+        }
+
+        uint64 hash = Hasher()(oldSlots[i].key);
+        uint32 idx  = _findEmptySlot(hash);
+
+        new (&slots[idx]) Slot(std::move(oldSlots[i]));
+        _setCtrl(idx, (uint8) _tag(hash));
+        oldSlots[i].~Slot();
+    }
+
+    _releaseTable(oldSlots);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_destroyAll(void) {
+    if constexpr (!std::is_trivially_destructible_v< Slot >) {
+        for (uint32 i = 0; i < slotCount; ++i) {
+            if (ctrl[i] != CTRL_EMPTY) {
+                slots[i].~Slot();
+            }
+        }
+    }
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator::init(FlatHashMap* container) {
+    self        = container;
+    currentSlot = 0;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+typename FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator&
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator::begin(void) {
+    currentSlot = 0;
+
+    while (currentSlot < self->slotCount && self->ctrl[currentSlot] == CTRL_EMPTY) {
+        currentSlot++;
+    }
+
+    return *this;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+typename FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator::end(void) {
+    Iterator it;
+    it.self        = self;
+    it.currentSlot = self->slotCount;
+    return it;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+typename FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator&
+FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator::next(void) {
+    if (currentSlot >= self->slotCount) {
+        return *this;
+    }
+
+    do {
+        currentSlot++;
+    } while (currentSlot < self->slotCount && self->ctrl[currentSlot] == CTRL_EMPTY);
+
+    return *this;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+KeyType* FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator::key(void) {
+    return currentSlot < self->slotCount ? &self->slots[currentSlot].key : nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+ValueType* FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::Iterator::value(void) {
+    return currentSlot < self->slotCount ? &self->slots[currentSlot].value : nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::add(const KeyType& key, const ValueType& value) {
+    return _assign(key, value);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::add(KeyType&& key, ValueType&& value) {
+    return _assign(std::move(key), std::move(value));
+}
+
+/**
+ * Constructs the value in place from args when key is missing. Unlike add, an existing
+ * value is not overwritten (and args are left unused).
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+template< class... Args >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::emplace(const KeyType& key, Args&&... args) {
+    uint64 hash = Hasher()(key);
+    uint32 idx  = _findSlot(key, hash);
+
+    if (idx != NOT_FOUND) {
+        return slots[idx].value;
+    }
+
+    return _emplaceNew(hash, key, std::forward< Args >(args)...);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+template< class KeyArg, class ValueArg >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_assign(KeyArg&& key, ValueArg&& value) {
+    uint64 hash = Hasher()(key);
+    uint32 idx  = _findSlot(key, hash);
+
+    if (idx != NOT_FOUND) {
+        slots[idx].value = std::forward< ValueArg >(value);
+        return slots[idx].value;
+    }
+
+    return _emplaceNew(hash, std::forward< KeyArg >(key), std::forward< ValueArg >(value));
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+template< class KeyArg, class... Args >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::_emplaceNew(uint64 hash, KeyArg&& key, Args&&... args) {
+    /** Keep at least 1/8 of the slots empty so every probe sequence ends. */
+    if ((entryCount + 1) * 8 > slotCount * 7) {
+        _rehash(slotCount * 2);
+    }
+
+    uint32 idx = _findEmptySlot(hash);
+    new (&slots[idx]) Slot{std::forward< KeyArg >(key), ValueType(std::forward< Args >(args)...)};
+    _setCtrl(idx, (uint8) _tag(hash));
+    entryCount++;
+
+    return slots[idx].value;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+bool FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::exists(const KeyType& key) const {
+    return _findSlot(key, Hasher()(key)) != NOT_FOUND;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+ValueType* FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::find(const KeyType& key) {
+    uint32 idx = _findSlot(key, Hasher()(key));
+    return idx != NOT_FOUND ? &slots[idx].value : nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+const ValueType* FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::find(const KeyType& key) const {
+    uint32 idx = _findSlot(key, Hasher()(key));
+    return idx != NOT_FOUND ? &slots[idx].value : nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::at(const KeyType& key) {
+    ValueType* value = find(key);
+
+    if (value != nullptr) {
+        return *value;
+    }
+
+    static ValueType dummy;
+    return dummy;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+const ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::at(const KeyType& key) const {
+    const ValueType* value = find(key);
+
+    if (value != nullptr) {
+        return *value;
+    }
+
+    static ValueType dummy;
+    return dummy;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::getValue(const KeyType& key) {
+    return at(key);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+const ValueType& FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::getValue(const KeyType& key) const {
+    return at(key);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+uint32 FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::length(void) const {
+    return entryCount;
+}
+
+/**
+ * Backward shift deletion: every following entry of the cluster that may legally sit in the hole
+ * (its home slot is not between the hole and itself) moves back, until an empty slot is found.
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+bool FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::remove(const KeyType& key) {
+    uint32 hole = _findSlot(key, Hasher()(key));
+
+    if (hole == NOT_FOUND) {
+        return false;
+    }
+
+    uint32 mask = slotCount - 1;
+    slots[hole].~Slot();
+
+    for (uint32 idx = (hole + 1) & mask; ctrl[idx] != CTRL_EMPTY; idx = (idx + 1) & mask) {
+        uint32 home = _home(Hasher()(slots[idx].key), mask);
+
+        if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+            new (&slots[hole]) Slot(std::move(slots[idx]));
+            _setCtrl(hole, ctrl[idx]);
+            slots[idx].~Slot();
+            hole = idx;
+        }
+    }
+
+    _setCtrl(hole, CTRL_EMPTY);
+    entryCount--;
+
+    return true;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::clear(void) {
+    _destroyAll();
+    ::memset(ctrl, CTRL_EMPTY, slotCount + GROUP_WIDTH - 1);
+    entryCount = 0;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY, class Hasher >
+void FlatHashMap< KeyType, ValueType, CAPACITY, Hasher >::reserve(uint32 nbItems) {
+    uint32 nbSlots = _roundSlotCount(nbItems + nbItems / 7 + 1);
+
+    if (nbSlots > slotCount) {
+        _rehash(nbSlots);
+    }
+}
+
+#endif // flat_hash_map_hpp
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef hash_hpp
+#define hash_hpp
+
+#include "common.hpp"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * 64x64 -> 128 bit multiply folded back to 64 bits, the mixing step of wyhash.
+ */
+inline uint64 hashMix(uint64 lhs, uint64 rhs) {
+    __uint128_t product = (__uint128_t) lhs * rhs;
+    return (uint64) product ^ (uint64)(product >> 64);
+}
+
+inline uint64 _hashRead8(const uint8* ptr) {
+    uint64 value;
+    ::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline uint64 _hashRead4(const uint8* ptr) {
+    uint32 value;
+    ::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+inline uint64 _hashRead3(const uint8* ptr, ulong length) {
+    return ((uint64) ptr[0] << 16) | ((uint64) ptr[length >> 1] << 8) | ptr[length - 1];
+}
+
+/**
+ * wyhash (final version, public domain, https://github.com/wangyi-fudan/wyhash).
+ * Fast on short keys such as header names and session ids, and passes SMHasher.
+ */
+inline uint64 wyhash(const void* data, ulong length, uint64 seed = 0) {
+    static const uint64 secret[4] = {
+        0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+    };
+
+    const uint8* ptr = (const uint8*) data;
+    uint64       a;
+    uint64       b;
+
+    seed ^= hashMix(seed ^ secret[0], secret[1]);
+
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (_hashRead4(ptr) << 32) | _hashRead4(ptr + ((length >> 3) << 2));
+            b = (_hashRead4(ptr + length - 4) << 32) | _hashRead4(ptr + length - 4 - ((length >> 3) << 2));
+        } else if (length > 0) {
+            a = _hashRead3(ptr, length);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        ulong remaining = length;
+
+        if (remaining >= 48) {
+            uint64 seed1 = seed;
+            uint64 seed2 = seed;
+
+            do {
+                seed  = hashMix(_hashRead8(ptr)      ^ secret[1], _hashRead8(ptr + 8)  ^ seed);
+                seed1 = hashMix(_hashRead8(ptr + 16) ^ secret[2], _hashRead8(ptr + 24) ^ seed1);
+                seed2 = hashMix(_hashRead8(ptr + 32) ^ secret[3], _hashRead8(ptr + 40) ^ seed2);
+                ptr       += 48;
+                remaining -= 48;
+            } while (remaining >= 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16) {
+            seed = hashMix(_hashRead8(ptr) ^ secret[1], _hashRead8(ptr + 8) ^ seed);
+            ptr       += 16;
+            remaining -= 16;
+        }
+
+        a = _hashRead8(ptr + remaining - 16);
+        b = _hashRead8(ptr + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+
+    __uint128_t product = (__uint128_t) a * b;
+    a = (uint64) product;
+    b = (uint64)(product >> 64);
+
+    return hashMix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+/**
+ * Hash - Default hasher of the hash based containers.
+ *
+ * Specialize it (operator () returning uint64) to use a custom key type. The whole 64 bits are
+ * expected to be well mixed: open addressing tables take both the low and the high bits.
+ */
+template< class KeyType, class Enable = void >
+struct Hash;
+
+template< class KeyType >
+struct Hash< KeyType, std::enable_if_t< std::is_integral_v< KeyType > || std::is_enum_v< KeyType > || std::is_pointer_v< KeyType > > > {
+    uint64 operator () (const KeyType& key) const {
+        uint64 bits = 0;
+        ::memcpy(&bits, &key, sizeof(KeyType));
+        return hashMix(bits ^ 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull);
+    }
+};
+
+template<>
+struct Hash< std::string > {
+    uint64 operator () (const std::string& key) const {
+        return wyhash(key.data(), key.size());
+    }
+};
+
+template<>
+struct Hash< std::string_view > {
+    uint64 operator () (std::string_view key) const {
+        return wyhash(key.data(), key.size());
+    }
+};
+
+#endif // hash_hpp
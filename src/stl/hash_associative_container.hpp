@@ -6,35 +6,57 @@
 #define hash_associative_container_hpp
 
 #include "common.hpp"
+#include "./hash.hpp"
 #include "./pool_allocator.hpp"
 
+#include <new>
+#include <type_traits>
+#include <utility>
+
 /**
- * HashAssociativeContainer - A hash-based map data structure with fixed capacity.
+ * HashAssociativeContainer - A hash-based map data structure that grows on demand.
  * 
- * This container stores key-value pairs using hash table with separate chaining.
+ * Entries live in one dense array, in insertion order; the hash table only stores indices into
+ * it and chains collisions through Entry::next. getKeyAt/getValueAt are O(1) and iterating is a
+ * linear scan. remove() moves the last entry into the freed position (swap-remove), so the
+ * array stays compact and the relative order of the remaining entries changes only there.
  * Uses PoolAllocator for efficient memory management.
  * Current complexity: O(1) average for lookups, O(n) worst case for hash collisions.
- * Better performance than linear search-based containers for large datasets.
+ *
+ * CAPACITY is the initial bucket count (rounded up to a power of two). Once the load factor
+ * reaches 1 a table twice as big is allocated and the buckets are migrated incrementally,
+ * REHASH_STEP buckets per add/remove, so no single operation pays for the whole resize.
+ * While migrating, lookups check both tables. Keys are hashed with Hash<KeyType>.
+ *
+ * Moving a container steals its storage; the moved-from container may only be destroyed or
+ * assigned to.
  */
 template< class KeyType, class ValueType, uint32 CAPACITY = 128 >
 struct HashAssociativeContainer {
-    
+    enum { REHASH_STEP = 4, MAX_EMPTY_VISITS = REHASH_STEP * 10 };
+
+    static constexpr uint32 NO_ENTRY = 0xFFFFFFFFu;
+
     struct Entry {
-        KeyType*    key;
-        ValueType*  value;
-        Entry*      next;
+        KeyType     key;
+        ValueType   value;
+        uint64      hash;
+        uint32      next;
     };
     
-    Entry**           table;
+    Entry*            entries;
     uint32            entryCount;
+    uint32            entryCapacity;
+    uint32*           table;
     uint32            bucketCount;
-    uint32            capacity;
+    uint32*           oldTable;
+    uint32            oldBucketCount;
+    uint32            rehashIdx;
     PoolAllocator*    allocator;
 
     struct Iterator {
         HashAssociativeContainer* self;
-        uint32                    currentBucket;
-        Entry*                    currentEntry;
+        uint32                    currentIdx;
 
         void                  init(HashAssociativeContainer* container);
         Iterator&             begin(void);
@@ -46,9 +68,16 @@ struct HashAssociativeContainer {
 
     HashAssociativeContainer();
     HashAssociativeContainer(PoolAllocator* poolAlloc);
+    HashAssociativeContainer(const HashAssociativeContainer&) = delete;
+    HashAssociativeContainer(HashAssociativeContainer&& other);
+    HashAssociativeContainer& operator = (const HashAssociativeContainer&) = delete;
+    HashAssociativeContainer& operator = (HashAssociativeContainer&& other);
     ~HashAssociativeContainer();
 
     ValueType& add(const KeyType& key, const ValueType& value);
+    ValueType& add(KeyType&& key, ValueType&& value);
+    template< class... Args >
+    ValueType& emplace(const KeyType& key, Args&&... args);
 
     /** Query family functions... */
     bool             exists(const KeyType& key) const;
@@ -62,101 +91,319 @@ struct HashAssociativeContainer {
     ValueType&       getValueAt(uint32 idx);
     KeyType&         end(void);
     uint32           length(void) const;
+    bool             isRehashing(void) const;
     
     /** Modify family functions... */
     bool             remove(const KeyType& key);
     void             clear(void);
 
 private:
-    Entry*            _findEntry(const KeyType& key) const;
-    uint32            _hash(const KeyType& key) const;
-    void              _deleteChain(Entry* entry);
+    static uint32     _roundBucketCount(uint32 nbBuckets);
+
+    uint32            _findEntry(const KeyType& key) const;
+    uint32            _findEntry(const KeyType& key, uint64 hash) const;
+    uint32            _findEntryIn(const uint32* buckets, uint32 nbBuckets, const KeyType& key, uint64 hash) const;
+    uint64            _hash(const KeyType& key) const;
+    uint32*           _linkOf(uint32 entryIdx);
+    void*             _allocate(uint32 bytes, uint32 alignment);
+    void              _release(void* ptr, uint32 alignment);
+    uint32*           _allocateTable(uint32 nbBuckets);
+    void              _growEntries(void);
+    void              _startRehash(void);
+    void              _rehashStep(void);
+    void              _destroyEntries(void);
+    void              _releaseAll(void);
+    void              _steal(HashAssociativeContainer& other);
+    template< class KeyArg, class ValueArg >
+    ValueType&        _assign(KeyArg&& key, ValueArg&& value);
+    template< class KeyArg, class... Args >
+    ValueType&        _emplaceNew(uint64 hash, KeyArg&& key, Args&&... args);
 };
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::HashAssociativeContainer()
-    : entryCount(0), bucketCount(CAPACITY), capacity(CAPACITY), allocator(nullptr) {
-    table = new Entry*[CAPACITY]();
-    for (uint32 i = 0; i < CAPACITY; ++i) {
-        table[i] = nullptr;
-    }
+    : entries(nullptr), entryCount(0), entryCapacity(0), bucketCount(_roundBucketCount(CAPACITY)),
+      oldTable(nullptr), oldBucketCount(0), rehashIdx(0), allocator(nullptr) {
+    table = _allocateTable(bucketCount);
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::HashAssociativeContainer(PoolAllocator* poolAlloc)
-    : entryCount(0), bucketCount(CAPACITY), capacity(CAPACITY), allocator(poolAlloc) {
-    if (allocator != nullptr) {
-        table = (Entry**)allocator->alloc(CAPACITY * sizeof(Entry*));
-    } else {
-        table = new Entry*[CAPACITY]();
-    }
-    for (uint32 i = 0; i < CAPACITY; ++i) {
-        table[i] = nullptr;
+    : entries(nullptr), entryCount(0), entryCapacity(0), bucketCount(_roundBucketCount(CAPACITY)),
+      oldTable(nullptr), oldBucketCount(0), rehashIdx(0), allocator(poolAlloc) {
+    table = _allocateTable(bucketCount);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+HashAssociativeContainer< KeyType, ValueType, CAPACITY >::HashAssociativeContainer(HashAssociativeContainer&& other) {
+    _steal(other);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+HashAssociativeContainer< KeyType, ValueType, CAPACITY >& 
+HashAssociativeContainer< KeyType, ValueType, CAPACITY >::operator = (HashAssociativeContainer&& other) {
+    if (this != &other) {
+        _releaseAll();
+        _steal(other);
     }
+    return *this;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::~HashAssociativeContainer() {
-    clear();
+    _releaseAll();
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_releaseAll(void) {
+    if (table != nullptr) {
+        clear();
+    }
+    _release(entries, alignof(Entry));
+    _release(table, alignof(uint32));
+    entries = nullptr;
+    table   = nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_steal(HashAssociativeContainer& other) {
+    entries        = other.entries;
+    entryCount     = other.entryCount;
+    entryCapacity  = other.entryCapacity;
+    table          = other.table;
+    bucketCount    = other.bucketCount;
+    oldTable       = other.oldTable;
+    oldBucketCount = other.oldBucketCount;
+    rehashIdx      = other.rehashIdx;
+    allocator      = other.allocator;
+
+    other.entries        = nullptr;
+    other.entryCount     = 0;
+    other.entryCapacity  = 0;
+    other.table          = nullptr;
+    other.bucketCount    = 0;
+    other.oldTable       = nullptr;
+    other.oldBucketCount = 0;
+    other.rehashIdx      = 0;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+uint32 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_roundBucketCount(uint32 nbBuckets) {
+    uint32 rounded = 1;
+    while (rounded < nbBuckets) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void* HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_allocate(uint32 bytes, uint32 alignment) {
     if (allocator != nullptr) {
-        allocator->dealloc(table);
-    } else {
-        delete[] table;
+        void* ptr = allocator->allocAligned(bytes, alignment);
+        SA_ASSERT(ptr != nullptr, "Pool exhausted!");
+        if (ptr == nullptr) throw std::bad_alloc();
+        return ptr;
     }
-    table = nullptr;
+
+    return ::operator new(bytes, std::align_val_t(alignment));
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
-uint32 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_hash(const KeyType& key) const {
-    // Simple hash function for integer types
-    // For custom types, specialize this function
-    if constexpr (std::is_integral_v<KeyType>) {
-        return (static_cast<uint32>(key) * 2654435761U) % bucketCount;
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_release(void* ptr, uint32 alignment) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    if (allocator != nullptr) {
+        allocator->dealloc(ptr);
     } else {
-        // Fallback for non-integral types
-        // This is a basic implementation - can be optimized
-        return 0;
+        ::operator delete(ptr, std::align_val_t(alignment));
+    }
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+uint32* HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_allocateTable(uint32 nbBuckets) {
+    uint32* buckets = (uint32*) _allocate(nbBuckets * sizeof(uint32), alignof(uint32));
+
+    for (uint32 i = 0; i < nbBuckets; ++i) {
+        buckets[i] = NO_ENTRY;
+    }
+
+    return buckets;
+}
+
+/**
+ * Doubles the dense array. Trivially copyable entries of a pooled container first try to grow
+ * the block in place, which succeeds whenever the following arena block is free.
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_growEntries(void) {
+    uint32 newCapacity = entryCapacity == 0 ? _roundBucketCount(CAPACITY) : entryCapacity * 2;
+
+    if constexpr (std::is_trivially_copyable_v< Entry >) {
+        if (allocator != nullptr && allocator->tryResizeInPlace(entries, newCapacity * sizeof(Entry))) {
+            entryCapacity = newCapacity;
+            return;
+        }
+    }
+
+    Entry* grown = (Entry*) _allocate(newCapacity * sizeof(Entry), alignof(Entry));
+
+    for (uint32 i = 0; i < entryCount; ++i) {
+        new (&grown[i]) Entry(std::move(entries[i]));
+        entries[i].~Entry();
+    }
+
+    _release(entries, alignof(Entry));
+    entries       = grown;
+    entryCapacity = newCapacity;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+uint64 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_hash(const KeyType& key) const {
+    // Specialize Hash<KeyType> for custom key types
+    return Hash< KeyType >()(key);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+bool HashAssociativeContainer< KeyType, ValueType, CAPACITY >::isRehashing(void) const {
+    return oldTable != nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_startRehash(void) {
+    oldTable       = table;
+    oldBucketCount = bucketCount;
+    rehashIdx      = 0;
+
+    bucketCount = bucketCount * 2;
+    table       = _allocateTable(bucketCount);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_rehashStep(void) {
+    if (!isRehashing()) {
+        return;
+    }
+
+    uint32 migrated    = 0;
+    uint32 emptyVisits = 0;
+
+    while (migrated < REHASH_STEP && emptyVisits < MAX_EMPTY_VISITS && rehashIdx < oldBucketCount) {
+        uint32 entryIdx = oldTable[rehashIdx];
+
+        if (entryIdx == NO_ENTRY) {
+            emptyVisits++;
+            rehashIdx++;
+            continue;
+        }
+
+        while (entryIdx != NO_ENTRY) {
+            Entry& entry   = entries[entryIdx];
+            uint32 next    = entry.next;
+            uint32 hashIdx = (uint32)(entry.hash & (bucketCount - 1));
+
+            entry.next     = table[hashIdx];
+            table[hashIdx] = entryIdx;
+            entryIdx       = next;
+        }
+
+        oldTable[rehashIdx] = NO_ENTRY;
+        rehashIdx++;
+        migrated++;
+    }
+
+    if (rehashIdx >= oldBucketCount) {
+        _release(oldTable, alignof(uint32));
+        oldTable       = nullptr;
+        oldBucketCount = 0;
+        rehashIdx      = 0;
     }
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
-typename HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Entry*
-HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_findEntry(const KeyType& key) const {
-    uint32 hashIdx = _hash(key);
-    Entry* entry = table[hashIdx];
+uint32 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_findEntryIn(const uint32* buckets, uint32 nbBuckets, const KeyType& key, uint64 hash) const {
+    uint32 entryIdx = buckets[hash & (nbBuckets - 1)];
     
-    while (entry != nullptr) {
-        if (*(entry->key) == key) {
-            return entry;
+    while (entryIdx != NO_ENTRY) {
+        const Entry& entry = entries[entryIdx];
+        if (entry.hash == hash && entry.key == key) {
+            return entryIdx;
         }
-        entry = entry->next;
+        entryIdx = entry.next;
     }
     
-    return nullptr;
+    return NO_ENTRY;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+uint32 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_findEntry(const KeyType& key) const {
+    return _findEntry(key, _hash(key));
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+uint32 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_findEntry(const KeyType& key, uint64 hash) const {
+    uint32 entryIdx = _findEntryIn(table, bucketCount, key, hash);
+
+    if (entryIdx == NO_ENTRY && isRehashing()) {
+        entryIdx = _findEntryIn(oldTable, oldBucketCount, key, hash);
+    }
+
+    return entryIdx;
+}
+
+/**
+ * The link (bucket head or previous Entry::next) that currently points at entryIdx.
+ * While migrating, an entry whose old bucket is not moved yet may still sit in the old table,
+ * unless it was added after the rehash started; so the old chain is tried first.
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY >
+uint32* HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_linkOf(uint32 entryIdx) {
+    uint64 hash = entries[entryIdx].hash;
+
+    if (isRehashing()) {
+        uint32 oldIdx = (uint32)(hash & (oldBucketCount - 1));
+
+        if (oldIdx >= rehashIdx) {
+            uint32* link = &oldTable[oldIdx];
+            while (*link != NO_ENTRY) {
+                if (*link == entryIdx) {
+                    return link;
+                }
+                link = &entries[*link].next;
+            }
+        }
+    }
+
+    uint32* link = &table[hash & (bucketCount - 1)];
+    while (*link != entryIdx) {
+        SA_ASSERT(*link != NO_ENTRY, "Entry not linked!");
+        link = &entries[*link].next;
+    }
+
+    return link;
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_destroyEntries(void) {
+    if constexpr (!std::is_trivially_destructible_v< Entry >) {
+        for (uint32 i = 0; i < entryCount; ++i) {
+            entries[i].~Entry();
+        }
+    }
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::init(
     HashAssociativeContainer< KeyType, ValueType, CAPACITY >* container) {
     self = container;
-    currentBucket = 0;
-    currentEntry = nullptr;
+    currentIdx = 0;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator&
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::begin(void) {
-    currentBucket = 0;
-    currentEntry = nullptr;
-    
-    for (uint32 i = 0; i < self->bucketCount; ++i) {
-        if (self->table[i] != nullptr) {
-            currentBucket = i;
-            currentEntry = self->table[i];
-            return *this;
-        }
-    }
-    
+    currentIdx = 0;
     return *this;
 }
 
@@ -165,8 +412,7 @@ HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::end(void) {
     Iterator it;
     it.self = self;
-    it.currentBucket = self->bucketCount;
-    it.currentEntry = nullptr;
+    it.currentIdx = self->entryCount;
     
     return it;
 }
@@ -174,116 +420,102 @@ HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::end(void) {
 template< class KeyType, class ValueType, uint32 CAPACITY >
 typename HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator&
 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::next(void) {
-    if (currentEntry == nullptr) {
-        return *this;
-    }
-    
-    if (currentEntry->next != nullptr) {
-        currentEntry = currentEntry->next;
-        return *this;
+    if (currentIdx < self->entryCount) {
+        currentIdx++;
     }
-    
-    currentBucket++;
-    currentEntry = nullptr;
-    
-    for (uint32 i = currentBucket; i < self->bucketCount; ++i) {
-        if (self->table[i] != nullptr) {
-            currentBucket = i;
-            currentEntry = self->table[i];
-            return *this;
-        }
-    }
-    
-    currentBucket = self->bucketCount;
     return *this;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 KeyType* HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::key(void) {
-    return currentEntry != nullptr ? currentEntry->key : nullptr;
+    return currentIdx < self->entryCount ? &self->entries[currentIdx].key : nullptr;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 ValueType* HashAssociativeContainer< KeyType, ValueType, CAPACITY >::Iterator::value(void) {
-    return currentEntry != nullptr ? currentEntry->value : nullptr;
+    return currentIdx < self->entryCount ? &self->entries[currentIdx].value : nullptr;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::add(
     const KeyType& key, const ValueType& value) {
-    
-    Entry* entry = _findEntry(key);
-    
-    if (entry != nullptr) {
-        *(entry->value) = value;
-        return *(entry->value);
-    }
-    
-    // Create new entry
-    if (entryCount >= capacity) {
-        /**
-         * @todo: Capacity exceeded - return reference to prevent crash.
-         * Cosider resize or error handling for production.
-         */
-        static ValueType dummy;
-        return dummy;
-    }
-    
-    Entry* newEntry;
-    if (allocator != nullptr) {
-        newEntry = (Entry*)allocator->alloc(sizeof(Entry));
-    } else {
-        newEntry = new Entry();
+    return _assign(key, value);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::add(KeyType&& key, ValueType&& value) {
+    return _assign(std::move(key), std::move(value));
+}
+
+/**
+ * Constructs the value in place from args when key is missing. Unlike add, an existing
+ * value is not overwritten (and args are left unused).
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY >
+template< class... Args >
+ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::emplace(const KeyType& key, Args&&... args) {
+    _rehashStep();
+
+    uint64 hash     = _hash(key);
+    uint32 entryIdx = _findEntry(key, hash);
+
+    if (entryIdx != NO_ENTRY) {
+        return entries[entryIdx].value;
     }
+
+    return _emplaceNew(hash, key, std::forward< Args >(args)...);
+}
+
+template< class KeyType, class ValueType, uint32 CAPACITY >
+template< class KeyArg, class ValueArg >
+ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_assign(KeyArg&& key, ValueArg&& value) {
+    _rehashStep();
+
+    uint64 hash     = _hash(key);
+    uint32 entryIdx = _findEntry(key, hash);
     
-    if (newEntry == nullptr) {
-        static ValueType dummy;
-        return dummy;
+    if (entryIdx != NO_ENTRY) {
+        entries[entryIdx].value = std::forward< ValueArg >(value);
+        return entries[entryIdx].value;
     }
-    
-    if (allocator != nullptr) {
-        newEntry->key = (KeyType*)allocator->alloc(sizeof(KeyType));
-        newEntry->value = (ValueType*)allocator->alloc(sizeof(ValueType));
-    } else {
-        newEntry->key = new KeyType();
-        newEntry->value = new ValueType();
+
+    return _emplaceNew(hash, std::forward< KeyArg >(key), std::forward< ValueArg >(value));
+}
+
+/**
+ * Appends the entry of a key known to be missing, value built in place from args.
+ */
+template< class KeyType, class ValueType, uint32 CAPACITY >
+template< class KeyArg, class... Args >
+ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_emplaceNew(uint64 hash, KeyArg&& key, Args&&... args) {
+    if (!isRehashing() && entryCount + 1 > bucketCount) {
+        _startRehash();
+        _rehashStep();
     }
-    
-    if (newEntry->key == nullptr || newEntry->value == nullptr) {
-        static ValueType dummy;
-        return dummy;
+
+    if (entryCount == entryCapacity) {
+        _growEntries();
     }
     
-    new (newEntry->key) KeyType(key);
-    new (newEntry->value) ValueType(value);
-    
-    uint32 hashIdx = _hash(key);
-    
-    newEntry->next = table[hashIdx];
-    table[hashIdx] = newEntry;
+    uint32 hashIdx  = (uint32)(hash & (bucketCount - 1));
+    uint32 entryIdx = entryCount;
+
+    new (&entries[entryIdx]) Entry{std::forward< KeyArg >(key), ValueType(std::forward< Args >(args)...), hash, table[hashIdx]};
+    table[hashIdx] = entryIdx;
     entryCount++;
     
-    return *(newEntry->value);
+    return entries[entryIdx].value;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 bool HashAssociativeContainer< KeyType, ValueType, CAPACITY >::exists(const KeyType& key) const {
-    return _findEntry(key) != nullptr;
+    return _findEntry(key) != NO_ENTRY;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 KeyType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getKeyAt(uint32 idx) {
-    uint32 count = 0;
-    
-    for (uint32 i = 0; i < bucketCount; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            if (count == idx) {
-                return *(entry->key);
-            }
-            count++;
-            entry = entry->next;
-        }
+    if (idx < entryCount) {
+        return entries[idx].key;
     }
     
     static KeyType dummy;
@@ -292,17 +524,8 @@ KeyType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getKeyAt(uint
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 const KeyType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getKeyAt(uint32 idx) const {
-    uint32 count = 0;
-    
-    for (uint32 i = 0; i < bucketCount; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            if (count == idx) {
-                return *(entry->key);
-            }
-            count++;
-            entry = entry->next;
-        }
+    if (idx < entryCount) {
+        return entries[idx].key;
     }
     
     static KeyType dummy;
@@ -311,10 +534,10 @@ const KeyType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getKeyA
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::at(const KeyType& key) {
-    Entry* entry = _findEntry(key);
+    uint32 entryIdx = _findEntry(key);
     
-    if (entry != nullptr) {
-        return *(entry->value);
+    if (entryIdx != NO_ENTRY) {
+        return entries[entryIdx].value;
     }
     
     static ValueType dummy;
@@ -323,10 +546,10 @@ ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::at(const Ke
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 const ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::at(const KeyType& key) const {
-    Entry* entry = _findEntry(key);
+    uint32 entryIdx = _findEntry(key);
     
-    if (entry != nullptr) {
-        return *(entry->value);
+    if (entryIdx != NO_ENTRY) {
+        return entries[entryIdx].value;
     }
     
     static ValueType dummy;
@@ -345,17 +568,8 @@ const ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getVa
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 const ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getValueAt(uint32 idx) const {
-    uint32 count = 0;
-    
-    for (uint32 i = 0; i < bucketCount; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            if (count == idx) {
-                return *(entry->value);
-            }
-            count++;
-            entry = entry->next;
-        }
+    if (idx < entryCount) {
+        return entries[idx].value;
     }
     
     static ValueType dummy;
@@ -364,17 +578,8 @@ const ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getVa
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 ValueType& HashAssociativeContainer< KeyType, ValueType, CAPACITY >::getValueAt(uint32 idx) {
-    uint32 count = 0;
-    
-    for (uint32 i = 0; i < bucketCount; ++i) {
-        Entry* entry = table[i];
-        while (entry != nullptr) {
-            if (count == idx) {
-                return *(entry->value);
-            }
-            count++;
-            entry = entry->next;
-        }
+    if (idx < entryCount) {
+        return entries[idx].value;
     }
     
     static ValueType dummy;
@@ -394,73 +599,44 @@ uint32 HashAssociativeContainer< KeyType, ValueType, CAPACITY >::length(void) co
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 bool HashAssociativeContainer< KeyType, ValueType, CAPACITY >::remove(const KeyType& key) {
-    uint32 hashIdx = _hash(key);
-    Entry* entry = table[hashIdx];
-    Entry* prev = nullptr;
-    
-    while (entry != nullptr) {
-        if (*(entry->key) == key) {
-            if (prev != nullptr) {
-                prev->next = entry->next;
-            } else {
-                table[hashIdx] = entry->next;
-            }
-            
-            entry->key->~KeyType();
-            entry->value->~ValueType();
-            
-            if (allocator != nullptr) {
-                allocator->dealloc(entry->key);
-                allocator->dealloc(entry->value);
-                allocator->dealloc(entry);
-            } else {
-                delete entry->key;
-                delete entry->value;
-                delete entry;
-            }
-            
-            entryCount--;
-            return true;
-        }
-        
-        prev = entry;
-        entry = entry->next;
+    _rehashStep();
+
+    uint32 entryIdx = _findEntry(key);
+
+    if (entryIdx == NO_ENTRY) {
+        return false;
     }
-    
-    return false;
-}
-
-template< class KeyType, class ValueType, uint32 CAPACITY >
-void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::_deleteChain(Entry* entry) {
-    while (entry != nullptr) {
-        Entry* next = entry->next;
-        
-        entry->key->~KeyType();
-        entry->value->~ValueType();
-        
-        if (allocator != nullptr) {
-            allocator->dealloc(entry->key);
-            allocator->dealloc(entry->value);
-            allocator->dealloc(entry);
-        } else {
-            delete entry->key;
-            delete entry->value;
-            delete entry;
-        }
-        
-        entry = next;
+
+    *_linkOf(entryIdx) = entries[entryIdx].next;
+    entries[entryIdx].~Entry();
+
+    uint32 lastIdx = entryCount - 1;
+
+    if (entryIdx != lastIdx) {
+        *_linkOf(lastIdx) = entryIdx;
+        new (&entries[entryIdx]) Entry(std::move(entries[lastIdx]));
+        entries[lastIdx].~Entry();
     }
+
+    entryCount--;
+    return true;
 }
 
 template< class KeyType, class ValueType, uint32 CAPACITY >
 void HashAssociativeContainer< KeyType, ValueType, CAPACITY >::clear(void) {
+    _destroyEntries();
+    entryCount = 0;
+
     for (uint32 i = 0; i < bucketCount; ++i) {
-        if (table[i] != nullptr) {
-            _deleteChain(table[i]);
-            table[i] = nullptr;
-        }
+        table[i] = NO_ENTRY;
+    }
+
+    if (isRehashing()) {
+        _release(oldTable, alignof(uint32));
+        oldTable       = nullptr;
+        oldBucketCount = 0;
+        rehashIdx      = 0;
     }
-    entryCount = 0;
 }
 
 #endif // hash_associative_container_hpp
@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef inline_string_hpp
+#define inline_string_hpp
+
+#include "common.hpp"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * InlineString - Fixed capacity string stored in place, never on the heap (header names,
+ * methods, versions...).
+ *
+ * Holds up to CAPACITY bytes plus a terminating NUL so c_str() is free. assign/append refuse
+ * input that does not fit and return false, leaving the string unchanged; the constructors
+ * assert on it and truncate in release builds, so check fits() first for untrusted input.
+ */
+template< uint32 CAPACITY = 64 >
+struct InlineString {
+    static_assert(CAPACITY > 0 && CAPACITY < 0xFFFF, "InlineString capacity must fit in 16 bits");
+
+    InlineString();
+    InlineString(const char* text);
+    InlineString(const char* text, ulong length);
+    InlineString(std::string_view text);
+    InlineString(const std::string& text);
+
+    static constexpr bool fits(std::string_view text) { return text.size() <= CAPACITY; }
+
+    const char*       c_str(void) const;
+    const char*       data(void) const;
+    uint32            length(void) const;
+    uint32            capacity(void) const;
+    bool              isEmpty(void) const;
+    std::string_view  view(void) const;
+    operator          std::string_view(void) const;
+    char              operator [] (uint32 idx) const;
+
+    bool              assign(std::string_view text);
+    bool              append(std::string_view text);
+    bool              append(char ch);
+    void              toLower(void);
+    void              clear(void);
+
+    bool              operator == (const InlineString& rhs) const;
+    bool              operator != (const InlineString& rhs) const;
+    bool              operator == (std::string_view rhs) const;
+    bool              operator != (std::string_view rhs) const;
+    bool              operator == (const char* rhs) const;
+    bool              operator != (const char* rhs) const;
+    bool              operator == (const std::string& rhs) const;
+    bool              operator != (const std::string& rhs) const;
+    bool              operator <  (const InlineString& rhs) const;
+
+    uint32            size = 0;
+    char              chars[CAPACITY + 1];
+};
+
+template< uint32 CAPACITY >
+InlineString< CAPACITY >::InlineString() {
+    chars[0] = '\0';
+}
+
+template< uint32 CAPACITY >
+InlineString< CAPACITY >::InlineString(const char* text) : InlineString(std::string_view(text)) {}
+
+template< uint32 CAPACITY >
+InlineString< CAPACITY >::InlineString(const char* text, ulong length) : InlineString(std::string_view(text, length)) {}
+
+template< uint32 CAPACITY >
+InlineString< CAPACITY >::InlineString(const std::string& text) : InlineString(std::string_view(text)) {}
+
+template< uint32 CAPACITY >
+InlineString< CAPACITY >::InlineString(std::string_view text) {
+    SA_ASSERT(fits(text), "InlineString capacity exceeded!");
+
+    size = text.size() < CAPACITY ? (uint32) text.size() : CAPACITY;
+    ::memcpy(chars, text.data(), size);
+    chars[size] = '\0';
+}
+
+template< uint32 CAPACITY >
+const char* InlineString< CAPACITY >::c_str(void) const {
+    return chars;
+}
+
+template< uint32 CAPACITY >
+const char* InlineString< CAPACITY >::data(void) const {
+    return chars;
+}
+
+template< uint32 CAPACITY >
+uint32 InlineString< CAPACITY >::length(void) const {
+    return size;
+}
+
+template< uint32 CAPACITY >
+uint32 InlineString< CAPACITY >::capacity(void) const {
+    return CAPACITY;
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::isEmpty(void) const {
+    return size == 0;
+}
+
+template< uint32 CAPACITY >
+std::string_view InlineString< CAPACITY >::view(void) const {
+    return std::string_view(chars, size);
+}
+
+template< uint32 CAPACITY >
+InlineString< CAPACITY >::operator std::string_view(void) const {
+    return view();
+}
+
+template< uint32 CAPACITY >
+char InlineString< CAPACITY >::operator [] (uint32 idx) const {
+    SA_ASSERT(idx < size, "Index out of bounds!");
+    return chars[idx];
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::assign(std::string_view text) {
+    if (!fits(text)) {
+        return false;
+    }
+
+    ::memmove(chars, text.data(), text.size());
+    size        = (uint32) text.size();
+    chars[size] = '\0';
+    return true;
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::append(std::string_view text) {
+    if (text.size() > CAPACITY - size) {
+        return false;
+    }
+
+    ::memmove(chars + size, text.data(), text.size());
+    size       += (uint32) text.size();
+    chars[size] = '\0';
+    return true;
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::append(char ch) {
+    if (size == CAPACITY) {
+        return false;
+    }
+
+    chars[size++] = ch;
+    chars[size]   = '\0';
+    return true;
+}
+
+/** ASCII only, which is all HTTP tokens may contain. */
+template< uint32 CAPACITY >
+void InlineString< CAPACITY >::toLower(void) {
+    for (uint32 idx = 0; idx < size; idx++) {
+        chars[idx] |= (chars[idx] >= 'A' && chars[idx] <= 'Z') ? 0x20 : 0;
+    }
+}
+
+template< uint32 CAPACITY >
+void InlineString< CAPACITY >::clear(void) {
+    size     = 0;
+    chars[0] = '\0';
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator == (const InlineString& rhs) const {
+    return size == rhs.size && ::memcmp(chars, rhs.chars, size) == 0;
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator != (const InlineString& rhs) const {
+    return !(*this == rhs);
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator == (std::string_view rhs) const {
+    return view() == rhs;
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator != (std::string_view rhs) const {
+    return view() != rhs;
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator == (const char* rhs) const {
+    return view() == std::string_view(rhs);
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator != (const char* rhs) const {
+    return view() != std::string_view(rhs);
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator == (const std::string& rhs) const {
+    return view() == std::string_view(rhs);
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator != (const std::string& rhs) const {
+    return view() != std::string_view(rhs);
+}
+
+template< uint32 CAPACITY >
+bool InlineString< CAPACITY >::operator < (const InlineString& rhs) const {
+    return view() < rhs.view();
+}
+
+#endif // inline_string_hpp
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef intern_table_hpp
+#define intern_table_hpp
+
+#include "common.hpp"
+#include "./hash.hpp"
+#include "./inline_string.hpp"
+
+#include <initializer_list>
+#include <string_view>
+
+/**
+ * InternTable - Maps up to CAPACITY short names to the dense ids 0, 1, 2... in insertion order.
+ *
+ * Meant to be filled once (well known header names, methods) and then frozen: a frozen table is
+ * never written again, so any thread may look names up without locking. intern() on a frozen or
+ * full table only finds, it never adds.
+ */
+template< uint32 CAPACITY = 128, uint32 NAME_CAPACITY = 64 >
+struct InternTable {
+    static constexpr uint32 NOT_INTERNED = 0xFFFFFFFFu;
+    static constexpr uint32 NAME_SIZE    = NAME_CAPACITY;
+
+    InternTable();
+    InternTable(std::initializer_list< const char* > seed);
+
+    uint32                                intern(std::string_view text);
+    uint32                                find(std::string_view text) const;
+    const InlineString< NAME_CAPACITY >&  name(uint32 id) const;
+    uint32                                length(void) const;
+    bool                                  isFrozen(void) const;
+    void                                  freeze(void);
+
+private:
+    /** Power of two, at most half full. */
+    static constexpr uint32 _slotCount(void) {
+        uint32 count = 2;
+        while (count < 2 * CAPACITY) count *= 2;
+        return count;
+    }
+
+    static constexpr uint32 SLOT_COUNT = _slotCount();
+    static constexpr uint32 SLOT_MASK  = SLOT_COUNT - 1;
+
+    InlineString< NAME_CAPACITY > names[CAPACITY];
+    uint32                        slots[SLOT_COUNT];
+    uint32                        count  = 0;
+    bool                          frozen = false;
+};
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+InternTable< CAPACITY, NAME_CAPACITY >::InternTable() {
+    for (uint32 slot = 0; slot < SLOT_COUNT; slot++) {
+        slots[slot] = NOT_INTERNED;
+    }
+}
+
+/** Interns seed in order (the first name gets id 0) then freezes the table. */
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+InternTable< CAPACITY, NAME_CAPACITY >::InternTable(std::initializer_list< const char* > seed) : InternTable() {
+    for (const char* text : seed) {
+        intern(text);
+    }
+    freeze();
+}
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+uint32 InternTable< CAPACITY, NAME_CAPACITY >::find(std::string_view text) const {
+    uint32 slot = (uint32) wyhash(text.data(), text.size()) & SLOT_MASK;
+
+    while (slots[slot] != NOT_INTERNED) {
+        if (names[slots[slot]] == text) {
+            return slots[slot];
+        }
+        slot = (slot + 1) & SLOT_MASK;
+    }
+
+    return NOT_INTERNED;
+}
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+uint32 InternTable< CAPACITY, NAME_CAPACITY >::intern(std::string_view text) {
+    uint32 id = find(text);
+
+    if (id != NOT_INTERNED || frozen || count == CAPACITY || !InlineString< NAME_CAPACITY >::fits(text)) {
+        return id;
+    }
+
+    uint32 slot = (uint32) wyhash(text.data(), text.size()) & SLOT_MASK;
+    while (slots[slot] != NOT_INTERNED) {
+        slot = (slot + 1) & SLOT_MASK;
+    }
+
+    names[count].assign(text);
+    slots[slot] = count;
+    return count++;
+}
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+const InlineString< NAME_CAPACITY >& InternTable< CAPACITY, NAME_CAPACITY >::name(uint32 id) const {
+    SA_ASSERT(id < count, "Unknown interned id!");
+    return names[id];
+}
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+uint32 InternTable< CAPACITY, NAME_CAPACITY >::length(void) const {
+    return count;
+}
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+bool InternTable< CAPACITY, NAME_CAPACITY >::isFrozen(void) const {
+    return frozen;
+}
+
+template< uint32 CAPACITY, uint32 NAME_CAPACITY >
+void InternTable< CAPACITY, NAME_CAPACITY >::freeze(void) {
+    frozen = true;
+}
+
+/**
+ * InternedName - A name resolved against a frozen InternTable once, compared as an integer
+ * afterwards.
+ *
+ * TABLE returns the shared table. Names it knows carry their id; others keep
+ * NOT_INTERNED and are compared by text. With FOLD_CASE the text is lower cased first
+ * (header names are case insensitive, methods are not). Text longer than the table's
+ * NAME_CAPACITY yields an invalid name that equals nothing: check fits() first.
+ */
+template< class TableType, const TableType& (*TABLE)(void), bool FOLD_CASE >
+struct InternedName {
+    static constexpr uint32 NOT_INTERNED = TableType::NOT_INTERNED;
+    static constexpr uint32 INVALID      = NOT_INTERNED - 1;
+
+    InternedName() {}
+    InternedName(const char* text) : InternedName(std::string_view(text)) {}
+    InternedName(const std::string& text) : InternedName(std::string_view(text)) {}
+    InternedName(std::string_view text);
+    explicit InternedName(uint32 internedId);
+
+    static constexpr bool fits(std::string_view text) { return text.size() <= TableType::NAME_SIZE; }
+
+    bool              isInterned(void) const { return id < INVALID; }
+    bool              isValid(void) const { return id != INVALID; }
+    const char*       c_str(void) const { return text.c_str(); }
+    std::string_view  view(void) const { return text.view(); }
+
+    bool              operator == (const InternedName& rhs) const;
+    bool              operator != (const InternedName& rhs) const { return !(*this == rhs); }
+
+    uint32                                    id = INVALID;
+    InlineString< TableType::NAME_SIZE >      text;
+};
+
+template< class TableType, const TableType& (*TABLE)(void), bool FOLD_CASE >
+InternedName< TableType, TABLE, FOLD_CASE >::InternedName(std::string_view name) {
+    if (!text.assign(name)) {
+        return;
+    }
+    if constexpr (FOLD_CASE) {
+        text.toLower();
+    }
+
+    id = TABLE().find(text.view());
+}
+
+/** From an id of TABLE, e.g. a well known name constant. */
+template< class TableType, const TableType& (*TABLE)(void), bool FOLD_CASE >
+InternedName< TableType, TABLE, FOLD_CASE >::InternedName(uint32 internedId)
+    : id(internedId), text(TABLE().name(internedId)) {}
+
+template< class TableType, const TableType& (*TABLE)(void), bool FOLD_CASE >
+bool InternedName< TableType, TABLE, FOLD_CASE >::operator == (const InternedName& rhs) const {
+    if (id != rhs.id || id == INVALID) {
+        return false;
+    }
+    return id != NOT_INTERNED || text == rhs.text;
+}
+
+#endif // intern_table_hpp
@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef monotonic_arena_hpp
+#define monotonic_arena_hpp
+
+#include "common.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * MonotonicArena - Bump allocator for request scoped data: allocate() moves a cursor,
+ * deallocate is a no-op and reset() releases everything at once.
+ *
+ * Memory comes in blocks that double in size as needed. reset() keeps only the last (largest)
+ * block, so after a few requests a worker's arena has settled and stops touching malloc.
+ * Not thread safe: one arena per thread (see ArenaScope).
+ */
+struct MonotonicArena {
+    enum { DEFAULT_BLOCK_BYTES = 64 * 1024 };
+
+    explicit MonotonicArena(ulong firstBlockBytes = DEFAULT_BLOCK_BYTES);
+    ~MonotonicArena();
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void*           allocate(ulong bytes, ulong alignment = alignof(std::max_align_t));
+    void            reset(void);
+    ulong           bytesUsed(void) const;
+    ulong           capacity(void) const;
+
+private:
+    struct Block {
+        Block* previous;
+        ulong  size;
+    };
+
+    void*           _allocateSlow(ulong bytes, ulong alignment);
+
+    Block*          blocks     = nullptr;
+    char*           cursor     = nullptr;
+    char*           limit      = nullptr;
+    ulong           nextBytes;
+    ulong           usedBytes  = 0;   // in the blocks before the current one
+};
+
+inline MonotonicArena::MonotonicArena(ulong firstBlockBytes) : nextBytes(firstBlockBytes < 64 ? 64 : firstBlockBytes) {}
+
+inline MonotonicArena::~MonotonicArena() {
+    while (blocks != nullptr) {
+        Block* previous = blocks->previous;
+        ::free(blocks);
+        blocks = previous;
+    }
+}
+
+inline void* MonotonicArena::allocate(ulong bytes, ulong alignment) {
+    SA_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+    char* aligned = (char*)(((ulong) cursor + alignment - 1) & ~(alignment - 1));
+
+    if (cursor != nullptr && aligned <= limit && bytes <= (ulong)(limit - aligned)) {
+        cursor = aligned + bytes;
+        return aligned;
+    }
+
+    return _allocateSlow(bytes, alignment);
+}
+
+/** Opens a new block, at least twice the last one and large enough for the request. */
+inline void* MonotonicArena::_allocateSlow(ulong bytes, ulong alignment) {
+    ulong needed = sizeof(Block) + bytes + alignment;
+    if (needed < bytes) {
+        throw std::bad_alloc();
+    }
+
+    ulong size = nextBytes;
+    while (size < needed) size *= 2;
+
+    Block* block = (Block*) ::malloc(size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    if (blocks != nullptr) {
+        usedBytes += cursor - (char*)(blocks + 1);
+    }
+
+    block->previous = blocks;
+    block->size     = size;
+    blocks          = block;
+    nextBytes       = size * 2;
+    cursor          = (char*)(block + 1);
+    limit           = (char*) block + size;
+
+    return allocate(bytes, alignment);
+}
+
+/** Frees every block but the current one, which is rewound. */
+inline void MonotonicArena::reset(void) {
+    if (blocks == nullptr) {
+        return;
+    }
+
+    Block* previous = blocks->previous;
+    while (previous != nullptr) {
+        Block* next = previous->previous;
+        ::free(previous);
+        previous = next;
+    }
+
+    blocks->previous = nullptr;
+    nextBytes        = blocks->size;
+    cursor           = (char*)(blocks + 1);
+    usedBytes        = 0;
+}
+
+inline ulong MonotonicArena::bytesUsed(void) const {
+    return blocks ? usedBytes + (cursor - (char*)(blocks + 1)) : 0;
+}
+
+inline ulong MonotonicArena::capacity(void) const {
+    ulong total = 0;
+    for (Block* block = blocks; block != nullptr; block = block->previous) {
+        total += block->size - sizeof(Block);
+    }
+    return total;
+}
+
+/**
+ * The arena ArenaStlAllocator draws from on this thread, nullptr when none is bound.
+ */
+inline MonotonicArena*& _threadArena(void) {
+    static thread_local MonotonicArena* arena = nullptr;
+    return arena;
+}
+
+inline MonotonicArena* currentArena(void) {
+    return _threadArena();
+}
+
+/**
+ * Binds arena to the calling thread for the scope's lifetime; scopes nest. A nullptr scope
+ * unbinds it, for code running on behalf of someone else (parallel helpers).
+ */
+struct ArenaScope {
+    explicit ArenaScope(MonotonicArena& arena) : previous(_threadArena()) { _threadArena() = &arena; }
+    explicit ArenaScope(std::nullptr_t) : previous(_threadArena()) { _threadArena() = nullptr; }
+    ~ArenaScope() { _threadArena() = previous; }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    MonotonicArena* previous;
+};
+
+/** Resets arena when the guard goes out of scope, exceptions included. */
+struct ArenaResetGuard {
+    explicit ArenaResetGuard(MonotonicArena& guarded) : arena(guarded) {}
+    ~ArenaResetGuard() { arena.reset(); }
+    ArenaResetGuard(const ArenaResetGuard&) = delete;
+    ArenaResetGuard& operator=(const ArenaResetGuard&) = delete;
+
+    MonotonicArena& arena;
+};
+
+/**
+ * ArenaStlAllocator - Stateless Standard Allocator over the thread's current arena.
+ *
+ * Stateless on purpose: containers that default construct their allocators (nlohmann's
+ * basic_json does) still land in the arena. Allocating with no arena bound throws
+ * std::bad_alloc. Whatever it allocated dies with the next reset() of that arena, so such
+ * containers must not outlive the ArenaScope they were built in.
+ */
+template< class ItemType >
+struct ArenaStlAllocator {
+    typedef ItemType value_type;
+
+    ArenaStlAllocator() noexcept {}
+    template< class OtherType >
+    ArenaStlAllocator(const ArenaStlAllocator< OtherType >&) noexcept {}
+
+    ItemType* allocate(std::size_t count);
+    void      deallocate(ItemType*, std::size_t) noexcept {}
+
+    template< class OtherType >
+    bool      operator == (const ArenaStlAllocator< OtherType >&) const noexcept { return true; }
+    template< class OtherType >
+    bool      operator != (const ArenaStlAllocator< OtherType >&) const noexcept { return false; }
+};
+
+template< class ItemType >
+ItemType* ArenaStlAllocator< ItemType >::allocate(std::size_t count) {
+    MonotonicArena* arena = currentArena();
+
+    if (arena == nullptr || count > ~(std::size_t) 0 / sizeof(ItemType)) {
+        throw std::bad_alloc();
+    }
+
+    return (ItemType*) arena->allocate(count * sizeof(ItemType), alignof(ItemType));
+}
+
+#endif // monotonic_arena_hpp
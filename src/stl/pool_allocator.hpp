@@ -8,7 +8,10 @@
 #include "common.hpp"
 
 #include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <cstring>
+#include <stdexcept>
 
 #ifndef collection_hpp
 #   include "collection.hpp"
@@ -21,14 +24,31 @@ struct PoolAllocator {
     char*                             arenaEnd;
     pthread_mutex_t                   allocatorMutex;
 
+    /** mapped: the block lives in its own mmap region (see HUGE_ALLOC_THRESHOLD), not in the arena. */
     struct __attribute__((packed)) Header {
         uint32 words: 30;
         bool alloced: 1;
-        bool reserved: 1;
+        bool mapped: 1;
     };
 
     typedef uint32 word_t;
 
+    /** Natural alignment of every block: the data area starts right after a 4 byte header. */
+    enum { MIN_ALIGNMENT = sizeof(Header) };
+
+    /**
+     * alloc() and realloc() put blocks of at least HUGE_ALLOC_THRESHOLD bytes in their own mmap
+     * region instead of the arena; the region later grows with mremap instead of copying.
+     */
+    enum { HUGE_ALLOC_THRESHOLD = 256 * 1024 };
+
+    /** Prefix of a mapped block: the mapping length, then the usual header right before the data. */
+    struct MappedRegion {
+        ulong  mappedBytes;
+        uint32 padding;
+        Header header;
+    };
+
     #define $header (Header*)
     #define $void   (void*)
     #define $byte_t (char*)
@@ -38,8 +58,11 @@ struct PoolAllocator {
     PoolAllocator(const PoolAllocator&) = delete;
     PoolAllocator&  operator=(const PoolAllocator&) = delete;
     void*           alloc(uint32 bytes);
+    void*           allocAligned(uint32 bytes, uint32 alignment);
     void            dealloc(void* ptr);
+    bool            tryDealloc(void* ptr) noexcept;
     void*           realloc(void* ptr, uint32 newBytes);
+    bool            tryResizeInPlace(void* ptr, uint32 newBytes);
     const Header*   inspectHeader(void* ptr) const;
 
 private:
@@ -49,6 +72,16 @@ private:
     Header*         nextHeader(Header* header) const;
     bool            headerFound(Header* header, word_t requestedWords) const;
     Header*         findBlock(Header* startHeader, word_t requestedWords);
+    Header*         findAlignedBlock(Header* startHeader, word_t requestedWords, uint32 alignment);
+    void            splitBlock(Header* header, word_t requestedWords);
+    void*           markAllocated(Header* header);
+    bool            resizeInPlace(Header* header, word_t requestedWords);
+    void*           allocMapped(uint32 bytes);
+    void*           reallocMapped(void* ptr, uint32 newBytes);
+    void            deallocMapped(void* ptr);
+    MappedRegion*   getMappedRegion(void* ptr) const;
+    ulong           calculateMappedBytes(uint32 bytes) const;
+    uint32          usableBytes(void* ptr) const;
     void*           getBlockArea(Header* header) const;
     void            initializeFirstHeader(void);
 
@@ -73,7 +106,7 @@ inline PoolAllocator::Header* PoolAllocator::nextHeader(Header* header) const {
 }
 
 inline bool PoolAllocator::headerFound(Header* header, word_t requestedWords) const {
-    return !header->alloced && !header->reserved && (header->words == 0 || header->words >= requestedWords);
+    return !header->alloced && !header->mapped && header->words >= requestedWords;
 }
 
 inline PoolAllocator::Header* PoolAllocator::findBlock(Header* startHeader, word_t requestedWords) {
@@ -90,6 +123,151 @@ inline PoolAllocator::Header* PoolAllocator::findBlock(Header* startHeader, word
     return nullptr;
 }
 
+/**
+ * Finds a free block able to hold requestedWords starting at an address aligned to alignment.
+ * When the aligned start is not the block start, the leading gap is split off as its own free
+ * block, so the gap must be big enough to hold a header plus at least one word.
+ */
+inline PoolAllocator::Header* PoolAllocator::findAlignedBlock(Header* startHeader, word_t requestedWords, uint32 alignment) {
+    Header* currentHeader = startHeader;
+
+    while ($byte_t currentHeader < arenaEnd && !($byte_t(currentHeader + 1) >= arenaEnd)) {
+        if (headerFound(currentHeader, requestedWords)) {
+            char*  data    = $byte_t getBlockArea(currentHeader);
+            char*  aligned = $byte_t(((ulong) data + alignment - 1) & ~((ulong) alignment - 1));
+            uint32 gap     = (uint32)(aligned - data);
+
+            if (gap != 0 && gap < sizeof(Header) + MIN_ALIGNMENT) {
+                aligned += alignment;
+                gap     += alignment;
+            }
+
+            if (gap + calculateBytes(requestedWords) <= calculateBytes(currentHeader->words)) {
+                if (gap == 0) {
+                    return currentHeader;
+                }
+
+                Header* shifted   = $header aligned - 1;
+                shifted->words    = currentHeader->words - calculateWords(gap);
+                shifted->alloced  = false;
+                shifted->mapped   = false;
+
+                currentHeader->words = calculateWords(gap - sizeof(Header));
+                return shifted;
+            }
+        }
+
+        currentHeader = nextHeader(currentHeader);
+    }
+
+    return nullptr;
+}
+
+/**
+ * Shrinks header to requestedWords, turning the tail into a new free block when it is big
+ * enough to hold a header plus at least one word.
+ */
+inline void PoolAllocator::splitBlock(Header* header, word_t requestedWords) {
+    word_t remainingWords = header->words - requestedWords;
+
+    if (remainingWords >= (sizeof(Header) / 4) + 1) {
+        header->words = requestedWords;
+
+        Header* newHeader   = nextHeader(header);
+        newHeader->words    = remainingWords - (sizeof(Header) / 4);
+        newHeader->alloced  = false;
+        newHeader->mapped   = false;
+    }
+}
+
+inline void* PoolAllocator::markAllocated(Header* header) {
+    header->alloced = true;
+    header->mapped  = false;
+    return getBlockArea(header);
+}
+
+/**
+ * Grows header up to requestedWords by absorbing the free blocks that follow it, or shrinks it,
+ * returning the tail to the arena. Fails (keeping whatever was coalesced) when the neighbours
+ * are not enough.
+ */
+inline bool PoolAllocator::resizeInPlace(Header* header, word_t requestedWords) {
+    while (header->words < requestedWords) {
+        Header* next = nextHeader(header);
+
+        if ($byte_t(next + 1) > arenaEnd || next->alloced || next->mapped) {
+            return false;
+        }
+
+        header->words += (sizeof(Header) / 4) + next->words;
+    }
+
+    splitBlock(header, requestedWords);
+    return true;
+}
+
+inline PoolAllocator::MappedRegion* PoolAllocator::getMappedRegion(void* ptr) const {
+    return (MappedRegion*)($byte_t ptr - sizeof(MappedRegion));
+}
+
+inline ulong PoolAllocator::calculateMappedBytes(uint32 bytes) const {
+    ulong pageSize = (ulong) sysconf(_SC_PAGESIZE);
+    return ((ulong) bytes + sizeof(MappedRegion) + pageSize - 1) & ~(pageSize - 1);
+}
+
+inline uint32 PoolAllocator::usableBytes(void* ptr) const {
+    Header* header = getHeader(ptr);
+
+    if (header->mapped) {
+        ulong bytes = getMappedRegion(ptr)->mappedBytes - sizeof(MappedRegion);
+        return bytes > 0xFFFFFFFFul ? 0xFFFFFFFFu : (uint32) bytes;
+    }
+
+    return calculateBytes(header->words);
+}
+
+inline void* PoolAllocator::allocMapped(uint32 bytes) {
+    ulong mappedBytes = calculateMappedBytes(bytes);
+    void* base        = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+
+    MappedRegion* region   = (MappedRegion*) base;
+    region->mappedBytes    = mappedBytes;
+    region->header.words   = 0;
+    region->header.alloced = true;
+    region->header.mapped  = true;
+
+    return region + 1;
+}
+
+inline void* PoolAllocator::reallocMapped(void* ptr, uint32 newBytes) {
+    MappedRegion* region      = getMappedRegion(ptr);
+    ulong         mappedBytes = calculateMappedBytes(newBytes);
+
+    if (mappedBytes == region->mappedBytes) {
+        return ptr;
+    }
+
+    void* base = mremap(region, region->mappedBytes, mappedBytes, MREMAP_MAYMOVE);
+
+    if (base == MAP_FAILED) {
+        return nullptr;
+    }
+
+    region              = (MappedRegion*) base;
+    region->mappedBytes = mappedBytes;
+
+    return region + 1;
+}
+
+inline void PoolAllocator::deallocMapped(void* ptr) {
+    MappedRegion* region = getMappedRegion(ptr);
+    munmap(region, region->mappedBytes);
+}
+
 inline void* PoolAllocator::getBlockArea(Header* header) const {
     return header + 1;
 }
@@ -104,7 +282,7 @@ inline void PoolAllocator::initializeFirstHeader() {
 
     h->words    = words;
     h->alloced  = false;
-    h->reserved = false;
+    h->mapped   = false;
 
     arenaEnd = basePtr + capacity;
 }
@@ -119,6 +297,10 @@ inline PoolAllocator::~PoolAllocator() {
 }
 
 inline void* PoolAllocator::alloc(uint32 bytes) {
+    if (bytes >= HUGE_ALLOC_THRESHOLD) {
+        return allocMapped(bytes);
+    }
+
     word_t requestedWords = calculateWords(bytes);
     
     pthread_mutex_lock(&allocatorMutex);
@@ -132,23 +314,40 @@ inline void* PoolAllocator::alloc(uint32 bytes) {
         return nullptr;
     }
 
-    word_t originalWords = selected->words;
-    word_t remainingWords = originalWords - requestedWords;
+    splitBlock(selected, requestedWords);
+    void* block = markAllocated(selected);
 
-    if (remainingWords >= (sizeof(Header) / 4) + 1) {
-        Header* newHeader = nextHeader(selected);
-        
-        newHeader->words = remainingWords - (sizeof(Header) / 4);
-        newHeader->alloced = false;
-        newHeader->reserved = false;
-
-        selected->words = requestedWords;
-    } 
-    
-    selected->alloced = true;
-    selected->reserved = false;
+    pthread_mutex_unlock(&allocatorMutex);
+
+    return block;
+}
 
-    void* block = getBlockArea(selected);
+/**
+ * Allocates bytes starting at an address that is a multiple of alignment (a power of two).
+ * Alignments up to MIN_ALIGNMENT are served by the regular alloc() path.
+ */
+inline void* PoolAllocator::allocAligned(uint32 bytes, uint32 alignment) {
+    SA_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two!");
+
+    if (alignment <= MIN_ALIGNMENT) {
+        return alloc(bytes);
+    }
+
+    word_t requestedWords = calculateWords(bytes);
+
+    pthread_mutex_lock(&allocatorMutex);
+
+    Header* header = reinterpret_cast<Header*>(arena.items);
+
+    Header* selected = findAlignedBlock(header, requestedWords, alignment);
+
+    if (!selected) {
+        pthread_mutex_unlock(&allocatorMutex);
+        return nullptr;
+    }
+
+    splitBlock(selected, requestedWords);
+    void* block = markAllocated(selected);
 
     pthread_mutex_unlock(&allocatorMutex);
 
@@ -156,23 +355,49 @@ inline void* PoolAllocator::alloc(uint32 bytes) {
 }
 
 inline void PoolAllocator::dealloc(void* ptr) {
-    if (!ptr) return;
+    bool freed = tryDealloc(ptr);
+
+    SA_ASSERT(freed, "Double free detected or invalid pointer!");
+    if (!freed) {
+        throw std::runtime_error("Double free detected or invalid pointer!");
+    }
+}
+
+/** dealloc for callers that must not throw (noexcept deallocators): false on a double free. */
+inline bool PoolAllocator::tryDealloc(void* ptr) noexcept {
+    if (!ptr) return true;
     
     pthread_mutex_lock(&allocatorMutex);
 
     Header* header = getHeader(ptr);
 
-    SA_ASSERT(header->alloced, "Double free detected or invalid pointer!");
-    if (!header->alloced) throw std::runtime_error("Double free detected or invalid pointer!");
+    if (header->alloced && header->mapped) {
+        pthread_mutex_unlock(&allocatorMutex);
+        deallocMapped(ptr);
+        return true;
+    }
+
+    if (!header->alloced) {
+        pthread_mutex_unlock(&allocatorMutex);
+        return false;
+    }
 
     header->alloced = false;
-    header->reserved = false;
+    header->mapped  = false;
 
     ::memset(ptr, 0, calculateBytes(header->words));
     
     pthread_mutex_unlock(&allocatorMutex);
+    return true;
 }
 
+/**
+ * Resizes ptr keeping its contents:
+ *  - blocks already living in an mmap region grow or shrink with mremap;
+ *  - requests of at least HUGE_ALLOC_THRESHOLD bytes move the block into its own mmap region;
+ *  - arena blocks shrink in place, or grow in place by absorbing the free blocks that follow;
+ *  - only when none of that applies a new block is allocated and the data copied over.
+ */
 inline void* PoolAllocator::realloc(void* ptr, uint32 newBytes) {
     if (!ptr) {
         return alloc(newBytes);
@@ -182,14 +407,28 @@ inline void* PoolAllocator::realloc(void* ptr, uint32 newBytes) {
         return nullptr;
     }
 
+    Header* oldHeader = getHeader(ptr);
+
+    if (oldHeader->mapped) {
+        return reallocMapped(ptr, newBytes);
+    }
+
+    if (newBytes < HUGE_ALLOC_THRESHOLD) {
+        pthread_mutex_lock(&allocatorMutex);
+        bool resized = resizeInPlace(oldHeader, calculateWords(newBytes));
+        pthread_mutex_unlock(&allocatorMutex);
+
+        if (resized) {
+            return ptr;
+        }
+    }
+
     void* newPtr = alloc(newBytes);
     if (!newPtr) {
         return nullptr;
     }
 
-    Header* oldHeader = getHeader(ptr);
-    uint32    oldSize   = calculateBytes(oldHeader->words);
-
+    uint32 oldSize  = usableBytes(ptr);
     size_t copySize = (oldSize < newBytes) ? oldSize : newBytes;
     memcpy(newPtr, ptr, copySize);
     dealloc(ptr);
@@ -197,6 +436,22 @@ inline void* PoolAllocator::realloc(void* ptr, uint32 newBytes) {
     return newPtr;
 }
 
+/**
+ * Resizes an arena block without ever moving it, so the block keeps whatever alignment it was
+ * allocated with (realloc may return a merely 4 byte aligned copy). False when it can't.
+ */
+inline bool PoolAllocator::tryResizeInPlace(void* ptr, uint32 newBytes) {
+    if (!ptr || newBytes == 0 || getHeader(ptr)->mapped) {
+        return false;
+    }
+
+    pthread_mutex_lock(&allocatorMutex);
+    bool resized = resizeInPlace(getHeader(ptr), calculateWords(newBytes));
+    pthread_mutex_unlock(&allocatorMutex);
+
+    return resized;
+}
+
 inline const PoolAllocator::Header* PoolAllocator::inspectHeader(void* ptr) const {
     return getHeader(ptr);
 }
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef pool_memory_resource_hpp
+#define pool_memory_resource_hpp
+
+#include "common.hpp"
+#include "./pool_allocator.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * PoolMemoryResource - std::pmr::memory_resource backed by a PoolAllocator.
+ *
+ * Lets any std::pmr container (pmr::string, pmr::vector, pmr::map...) draw from the pooled arena.
+ * As required by the memory_resource contract, an exhausted pool throws std::bad_alloc and
+ * deallocation throws nothing (a double free only asserts in debug builds).
+ */
+struct PoolMemoryResource : public std::pmr::memory_resource {
+    PoolAllocator* pool;
+
+    explicit PoolMemoryResource(PoolAllocator* poolAlloc);
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+/**
+ * PoolStlAllocator - Standard Allocator adapter over PoolAllocator.
+ *
+ * Stateful: copies share the same pool, and two adapters compare equal when they do.
+ * Usable with any allocator-aware container (std::basic_string, std::vector, nlohmann::basic_json...).
+ * deallocate is noexcept, as the Allocator requirements want: a double free asserts in debug
+ * builds and is otherwise ignored.
+ */
+template< class ItemType >
+struct PoolStlAllocator {
+    typedef ItemType value_type;
+
+    PoolAllocator* pool;
+
+    explicit PoolStlAllocator(PoolAllocator* poolAlloc) noexcept;
+    template< class OtherType >
+    PoolStlAllocator(const PoolStlAllocator< OtherType >& other) noexcept;
+
+    ItemType* allocate(std::size_t count);
+    void      deallocate(ItemType* ptr, std::size_t count) noexcept;
+
+    template< class OtherType >
+    bool      operator == (const PoolStlAllocator< OtherType >& rhs) const noexcept;
+    template< class OtherType >
+    bool      operator != (const PoolStlAllocator< OtherType >& rhs) const noexcept;
+};
+
+typedef std::basic_string< char, std::char_traits< char >, PoolStlAllocator< char > > PoolString;
+
+template< class ItemType >
+using PoolVector = std::vector< ItemType, PoolStlAllocator< ItemType > >;
+
+/**
+ * Shared by both adapters: PoolAllocator sizes are 32 bits wide, anything bigger can't be pooled.
+ */
+inline void* poolAllocateOrThrow(PoolAllocator* pool, std::size_t bytes, std::size_t alignment) {
+    if (bytes > 0xFFFFFFFFu || alignment > 0xFFFFFFFFu) {
+        throw std::bad_alloc();
+    }
+
+    void* ptr = pool->allocAligned((uint32) bytes, (uint32) alignment);
+
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+inline PoolMemoryResource::PoolMemoryResource(PoolAllocator* poolAlloc) : pool(poolAlloc) {}
+
+inline void* PoolMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    return poolAllocateOrThrow(pool, bytes, alignment);
+}
+
+inline void PoolMemoryResource::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) {
+    (void) bytes; (void) alignment;
+    bool freed = pool->tryDealloc(ptr);
+
+    SA_ASSERT(freed, "Double free detected or invalid pointer!");
+    (void) freed;
+}
+
+inline bool PoolMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    const PoolMemoryResource* otherResource = dynamic_cast< const PoolMemoryResource* >(&other);
+    return otherResource != nullptr && otherResource->pool == pool;
+}
+
+template< class ItemType >
+PoolStlAllocator< ItemType >::PoolStlAllocator(PoolAllocator* poolAlloc) noexcept : pool(poolAlloc) {}
+
+template< class ItemType >
+template< class OtherType >
+PoolStlAllocator< ItemType >::PoolStlAllocator(const PoolStlAllocator< OtherType >& other) noexcept : pool(other.pool) {}
+
+template< class ItemType >
+ItemType* PoolStlAllocator< ItemType >::allocate(std::size_t count) {
+    if (count > 0xFFFFFFFFu / sizeof(ItemType)) {
+        throw std::bad_alloc();
+    }
+
+    return (ItemType*) poolAllocateOrThrow(pool, count * sizeof(ItemType), alignof(ItemType));
+}
+
+template< class ItemType >
+void PoolStlAllocator< ItemType >::deallocate(ItemType* ptr, std::size_t count) noexcept {
+    (void) count;
+    bool freed = pool->tryDealloc(ptr);
+
+    SA_ASSERT(freed, "Double free detected or invalid pointer!");
+    (void) freed;
+}
+
+template< class ItemType >
+template< class OtherType >
+bool PoolStlAllocator< ItemType >::operator == (const PoolStlAllocator< OtherType >& rhs) const noexcept {
+    return pool == rhs.pool;
+}
+
+template< class ItemType >
+template< class OtherType >
+bool PoolStlAllocator< ItemType >::operator != (const PoolStlAllocator< OtherType >& rhs) const noexcept {
+    return pool != rhs.pool;
+}
+
+#endif // pool_memory_resource_hpp
@@ -5,11 +5,29 @@
 #ifndef queue_hpp
 #define queue_hpp
 
-#include "collection.hpp"
+#include "common.hpp"
 
+#include <new>
+#include <utility>
+
+/**
+ * Queue - Fixed capacity FIFO ring buffer (one slot is kept free to tell full from empty).
+ *
+ * ring is raw storage: an item is constructed on enqueue and destroyed on dequeue.
+ */
 template< class ItemType, uint32 CAPACITY = 128 >
 struct Queue {
+    Queue();
+    Queue(const Queue&) = delete;
+    Queue(Queue&& other);
+    Queue& operator = (const Queue&) = delete;
+    Queue& operator = (Queue&& other);
+    ~Queue();
+
     bool     enqueue(const ItemType& item);
+    bool     enqueue(ItemType&& item);
+    template< class... Args >
+    bool     emplace(Args&&... args);
     ItemType dequeue(void);
     uint32     length() const;
     bool     isEmpty(void);
@@ -17,44 +35,93 @@ struct Queue {
     
     uint32                             head = 0;
     uint32                             tail = 0;
-    Collection< ItemType, CAPACITY > items;
+    uint32                             count = 0;
+    union {
+        ItemType                       ring[CAPACITY];
+    };
 };
 
+template< class ItemType, uint32 CAPACITY > 
+Queue< ItemType, CAPACITY >::Queue() {}
+
+template< class ItemType, uint32 CAPACITY > 
+Queue< ItemType, CAPACITY >::Queue(Queue&& other) {
+    while (other.count > 0) {
+        emplace(other.dequeue());
+    }
+}
+
+template< class ItemType, uint32 CAPACITY > 
+Queue< ItemType, CAPACITY >& Queue< ItemType, CAPACITY >::operator = (Queue&& other) {
+    if (this == &other) return *this;
+
+    while (count > 0) {
+        dequeue();
+    }
+    head = tail = 0;
+
+    while (other.count > 0) {
+        emplace(other.dequeue());
+    }
+
+    return *this;
+}
+
+template< class ItemType, uint32 CAPACITY > 
+Queue< ItemType, CAPACITY >::~Queue() {
+    while (count > 0) {
+        ring[tail].~ItemType();
+        tail = (tail + 1) % CAPACITY;
+        count--;
+    }
+}
+
 template< class ItemType, uint32 CAPACITY > 
 bool Queue< ItemType, CAPACITY >::enqueue(const ItemType& item) {
+    return emplace(item);
+}
+
+template< class ItemType, uint32 CAPACITY > 
+bool Queue< ItemType, CAPACITY >::enqueue(ItemType&& item) {
+    return emplace(std::move(item));
+}
+
+template< class ItemType, uint32 CAPACITY > 
+template< class... Args >
+bool Queue< ItemType, CAPACITY >::emplace(Args&&... args) {
     if ((head + 1) % CAPACITY == tail) {
         return false;
     }
     
-    items.items[head] = item;
+    new (&ring[head]) ItemType(std::forward< Args >(args)...);
 
     head = (head + 1) % CAPACITY;
-
-    if (items.length < CAPACITY) items.length++;
+    count++;
 
     return true;
 }
 
 template< class ItemType, uint32 CAPACITY > 
 ItemType Queue< ItemType, CAPACITY >::dequeue(void) {
-    if (items.length == 0) return {};
+    if (count == 0) return {};
 
-    ItemType item = items.items[tail];
+    ItemType item = std::move(ring[tail]);
+    ring[tail].~ItemType();
 
     tail = (tail + 1) % CAPACITY;
-    items.length--;
+    count--;
 
     return item;
 }
 
 template< class ItemType, uint32 CAPACITY > 
 uint32 Queue< ItemType, CAPACITY >::length() const {
-    return items.length;
+    return count;
 }
 
 template< class ItemType, uint32 CAPACITY > 
 bool Queue< ItemType, CAPACITY >::isEmpty(void) {
-    return items.isEmpty();
+    return count == 0;
 }
 
 template< class ItemType, uint32 CAPACITY > 
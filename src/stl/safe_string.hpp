@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <string_view>
 #include <fmt/core.h>
 #include "common.hpp"
 
@@ -35,4 +36,21 @@ inline void trim(String& text) {
     text.assign(beginIt, endIt);
 }
 
+/** Same as trim, on a view: no copy. */
+inline std::string_view trimmed(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && isSpace(text.back()))  text.remove_suffix(1);
+    return text;
+}
+
+/** ASCII lower cased copy, for case insensitive tokens (header names, codings, media types). */
+inline String lowerCased(std::string_view text) {
+    String lower(text);
+
+    for (char& ch : lower) {
+        if (ch >= 'A' && ch <= 'Z') ch = (char)(ch + ('a' - 'A'));
+    }
+    return lower;
+}
+
 #endif // safe_string_hpp
\ No newline at end of file
@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef simd_find_hpp
+#define simd_find_hpp
+
+#include "common.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <immintrin.h>
+#    define SA_SIMD_X86 1
+#endif
+
+/**
+ * Linear search kernels for items compared bit for bit: integers, enums and pointers of
+ * 1, 2, 4 or 8 bytes. Used by Collection::indexOf and SmallVector::indexOf.
+ *
+ * simdFind picks the widest kernel the CPU has: AVX2 compares 32 bytes per instruction,
+ * SSE2 (always there on x86-64) 16 bytes. AVX2 is detected once at runtime, the binary
+ * itself is still built for the baseline.
+ */
+template< class ItemType >
+inline constexpr bool isSimdFindable =
+    (std::is_integral_v< ItemType > || std::is_enum_v< ItemType > || std::is_pointer_v< ItemType >)
+    && !std::is_same_v< ItemType, bool >
+    && (sizeof(ItemType) == 1 || sizeof(ItemType) == 2 || sizeof(ItemType) == 4 || sizeof(ItemType) == 8);
+
+template< class ItemType >
+int simdFindScalar(const ItemType* items, uint32 length, ItemType item) {
+    for (uint32 idx = 0; idx < length; idx++) {
+        if (items[idx] == item) return idx;
+    }
+    return -1;
+}
+
+#ifdef SA_SIMD_X86
+
+/** Per element width compares. 8 byte lanes need SSE4.1 for pcmpeqq: pair up 32 bit halves. */
+template< uint32 WIDTH >
+inline __m128i _simdEqualSse2(__m128i lhs, __m128i rhs) {
+    if constexpr (WIDTH == 1) return _mm_cmpeq_epi8(lhs, rhs);
+    if constexpr (WIDTH == 2) return _mm_cmpeq_epi16(lhs, rhs);
+    if constexpr (WIDTH == 4) return _mm_cmpeq_epi32(lhs, rhs);
+    if constexpr (WIDTH == 8) {
+        __m128i halves = _mm_cmpeq_epi32(lhs, rhs);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+}
+
+template< uint32 WIDTH >
+inline __m128i _simdBroadcastSse2(uint64 bits) {
+    if constexpr (WIDTH == 1) return _mm_set1_epi8((char) bits);
+    if constexpr (WIDTH == 2) return _mm_set1_epi16((short) bits);
+    if constexpr (WIDTH == 4) return _mm_set1_epi32((int) bits);
+    if constexpr (WIDTH == 8) return _mm_set1_epi64x((long long) bits);
+}
+
+template< uint32 WIDTH >
+__attribute__((target("avx2"))) inline __m256i _simdEqualAvx2(__m256i lhs, __m256i rhs) {
+    if constexpr (WIDTH == 1) return _mm256_cmpeq_epi8(lhs, rhs);
+    if constexpr (WIDTH == 2) return _mm256_cmpeq_epi16(lhs, rhs);
+    if constexpr (WIDTH == 4) return _mm256_cmpeq_epi32(lhs, rhs);
+    if constexpr (WIDTH == 8) return _mm256_cmpeq_epi64(lhs, rhs);
+}
+
+template< uint32 WIDTH >
+__attribute__((target("avx2"))) inline __m256i _simdBroadcastAvx2(uint64 bits) {
+    if constexpr (WIDTH == 1) return _mm256_set1_epi8((char) bits);
+    if constexpr (WIDTH == 2) return _mm256_set1_epi16((short) bits);
+    if constexpr (WIDTH == 4) return _mm256_set1_epi32((int) bits);
+    if constexpr (WIDTH == 8) return _mm256_set1_epi64x((long long) bits);
+}
+
+template< class ItemType >
+inline uint64 _simdBits(ItemType item) {
+    uint64 bits = 0;
+    ::memcpy(&bits, &item, sizeof(ItemType));
+    return bits;
+}
+
+template< class ItemType >
+int simdFindSse2(const ItemType* items, uint32 length, ItemType item) {
+    constexpr uint32 WIDTH = sizeof(ItemType);
+    constexpr uint32 LANES = 16 / WIDTH;
+
+    const __m128i needle = _simdBroadcastSse2< WIDTH >(_simdBits(item));
+    uint32        idx    = 0;
+
+    for (; idx + LANES <= length; idx += LANES) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(items + idx));
+        uint32  mask  = (uint32) _mm_movemask_epi8(_simdEqualSse2< WIDTH >(block, needle));
+        if (mask != 0) return idx + __builtin_ctz(mask) / WIDTH;
+    }
+
+    int tail = simdFindScalar(items + idx, length - idx, item);
+    return tail < 0 ? -1 : (int)(idx + tail);
+}
+
+/** Two 32 byte blocks per iteration: 64 chars or 8 pointers per loop. */
+template< class ItemType >
+__attribute__((target("avx2"))) int simdFindAvx2(const ItemType* items, uint32 length, ItemType item) {
+    constexpr uint32 WIDTH = sizeof(ItemType);
+    constexpr uint32 LANES = 32 / WIDTH;
+
+    const __m256i needle = _simdBroadcastAvx2< WIDTH >(_simdBits(item));
+    uint32        idx    = 0;
+
+    for (; idx + 2 * LANES <= length; idx += 2 * LANES) {
+        __m256i low   = _simdEqualAvx2< WIDTH >(_mm256_loadu_si256((const __m256i*)(items + idx)), needle);
+        __m256i high  = _simdEqualAvx2< WIDTH >(_mm256_loadu_si256((const __m256i*)(items + idx + LANES)), needle);
+        uint64  mask  = (uint32) _mm256_movemask_epi8(low) | ((uint64)(uint32) _mm256_movemask_epi8(high) << 32);
+        if (mask != 0) return idx + __builtin_ctzll(mask) / WIDTH;
+    }
+
+    if (idx + LANES <= length) {
+        __m256i block = _simdEqualAvx2< WIDTH >(_mm256_loadu_si256((const __m256i*)(items + idx)), needle);
+        uint32  mask  = (uint32) _mm256_movemask_epi8(block);
+        if (mask != 0) return idx + __builtin_ctz(mask) / WIDTH;
+        idx += LANES;
+    }
+
+    int tail = simdFindScalar(items + idx, length - idx, item);
+    return tail < 0 ? -1 : (int)(idx + tail);
+}
+
+inline bool simdHasAvx2(void) {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+
+#endif // SA_SIMD_X86
+
+/**
+ * Index of the first item equal to item, -1 if none. Below one vector of items the scalar
+ * loop is cheaper than the dispatch.
+ */
+template< class ItemType >
+inline int simdFind(const ItemType* items, uint32 length, ItemType item) {
+    static_assert(isSimdFindable< ItemType >, "simdFind compares items bit for bit");
+
+#ifdef SA_SIMD_X86
+    if (length * sizeof(ItemType) >= 32 && simdHasAvx2()) {
+        return simdFindAvx2(items, length, item);
+    }
+    if (length * sizeof(ItemType) >= 16) {
+        return simdFindSse2(items, length, item);
+    }
+#endif // SA_SIMD_X86
+
+    return simdFindScalar(items, length, item);
+}
+
+#endif // simd_find_hpp
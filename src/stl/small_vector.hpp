@@ -0,0 +1,444 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef small_vector_hpp
+#define small_vector_hpp
+
+#include "common.hpp"
+#include "./pool_allocator.hpp"
+#include "./simd_find.hpp"
+
+#include <new>
+#include <utility>
+
+/**
+ * SmallVector - Growable sequence keeping its first INLINE_CAPACITY items inline.
+ *
+ * Same add/at/removeAt/indexOf API as Collection, but never full: once the inline slots are
+ * used the items move to a heap block (or a PoolAllocator block) that doubles on demand. Size
+ * INLINE_CAPACITY for the common case, outliers still fit.
+ *
+ * items always points at the live storage (inlineItems or the heap block) and only
+ * [0, length) is constructed. Pointers to items are invalidated when the vector grows.
+ * An allocation failure throws std::bad_alloc from add/emplace; the try* variants return false.
+ */
+template< class ItemType, uint32 INLINE_CAPACITY = 8 >
+struct SmallVector {
+    static_assert(INLINE_CAPACITY > 0, "SmallVector needs at least one inline slot");
+
+    ItemType*         items;
+    uint32            length;
+    uint32            capacity;
+    PoolAllocator*    allocator;
+    union {
+        ItemType      inlineItems[INLINE_CAPACITY];
+    };
+
+    SmallVector();
+    explicit SmallVector(PoolAllocator* poolAlloc);
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other);
+    ~SmallVector();
+    SmallVector& operator = (const SmallVector& rhs);
+    SmallVector& operator = (SmallVector&& rhs);
+
+    ItemType*         begin(void);
+    const ItemType*   begin(void) const;
+    ItemType*         end(void);
+    const ItemType*   end(void) const;
+
+    /**
+     * Query family functions...
+     */
+    bool              isEmpty(void) const;
+    bool              isInline(void) const;
+    ItemType&         at(uint32 idx);
+    const ItemType&   at(uint32 idx) const;
+    ItemType&         operator [] (uint32 idx);
+    const ItemType&   operator [] (uint32 idx) const;
+    int               indexOf(const ItemType& item) const;
+    bool              operator == (const SmallVector& rhs) const;
+    bool              operator != (const SmallVector& rhs) const;
+
+    /**
+     * Modify family functions...
+     */
+    ItemType&         add(const ItemType& item);
+    ItemType&         add(ItemType&& item);
+    template< class... Args >
+    ItemType&         emplace(Args&&... args);
+    ItemType&         addAt(uint32 idx, const ItemType& item);
+    ItemType&         addAt(uint32 idx, ItemType&& item);
+    template< class... Args >
+    ItemType&         emplaceAt(uint32 idx, Args&&... args);
+    bool              tryAdd(const ItemType& item);
+    bool              tryAdd(ItemType&& item);
+    template< class... Args >
+    bool              tryEmplace(Args&&... args);
+    void              removeAt(uint32 idx);
+    void              clear(void);
+    bool              reserve(uint32 nbItems);
+
+private:
+    ItemType*         _allocate(uint32 nbItems);
+    void              _release(ItemType* block);
+    bool              _grow(uint32 minCapacity);
+    void              _ensureGrown(void);
+    void              _stealOrMove(SmallVector& other);
+};
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >::SmallVector()
+    : items(inlineItems), length(0), capacity(INLINE_CAPACITY), allocator(nullptr) {}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >::SmallVector(PoolAllocator* poolAlloc)
+    : items(inlineItems), length(0), capacity(INLINE_CAPACITY), allocator(poolAlloc) {}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >::SmallVector(const SmallVector& other)
+    : items(inlineItems), length(0), capacity(INLINE_CAPACITY), allocator(other.allocator) {
+    *this = other;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >::SmallVector(SmallVector&& other)
+    : items(inlineItems), length(0), capacity(INLINE_CAPACITY), allocator(other.allocator) {
+    _stealOrMove(other);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >::~SmallVector() {
+    clear();
+
+    if (!isInline()) {
+        _release(items);
+    }
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >& SmallVector< ItemType, INLINE_CAPACITY >::operator = (const SmallVector& rhs) {
+    if (this == &rhs) return *this;
+
+    clear();
+    if (!reserve(rhs.length)) throw std::bad_alloc();
+
+    for (uint32 idx = 0; idx < rhs.length; idx++) {
+        new (&items[idx]) ItemType(rhs.items[idx]);
+        length++;
+    }
+
+    return *this;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+SmallVector< ItemType, INLINE_CAPACITY >& SmallVector< ItemType, INLINE_CAPACITY >::operator = (SmallVector&& rhs) {
+    if (this == &rhs) return *this;
+
+    clear();
+
+    if (!isInline()) {
+        _release(items);
+        items    = inlineItems;
+        capacity = INLINE_CAPACITY;
+    }
+
+    allocator = rhs.allocator;
+    _stealOrMove(rhs);
+
+    return *this;
+}
+
+/**
+ * A spilled other hands its block over, an inline one has its items moved one by one.
+ * Either way other is left empty.
+ */
+template< class ItemType, uint32 INLINE_CAPACITY >
+void SmallVector< ItemType, INLINE_CAPACITY >::_stealOrMove(SmallVector& other) {
+    if (!other.isInline()) {
+        items    = other.items;
+        length   = other.length;
+        capacity = other.capacity;
+
+        other.items    = other.inlineItems;
+        other.length   = 0;
+        other.capacity = INLINE_CAPACITY;
+        return;
+    }
+
+    for (uint32 idx = 0; idx < other.length; idx++) {
+        new (&items[idx]) ItemType(std::move(other.items[idx]));
+    }
+    length = other.length;
+    other.clear();
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType* SmallVector< ItemType, INLINE_CAPACITY >::begin(void) {
+    return items;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+const ItemType* SmallVector< ItemType, INLINE_CAPACITY >::begin(void) const {
+    return items;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType* SmallVector< ItemType, INLINE_CAPACITY >::end(void) {
+    return items + length;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+const ItemType* SmallVector< ItemType, INLINE_CAPACITY >::end(void) const {
+    return items + length;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::isEmpty(void) const {
+    return length == 0;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::isInline(void) const {
+    return items == inlineItems;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::at(uint32 idx) {
+    SA_ASSERT(idx < length, "Index out of bounds!");
+    return items[idx];
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+const ItemType& SmallVector< ItemType, INLINE_CAPACITY >::at(uint32 idx) const {
+    SA_ASSERT(idx < length, "Index out of bounds!");
+    return items[idx];
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::operator [] (uint32 idx) {
+    return at(idx);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+const ItemType& SmallVector< ItemType, INLINE_CAPACITY >::operator [] (uint32 idx) const {
+    return at(idx);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+int SmallVector< ItemType, INLINE_CAPACITY >::indexOf(const ItemType& item) const {
+    if constexpr (isSimdFindable< ItemType >) {
+        return simdFind(items, length, item);
+    } else {
+        for (uint32 idx = 0; idx < length; idx++) {
+            if (items[idx] == item) return idx;
+        }
+        return -1;
+    }
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::operator == (const SmallVector& rhs) const {
+    if (rhs.length != length) return false;
+
+    for (uint32 idx = 0; idx < length; idx++) {
+        if (items[idx] != rhs.items[idx]) return false;
+    }
+
+    return true;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::operator != (const SmallVector& rhs) const {
+    return !(*this == rhs);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::add(const ItemType& item) {
+    return emplace(item);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::add(ItemType&& item) {
+    return emplace(std::move(item));
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+template< class... Args >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::emplace(Args&&... args) {
+    if (length == capacity) {
+        // args may refer to an item of this vector, build it before the storage moves
+        ItemType item(std::forward< Args >(args)...);
+        _ensureGrown();
+
+        ItemType* added = new (&items[length]) ItemType(std::move(item));
+        length++;
+        return *added;
+    }
+
+    ItemType* added = new (&items[length]) ItemType(std::forward< Args >(args)...);
+    length++;
+    return *added;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::addAt(uint32 idx, const ItemType& item) {
+    return emplaceAt(idx, item);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::addAt(uint32 idx, ItemType&& item) {
+    return emplaceAt(idx, std::move(item));
+}
+
+/**
+ * Inserts at idx (0 <= idx <= length), moving the following items up.
+ */
+template< class ItemType, uint32 INLINE_CAPACITY >
+template< class... Args >
+ItemType& SmallVector< ItemType, INLINE_CAPACITY >::emplaceAt(uint32 idx, Args&&... args) {
+    SA_ASSERT(idx <= length, "Index out of bounds!");
+
+    if (idx == length) {
+        return emplace(std::forward< Args >(args)...);
+    }
+
+    ItemType item(std::forward< Args >(args)...);
+
+    emplace(std::move(items[length - 1]));
+    for (uint32 i = length - 2; i > idx; i--) {
+        items[i] = std::move(items[i - 1]);
+    }
+    items[idx] = std::move(item);
+
+    return items[idx];
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::tryAdd(const ItemType& item) {
+    return tryEmplace(item);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::tryAdd(ItemType&& item) {
+    return tryEmplace(std::move(item));
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+template< class... Args >
+bool SmallVector< ItemType, INLINE_CAPACITY >::tryEmplace(Args&&... args) {
+    if (length == capacity && !_grow(capacity + 1)) return false;
+
+    emplace(std::forward< Args >(args)...);
+
+    return true;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+void SmallVector< ItemType, INLINE_CAPACITY >::removeAt(uint32 idx) {
+    SA_ASSERT(idx < length, "Index out of bounds!");
+
+    for (uint32 i = idx; i < length - 1; i++) {
+        items[i] = std::move(items[i + 1]);
+    }
+
+    length--;
+    items[length].~ItemType();
+}
+
+/**
+ * Destroys the items but keeps the storage, like std::vector::clear.
+ */
+template< class ItemType, uint32 INLINE_CAPACITY >
+void SmallVector< ItemType, INLINE_CAPACITY >::clear(void) {
+    if constexpr (!std::is_trivially_destructible_v< ItemType >) {
+        for (uint32 idx = 0; idx < length; idx++) {
+            items[idx].~ItemType();
+        }
+    }
+    length = 0;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::reserve(uint32 nbItems) {
+    return nbItems <= capacity || _grow(nbItems);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+ItemType* SmallVector< ItemType, INLINE_CAPACITY >::_allocate(uint32 nbItems) {
+    if (nbItems > 0xFFFFFFFFu / sizeof(ItemType)) {
+        return nullptr;
+    }
+
+    uint32 bytes = nbItems * sizeof(ItemType);
+
+    if (allocator != nullptr) {
+        return (ItemType*) allocator->allocAligned(bytes, alignof(ItemType));
+    }
+
+    return (ItemType*) ::operator new(bytes, std::align_val_t(alignof(ItemType)), std::nothrow);
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+void SmallVector< ItemType, INLINE_CAPACITY >::_release(ItemType* block) {
+    if (allocator != nullptr) {
+        allocator->dealloc(block);
+    } else {
+        ::operator delete((void*) block, std::align_val_t(alignof(ItemType)));
+    }
+}
+
+/**
+ * Moves the items into a block of at least minCapacity slots, and at least twice the current
+ * capacity (saturating at the uint32 limit). A pooled block of trivially copyable items first
+ * tries to grow in place.
+ */
+template< class ItemType, uint32 INLINE_CAPACITY >
+bool SmallVector< ItemType, INLINE_CAPACITY >::_grow(uint32 minCapacity) {
+    uint32 newCapacity = capacity <= 0xFFFFFFFFu / 2 ? capacity * 2 : 0xFFFFFFFFu;
+    if (newCapacity < minCapacity) {
+        newCapacity = minCapacity;
+    }
+    if (newCapacity <= capacity) {
+        return false;
+    }
+
+    if constexpr (std::is_trivially_copyable_v< ItemType >) {
+        if (allocator != nullptr && !isInline() && allocator->tryResizeInPlace(items, newCapacity * sizeof(ItemType))) {
+            capacity = newCapacity;
+            return true;
+        }
+    }
+
+    ItemType* grown = _allocate(newCapacity);
+    if (grown == nullptr) {
+        return false;
+    }
+
+    for (uint32 idx = 0; idx < length; idx++) {
+        new (&grown[idx]) ItemType(std::move(items[idx]));
+        items[idx].~ItemType();
+    }
+
+    if (!isInline()) {
+        _release(items);
+    }
+
+    items    = grown;
+    capacity = newCapacity;
+    return true;
+}
+
+template< class ItemType, uint32 INLINE_CAPACITY >
+void SmallVector< ItemType, INLINE_CAPACITY >::_ensureGrown(void) {
+    if (length < capacity) {
+        return;
+    }
+
+    bool grown = _grow(capacity + 1);
+    SA_ASSERT(grown, "Out of memory!");
+    if (!grown) throw std::bad_alloc();
+}
+
+#endif // small_vector_hpp
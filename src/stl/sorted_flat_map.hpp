@@ -0,0 +1,356 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef sorted_flat_map_hpp
+#define sorted_flat_map_hpp
+
+#include "common.hpp"
+#include "./small_vector.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(__AVX2__)
+#    include <immintrin.h>
+#endif // __AVX2__
+
+/**
+ * SortKeyPrefix - Order preserving 8 byte summary of a key, used by SortedFlatMap.
+ *
+ * prefix(a) < prefix(b) must imply a < b. When EXACT is true the prefix is the whole key
+ * (equal prefixes mean equal keys), otherwise ties are settled by comparing the keys.
+ * Specialize it to use a custom key type.
+ */
+template< class KeyType, class Enable = void >
+struct SortKeyPrefix;
+
+template< class KeyType >
+struct SortKeyPrefix< KeyType, std::enable_if_t< std::is_integral_v< KeyType > || std::is_enum_v< KeyType > > > {
+    static constexpr bool EXACT = sizeof(KeyType) <= sizeof(uint64);
+
+    uint64 operator () (KeyType key) const {
+        if constexpr (std::is_enum_v< KeyType >) {
+            return SortKeyPrefix< std::underlying_type_t< KeyType > >()((std::underlying_type_t< KeyType >) key);
+        } else if constexpr (std::is_signed_v< KeyType >) {
+            // Flip the sign bit so negative keys sort first as unsigned
+            return (uint64)(long long) key ^ 0x8000000000000000ull;
+        } else {
+            return (uint64) key;
+        }
+    }
+};
+
+/** The first 8 bytes, big endian and zero padded: integer order is the lexicographic order. */
+inline uint64 stringSortPrefix(const char* data, ulong length) {
+    uint8 bytes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    ::memcpy(bytes, data, length < 8 ? length : 8);
+
+    uint64 prefix;
+    ::memcpy(&prefix, bytes, sizeof(prefix));
+    return __builtin_bswap64(prefix);
+}
+
+template<>
+struct SortKeyPrefix< std::string > {
+    static constexpr bool EXACT = false;
+
+    uint64 operator () (const std::string& key) const {
+        return stringSortPrefix(key.data(), key.size());
+    }
+};
+
+template<>
+struct SortKeyPrefix< std::string_view > {
+    static constexpr bool EXACT = false;
+
+    uint64 operator () (std::string_view key) const {
+        return stringSortPrefix(key.data(), key.size());
+    }
+};
+
+/**
+ * SortedFlatMap - Read-mostly map kept sorted in flat arrays (MIME types, route metadata,
+ * configuration...).
+ *
+ * Entries are split in three parallel arrays: the key prefixes, the keys and the values.
+ * A lookup runs a branchless binary search on the prefixes alone (8 byte integer compares,
+ * conditional moves instead of mispredicted branches) and finishes with a vectorized count
+ * over the last few prefixes; the keys themselves are only compared when prefixes tie.
+ *
+ * Build big tables at once with build() (one sort); add/remove keep the order by shifting and
+ * are meant for small or rarely modified tables. Like AssociativeContainer, adding an
+ * existing key leaves its value untouched.
+ */
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY = 8, class Prefix = SortKeyPrefix< KeyType > >
+struct SortedFlatMap {
+    enum { LINEAR_WINDOW = 8 };
+
+    static constexpr uint32 NOT_FOUND = 0xFFFFFFFFu;
+
+    SmallVector< uint64, INLINE_CAPACITY >     prefixes;
+    SmallVector< KeyType, INLINE_CAPACITY >    keys;
+    SmallVector< ValueType, INLINE_CAPACITY >  values;
+
+    SortedFlatMap();
+    explicit SortedFlatMap(PoolAllocator* poolAlloc);
+
+    void             build(const KeyType sourceKeys[], const ValueType sourceValues[], uint32 nbItems);
+    ValueType&       add(const KeyType& key, const ValueType& value);
+
+    /** Query family functions... */
+    bool             exists(const KeyType& key) const;
+    uint32           indexOf(const KeyType& key) const;
+    ValueType*       find(const KeyType& key);
+    const ValueType* find(const KeyType& key) const;
+    ValueType&       at(const KeyType& key);
+    const ValueType& at(const KeyType& key) const;
+    ValueType&       getValue(const KeyType& key);
+    const ValueType& getValue(const KeyType& key) const;
+    const KeyType&   getKeyAt(uint32 idx) const;
+    ValueType&       getValueAt(uint32 idx);
+    const ValueType& getValueAt(uint32 idx) const;
+    uint32           length(void) const;
+
+    /** Modify family functions... */
+    bool             remove(const KeyType& key);
+    void             clear(void);
+
+private:
+    uint32           _lowerBound(uint64 prefix) const;
+    uint32           _position(const KeyType& key, uint64 prefix, bool& found) const;
+};
+
+/**
+ * Number of prefixes below target among the first count ones (count <= LINEAR_WINDOW).
+ * Prefixes are stored biased by the sign bit so a signed compare orders them as unsigned.
+ */
+inline uint32 sortedPrefixCountBelow(const uint64* prefixes, uint32 count, uint64 target) {
+#if defined(__AVX2__)
+    if (count == 8) {
+        const __m256i bias  = _mm256_set1_epi64x((long long) 0x8000000000000000ull);
+        const __m256i limit = _mm256_xor_si256(_mm256_set1_epi64x((long long) target), bias);
+        __m256i low  = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) prefixes), bias);
+        __m256i high = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(prefixes + 4)), bias);
+
+        uint32 lowMask  = (uint32) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(limit, low)));
+        uint32 highMask = (uint32) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(limit, high)));
+        return (uint32) __builtin_popcount(lowMask | (highMask << 4));
+    }
+#endif // __AVX2__
+
+    uint32 below = 0;
+    for (uint32 i = 0; i < count; ++i) {
+        below += prefixes[i] < target;
+    }
+    return below;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::SortedFlatMap() {}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::SortedFlatMap(PoolAllocator* poolAlloc)
+    : prefixes(poolAlloc), keys(poolAlloc), values(poolAlloc) {}
+
+/**
+ * Branchless lower bound: halves the range with a conditional move until LINEAR_WINDOW
+ * candidates are left, then counts them.
+ */
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+uint32 SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::_lowerBound(uint64 prefix) const {
+    const uint64* base      = prefixes.items;
+    uint32        remaining = prefixes.length;
+
+    while (remaining > LINEAR_WINDOW) {
+        uint32 half = remaining / 2;
+        base        = base[half - 1] < prefix ? base + half : base;
+        remaining  -= half;
+    }
+
+    return (uint32)(base - prefixes.items) + sortedPrefixCountBelow(base, remaining, prefix);
+}
+
+/**
+ * Where key is, or would be inserted. Ties on the prefix are settled by the full keys.
+ */
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+uint32 SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::_position(const KeyType& key, uint64 prefix, bool& found) const {
+    uint32 idx = _lowerBound(prefix);
+
+    if constexpr (Prefix::EXACT) {
+        found = idx < prefixes.length && prefixes.items[idx] == prefix;
+        return idx;
+    }
+
+    // Keys sharing a prefix ("application/...") form a run: binary search it on the full keys
+    uint32 runEnd = prefix == ~0ull ? prefixes.length : _lowerBound(prefix + 1);
+    idx           = (uint32)(std::lower_bound(keys.items + idx, keys.items + runEnd, key) - keys.items);
+
+    found = idx < runEnd && keys.items[idx] == key;
+    return idx;
+}
+
+/**
+ * Replaces the content by nbItems entries sorted at once. When a key repeats its first
+ * value is kept, as add would.
+ */
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+void SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::build(
+    const KeyType sourceKeys[], const ValueType sourceValues[], uint32 nbItems) {
+
+    clear();
+
+    SmallVector< uint64, 64 > sourcePrefixes;
+    SmallVector< uint32, 64 > order;
+    if (!sourcePrefixes.reserve(nbItems) || !order.reserve(nbItems)) throw std::bad_alloc();
+
+    for (uint32 idx = 0; idx < nbItems; idx++) {
+        sourcePrefixes.add(Prefix()(sourceKeys[idx]));
+        order.add(idx);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](uint32 lhs, uint32 rhs) {
+        if (sourcePrefixes.items[lhs] != sourcePrefixes.items[rhs]) {
+            return sourcePrefixes.items[lhs] < sourcePrefixes.items[rhs];
+        }
+        if constexpr (Prefix::EXACT) {
+            return false;
+        } else {
+            return sourceKeys[lhs] < sourceKeys[rhs];
+        }
+    });
+
+    if (!prefixes.reserve(nbItems) || !keys.reserve(nbItems) || !values.reserve(nbItems)) throw std::bad_alloc();
+
+    for (uint32 pos = 0; pos < nbItems; pos++) {
+        uint32 idx = order.items[pos];
+
+        if (pos > 0 && prefixes.items[prefixes.length - 1] == sourcePrefixes.items[idx]
+            && (Prefix::EXACT || keys.items[keys.length - 1] == sourceKeys[idx])) {
+            continue;
+        }
+
+        prefixes.add(sourcePrefixes.items[idx]);
+        keys.add(sourceKeys[idx]);
+        values.add(sourceValues[idx]);
+    }
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::add(const KeyType& key, const ValueType& value) {
+    uint64 prefix = Prefix()(key);
+    bool   found;
+    uint32 idx    = _position(key, prefix, found);
+
+    if (found) {
+        return values.items[idx];
+    }
+
+    prefixes.addAt(idx, prefix);
+    keys.addAt(idx, key);
+    return values.addAt(idx, value);
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+uint32 SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::indexOf(const KeyType& key) const {
+    bool   found;
+    uint32 idx = _position(key, Prefix()(key), found);
+    return found ? idx : NOT_FOUND;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+bool SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::exists(const KeyType& key) const {
+    return indexOf(key) != NOT_FOUND;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+ValueType* SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::find(const KeyType& key) {
+    uint32 idx = indexOf(key);
+    return idx != NOT_FOUND ? &values.items[idx] : nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+const ValueType* SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::find(const KeyType& key) const {
+    uint32 idx = indexOf(key);
+    return idx != NOT_FOUND ? &values.items[idx] : nullptr;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::at(const KeyType& key) {
+    ValueType* value = find(key);
+
+    if (value != nullptr) {
+        return *value;
+    }
+
+    static ValueType dummy;
+    return dummy;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+const ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::at(const KeyType& key) const {
+    const ValueType* value = find(key);
+
+    if (value != nullptr) {
+        return *value;
+    }
+
+    static ValueType dummy;
+    return dummy;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::getValue(const KeyType& key) {
+    return at(key);
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+const ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::getValue(const KeyType& key) const {
+    return at(key);
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+const KeyType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::getKeyAt(uint32 idx) const {
+    return keys.at(idx);
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::getValueAt(uint32 idx) {
+    return values.at(idx);
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+const ValueType& SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::getValueAt(uint32 idx) const {
+    return values.at(idx);
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+uint32 SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::length(void) const {
+    return keys.length;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+bool SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::remove(const KeyType& key) {
+    uint32 idx = indexOf(key);
+
+    if (idx == NOT_FOUND) {
+        return false;
+    }
+
+    prefixes.removeAt(idx);
+    keys.removeAt(idx);
+    values.removeAt(idx);
+    return true;
+}
+
+template< class KeyType, class ValueType, uint32 INLINE_CAPACITY, class Prefix >
+void SortedFlatMap< KeyType, ValueType, INLINE_CAPACITY, Prefix >::clear(void) {
+    prefixes.clear();
+    keys.clear();
+    values.clear();
+}
+
+#endif // sorted_flat_map_hpp
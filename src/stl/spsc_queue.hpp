@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2025 Kevin Daniel Taylor
+ * Licensed under the MIT License (see the LICENSE file in the project root).
+ */
+#ifndef spsc_queue_hpp
+#define spsc_queue_hpp
+
+#include "common.hpp"
+
+#include <atomic>
+#include <new>
+#include <utility>
+
+/**
+ * SpscQueue - Lock-free FIFO ring between exactly one producer thread and one consumer thread
+ * (acceptor -> worker, worker -> logger).
+ *
+ * head and tail are free running counters masked into the ring, so all CAPACITY slots are
+ * usable and no modulo is needed. Each side owns one cache line: its own index plus a cached
+ * copy of the other side's index, refreshed only when it shows fewer free (producer) or
+ * ready (consumer) slots than the operation wants. In the steady state an operation touches
+ * no line the other side writes.
+ *
+ * Only the producer may call enqueue/emplace/enqueueBulk, only the consumer
+ * dequeue/dequeueBulk; length and isEmpty are snapshots.
+ */
+template< class ItemType, uint32 CAPACITY = 1024 >
+struct SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+    static constexpr uint32 MASK           = CAPACITY - 1;
+    static constexpr uint32 CACHELINE_SIZE = 64;
+
+    SpscQueue();
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator = (const SpscQueue&) = delete;
+    ~SpscQueue();
+
+    /** Producer side... */
+    bool     enqueue(const ItemType& item);
+    bool     enqueue(ItemType&& item);
+    template< class... Args >
+    bool     emplace(Args&&... args);
+    uint32   enqueueBulk(const ItemType items[], uint32 nbItems);
+
+    /** Consumer side... */
+    bool     dequeue(ItemType& item);
+    uint32   dequeueBulk(ItemType items[], uint32 maxItems);
+
+    uint32   length(void) const;
+    bool     isEmpty(void) const;
+
+    alignas(CACHELINE_SIZE) std::atomic< uint32 > head{0};
+    uint32                                      cachedTail = 0;
+
+    alignas(CACHELINE_SIZE) std::atomic< uint32 > tail{0};
+    uint32                                      cachedHead = 0;
+
+    union alignas(CACHELINE_SIZE) {
+        ItemType                                ring[CAPACITY];
+    };
+
+private:
+    uint32   _freeSlots(uint32 position, uint32 wanted);
+    uint32   _readySlots(uint32 position, uint32 wanted);
+};
+
+template< class ItemType, uint32 CAPACITY >
+SpscQueue< ItemType, CAPACITY >::SpscQueue() {}
+
+template< class ItemType, uint32 CAPACITY >
+SpscQueue< ItemType, CAPACITY >::~SpscQueue() {
+    uint32 last = head.load(std::memory_order_acquire);
+
+    for (uint32 position = tail.load(std::memory_order_relaxed); position != last; position++) {
+        ring[position & MASK].~ItemType();
+    }
+}
+
+/**
+ * Slots the producer may fill from position, rereading the consumer index only when the
+ * cached one leaves fewer than wanted.
+ */
+template< class ItemType, uint32 CAPACITY >
+inline uint32 SpscQueue< ItemType, CAPACITY >::_freeSlots(uint32 position, uint32 wanted) {
+    uint32 free = CAPACITY - (position - cachedTail);
+
+    if (free < wanted) {
+        cachedTail = tail.load(std::memory_order_acquire);
+        free       = CAPACITY - (position - cachedTail);
+    }
+
+    return free;
+}
+
+template< class ItemType, uint32 CAPACITY >
+inline uint32 SpscQueue< ItemType, CAPACITY >::_readySlots(uint32 position, uint32 wanted) {
+    uint32 ready = cachedHead - position;
+
+    if (ready < wanted) {
+        cachedHead = head.load(std::memory_order_acquire);
+        ready      = cachedHead - position;
+    }
+
+    return ready;
+}
+
+template< class ItemType, uint32 CAPACITY >
+bool SpscQueue< ItemType, CAPACITY >::enqueue(const ItemType& item) {
+    return emplace(item);
+}
+
+template< class ItemType, uint32 CAPACITY >
+bool SpscQueue< ItemType, CAPACITY >::enqueue(ItemType&& item) {
+    return emplace(std::move(item));
+}
+
+template< class ItemType, uint32 CAPACITY >
+template< class... Args >
+bool SpscQueue< ItemType, CAPACITY >::emplace(Args&&... args) {
+    uint32 position = head.load(std::memory_order_relaxed);
+
+    if (_freeSlots(position, 1) == 0) {
+        return false;
+    }
+
+    new (&ring[position & MASK]) ItemType(std::forward< Args >(args)...);
+    head.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * Copies as many of items as fit and publishes them with a single store. Returns how many
+ * were enqueued.
+ */
+template< class ItemType, uint32 CAPACITY >
+uint32 SpscQueue< ItemType, CAPACITY >::enqueueBulk(const ItemType items[], uint32 nbItems) {
+    uint32 position = head.load(std::memory_order_relaxed);
+    uint32 free     = _freeSlots(position, nbItems);
+    uint32 count    = nbItems < free ? nbItems : free;
+
+    for (uint32 idx = 0; idx < count; idx++) {
+        new (&ring[(position + idx) & MASK]) ItemType(items[idx]);
+    }
+
+    if (count > 0) {
+        head.store(position + count, std::memory_order_release);
+    }
+
+    return count;
+}
+
+template< class ItemType, uint32 CAPACITY >
+bool SpscQueue< ItemType, CAPACITY >::dequeue(ItemType& item) {
+    uint32 position = tail.load(std::memory_order_relaxed);
+
+    if (_readySlots(position, 1) == 0) {
+        return false;
+    }
+
+    ItemType& slot = ring[position & MASK];
+    item = std::move(slot);
+    slot.~ItemType();
+    tail.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * Moves up to maxItems items out and releases their slots with a single store. Returns how
+ * many were dequeued.
+ */
+template< class ItemType, uint32 CAPACITY >
+uint32 SpscQueue< ItemType, CAPACITY >::dequeueBulk(ItemType items[], uint32 maxItems) {
+    uint32 position = tail.load(std::memory_order_relaxed);
+    uint32 ready    = _readySlots(position, maxItems);
+    uint32 count    = maxItems < ready ? maxItems : ready;
+
+    for (uint32 idx = 0; idx < count; idx++) {
+        ItemType& slot = ring[(position + idx) & MASK];
+        items[idx] = std::move(slot);
+        slot.~ItemType();
+    }
+
+    if (count > 0) {
+        tail.store(position + count, std::memory_order_release);
+    }
+
+    return count;
+}
+
+template< class ItemType, uint32 CAPACITY >
+uint32 SpscQueue< ItemType, CAPACITY >::length(void) const {
+    // tail first: it can only grow towards head, so the difference never goes negative
+    uint32 position = tail.load(std::memory_order_acquire);
+    return head.load(std::memory_order_acquire) - position;
+}
+
+template< class ItemType, uint32 CAPACITY >
+bool SpscQueue< ItemType, CAPACITY >::isEmpty(void) const {
+    return length() == 0;
+}
+
+#endif // spsc_queue_hpp
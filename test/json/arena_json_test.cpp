@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/json/arena_json.hpp"
+
+TEST(ArenaJsonTest, ParsesIntoTheArena) {
+    MonotonicArena arena;
+    {
+        ArenaScope scope(arena);
+
+        ArenaJson doc = ArenaJson::parse(R"({"id": 123, "name": "Kevin", "active": true, "tags": ["a", "b", "c"],
+                                            "nested": {"long": "a string long enough to leave the small buffer"}})");
+
+        ASSERT_EQ(doc["id"].get< long long >(), 123);
+        ASSERT_EQ(doc["name"].get< ArenaString >(), "Kevin");
+        ASSERT_EQ(doc["tags"].size(), 3u);
+        ASSERT_TRUE(doc["active"].get< bool >());
+        ASSERT_GT(arena.bytesUsed(), 0u);
+
+        doc["extra"] = ArenaJson::array({ 1, 2 });
+        ASSERT_EQ(doc["extra"].dump(), "[1,2]");
+        ASSERT_EQ(ArenaJson::parse(doc.dump()), doc);
+    }
+
+    arena.reset();
+    ASSERT_EQ(arena.bytesUsed(), 0u);
+}
+
+TEST(ArenaJsonTest, NeedsABoundArena) {
+    // Bound rather than cast to void: GCC ignores the cast for warn_unused_result
+    ASSERT_THROW({ ArenaJson doc = ArenaJson::parse(R"({"a": [1, 2, 3]})"); (void) doc; }, std::bad_alloc);
+}
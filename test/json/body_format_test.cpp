@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "../../src/json/body_format.hpp"
+#include "../../src/json/json_binding.hpp"
+
+TEST(BodyFormatTest, NegotiatesContentType) {
+    ASSERT_EQ(bodyFormatOfContentType(""), BODY_FORMAT_JSON);
+    ASSERT_EQ(bodyFormatOfContentType("application/json; charset=utf-8"), BODY_FORMAT_JSON);
+    ASSERT_EQ(bodyFormatOfContentType("application/problem+json"), BODY_FORMAT_JSON);
+    ASSERT_EQ(bodyFormatOfContentType(" Application/CBOR "), BODY_FORMAT_CBOR);
+    ASSERT_EQ(bodyFormatOfContentType("application/msgpack"), BODY_FORMAT_MSGPACK);
+    ASSERT_EQ(bodyFormatOfContentType("application/x-msgpack"), BODY_FORMAT_MSGPACK);
+    ASSERT_EQ(bodyFormatOfContentType("application/vnd.msgpack"), BODY_FORMAT_MSGPACK);
+    ASSERT_EQ(bodyFormatOfContentType("text/plain"), BODY_FORMAT_UNSUPPORTED);
+    ASSERT_EQ(bodyFormatOfContentType("application/x-www-form-urlencoded"), BODY_FORMAT_UNSUPPORTED);
+}
+
+TEST(BodyFormatTest, NegotiatesAccept) {
+    ASSERT_EQ(bodyFormatForAccept(""), BODY_FORMAT_JSON);
+    ASSERT_EQ(bodyFormatForAccept("*/*"), BODY_FORMAT_JSON);
+    ASSERT_EQ(bodyFormatForAccept("application/cbor"), BODY_FORMAT_CBOR);
+    ASSERT_EQ(bodyFormatForAccept("application/cbor, */*"), BODY_FORMAT_CBOR);
+    ASSERT_EQ(bodyFormatForAccept("text/html, application/msgpack;q=0.9, */*;q=0.1"), BODY_FORMAT_MSGPACK);
+    ASSERT_EQ(bodyFormatForAccept("application/json;q=0.5, application/cbor;q=0.8"), BODY_FORMAT_CBOR);
+    ASSERT_EQ(bodyFormatForAccept("application/cbor;q=0, application/*;q=0.2"), BODY_FORMAT_JSON);
+    ASSERT_EQ(bodyFormatForAccept("text/html"), BODY_FORMAT_UNSUPPORTED);
+    ASSERT_EQ(bodyFormatForAccept("application/json;q=0"), BODY_FORMAT_UNSUPPORTED);
+}
+
+struct BodyLine {
+    String              sku;
+    long long           qty   = 0;
+    double              price = 0;
+};
+SA_JSON_BINDING(BodyLine,
+    SA_JSON_FIELD(BodyLine, sku),
+    SA_JSON_FIELD(BodyLine, qty),
+    SA_JSON_FIELD(BodyLine, price))
+
+struct BodyOrder {
+    unsigned long long      id = 0;
+    bool                    paid = false;
+    std::vector< BodyLine > lines;
+    std::vector< int >      flags;
+};
+SA_JSON_BINDING(BodyOrder,
+    SA_JSON_FIELD(BodyOrder, id),
+    SA_JSON_FIELD(BodyOrder, paid),
+    SA_JSON_FIELD(BodyOrder, lines),
+    SA_JSON_FIELD(BodyOrder, flags))
+
+static BodyOrder makeOrder(void) {
+    BodyOrder order;
+    order.id    = 18446744073709551615ull;
+    order.paid  = true;
+    order.lines = { { "A-1", 3, 19.99 }, { String(300, 'x'), -70000, 0.5 }, { "\xC3\xA9t\xC3\xA9", -1, -1e300 } };
+    order.flags = { 0, 23, 24, 255, 256, 65536, -1, -24, -25, -129, -40000, 2147483647 };
+    return order;
+}
+
+TEST(BodyFormatTest, RoundTripsEveryFormat) {
+    BodyOrder  order = makeOrder();
+    BodyFormat formats[] = { BODY_FORMAT_JSON, BODY_FORMAT_CBOR, BODY_FORMAT_MSGPACK };
+
+    for (BodyFormat format : formats) {
+        String body;
+        bodyWrite(body, format, order);
+
+        BodyOrder     back;
+        JsonReadError error;
+        ASSERT_TRUE(bodyRead(body, format, back, &error)) << format << " " << (error.reason ? error.reason : "");
+
+        ASSERT_EQ(back.id, order.id);
+        ASSERT_EQ(back.paid, order.paid);
+        ASSERT_EQ(back.flags, order.flags);
+        ASSERT_EQ(back.lines.size(), order.lines.size());
+        for (size_t idx = 0; idx < order.lines.size(); idx++) {
+            ASSERT_EQ(back.lines[idx].sku, order.lines[idx].sku);
+            ASSERT_EQ(back.lines[idx].qty, order.lines[idx].qty);
+            ASSERT_EQ(back.lines[idx].price, order.lines[idx].price);
+        }
+    }
+}
+
+TEST(BodyFormatTest, InteroperatesWithNlohmann) {
+    String json;
+    String cbor;
+    String msgpack;
+    bodyWrite(json, BODY_FORMAT_JSON, makeOrder());
+    bodyWrite(cbor, BODY_FORMAT_CBOR, makeOrder());
+    bodyWrite(msgpack, BODY_FORMAT_MSGPACK, makeOrder());
+
+    // What we write, nlohmann reads as the same document
+    nlohmann::json expected = nlohmann::json::parse(json);
+    ASSERT_EQ(nlohmann::json::from_cbor(cbor), expected);
+    ASSERT_EQ(nlohmann::json::from_msgpack(msgpack), expected);
+
+    // What nlohmann writes, we read
+    std::vector< uint8 > fromCbor    = nlohmann::json::to_cbor(expected);
+    std::vector< uint8 > fromMsgpack = nlohmann::json::to_msgpack(expected);
+    JsonTape             tape;
+
+    ASSERT_TRUE(tape.parseCbor(std::string_view((const char*) fromCbor.data(), fromCbor.size())));
+    ASSERT_EQ(tape.root().toNlohmann(), expected);
+    ASSERT_TRUE(tape.parseMsgpack(std::string_view((const char*) fromMsgpack.data(), fromMsgpack.size())));
+    ASSERT_EQ(tape.root().toNlohmann(), expected);
+
+    // Binary bodies are smaller
+    ASSERT_LT(cbor.size(), json.size());
+    ASSERT_LT(msgpack.size(), json.size());
+}
+
+TEST(BodyFormatTest, DecodesCborEncoderChoices) {
+    // Indefinite map holding an indefinite array and a chunked string, a tagged value, a half float
+    std::string body("\xBF\x61" "a" "\x9F\x01\xF9\x3E\x00\xFF\x61" "b" "\x7F\x62" "ca" "\x61" "t\xFF\x61" "c" "\xC1\x1A\x00\x01\x00\x00\xFF", 27);
+    JsonTape    tape;
+
+    ASSERT_TRUE(tape.parseCbor(body)) << tape.error();
+    ASSERT_EQ(tape.root().toNlohmann(), nlohmann::json::parse(R"({"a": [1, 1.5], "b": "cat", "c": 65536})"));
+    ASSERT_EQ(tape.root().size(), 3u);
+
+    ASSERT_FALSE(tape.parseCbor(body.substr(0, body.size() - 1)));
+    ASSERT_FALSE(tape.parseCbor(std::string_view("\x9F\x01", 2)));
+    ASSERT_FALSE(tape.parseCbor(std::string_view("\x81\xFF", 2)));
+    ASSERT_FALSE(tape.parseCbor(std::string_view("\xBF\x61" "a" "\xFF", 4)));
+    ASSERT_FALSE(tape.parseCbor(std::string_view("\xF9\x7C\x00", 3)));      // infinity
+    ASSERT_FALSE(tape.parseCbor(std::string_view("\x9A\xFF\xFF\xFF\xFF", 5)));
+}
+
+TEST(BodyFormatTest, RejectsMalformedBinaryBodies) {
+    String cbor;
+    bodyWrite(cbor, BODY_FORMAT_CBOR, makeOrder());
+
+    BodyOrder     order;
+    JsonReadError error;
+    ASSERT_FALSE(bodyRead(std::string_view(cbor).substr(0, cbor.size() - 1), BODY_FORMAT_CBOR, order, &error));
+    ASSERT_STREQ(error.reason, "is not valid JSON");
+    ASSERT_FALSE(bodyRead(cbor + '\x01', BODY_FORMAT_CBOR, order, &error));
+    ASSERT_FALSE(bodyRead("", BODY_FORMAT_MSGPACK, order, &error));
+
+    JsonTape tape;
+    ASSERT_FALSE(tape.parseCbor("\x41\x01"));               // byte string
+    ASSERT_FALSE(tape.parseCbor("\x62\xC3\x28"));           // text string, invalid UTF-8
+    ASSERT_FALSE(tape.parseMsgpack(std::string_view("\x81\x01\x02", 3)));   // integer key
+
+    std::string deep(JsonTape::MAX_DEPTH, '\x81');
+    deep += '\x80';
+    ASSERT_FALSE(tape.parseCbor(deep));
+    ASSERT_TRUE(tape.parseCbor(deep.substr(1)));
+
+    // Schema errors name the field, as for JSON
+    String wrong;
+    JsonBinaryWriter writer(wrong, BODY_FORMAT_MSGPACK);
+    writer.beginObject(4).key("id").value("x").key("paid").value(true).key("lines").beginArray(0).key("flags").beginArray(0);
+    ASSERT_FALSE(bodyRead(wrong, BODY_FORMAT_MSGPACK, order, &error));
+    ASSERT_EQ(error.field, "id");
+    ASSERT_STREQ(error.reason, "has the wrong type");
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include "../../src/json/fast_number.hpp"
+
+static bool parse(std::string_view text, JsonNumber& number) {
+    return jsonParseNumber(text.data(), text.data() + text.size(), number) == text.data() + text.size();
+}
+
+static void expectDouble(const std::string& text) {
+    JsonNumber number;
+    ASSERT_TRUE(parse(text, number)) << text;
+    ASSERT_EQ(number.kind, JSON_NUMBER_DOUBLE) << text;
+
+    double expected = std::strtod(text.c_str(), nullptr);
+    ASSERT_EQ(std::memcmp(&number.asDouble, &expected, sizeof(double)), 0) << text << " " << number.asDouble;
+}
+
+TEST(FastNumberTest, ParsesIntegers) {
+    JsonNumber number;
+
+    ASSERT_TRUE(parse("0", number));
+    ASSERT_EQ(number.kind, JSON_NUMBER_INT64);
+    ASSERT_EQ(number.asInt64, 0);
+    ASSERT_TRUE(parse("12345678", number));
+    ASSERT_EQ(number.asInt64, 12345678);
+    ASSERT_TRUE(parse("-1234567890123456789", number));
+    ASSERT_EQ(number.asInt64, -1234567890123456789ll);
+    ASSERT_TRUE(parse("9223372036854775807", number));
+    ASSERT_EQ(number.asInt64, 9223372036854775807ll);
+    ASSERT_TRUE(parse("-9223372036854775808", number));
+    ASSERT_EQ(number.kind, JSON_NUMBER_INT64);
+    ASSERT_EQ(number.asInt64, std::numeric_limits< long long >::min());
+
+    ASSERT_TRUE(parse("9223372036854775808", number));
+    ASSERT_EQ(number.kind, JSON_NUMBER_UINT64);
+    ASSERT_EQ(number.asUint64, 9223372036854775808ull);
+    ASSERT_TRUE(parse("18446744073709551615", number));
+    ASSERT_EQ(number.kind, JSON_NUMBER_UINT64);
+    ASSERT_EQ(number.asUint64, 18446744073709551615ull);
+
+    // Out of every integer range: a double, as in nlohmann
+    ASSERT_TRUE(parse("18446744073709551616", number));
+    ASSERT_EQ(number.kind, JSON_NUMBER_DOUBLE);
+    ASSERT_EQ(number.asDouble, 18446744073709551616.0);
+    ASSERT_TRUE(parse("-9223372036854775809", number));
+    ASSERT_EQ(number.kind, JSON_NUMBER_DOUBLE);
+
+    std::mt19937_64 rng(7);
+    for (uint32 round = 0; round < 100000; round++) {
+        long long   value = (long long)(rng() >> (rng() % 64));
+        if (round & 1) value = -value;
+        std::string text  = std::to_string(value);
+
+        ASSERT_TRUE(parse(text, number)) << text;
+        ASSERT_EQ(number.kind, JSON_NUMBER_INT64) << text;
+        ASSERT_EQ(number.asInt64, value) << text;
+    }
+}
+
+TEST(FastNumberTest, RoundsDoublesCorrectly) {
+    const char* edges[] = {
+        "0.0", "-0.0", "1.5", "0.1", "3.25e3", "1e22", "1e23", "9007199254740993.0", "9007199254740995e0",
+        "2.2250738585072011e-308", "2.2250738585072014e-308", "1.7976931348623157e308", "4.9e-324",
+        "2.4703282292062327e-324", "2.4703282292062328e-324", "1e-400", "0.000000000000000000000000000001",
+        "123456789012345678901234567890.5", "0.30000000000000004", "7.038531e-26", "1448997445238699e0",
+        "179769313486231580793728971405303415079934132710037826936173778980444968292764750946649017977587207096330286416692887910946555547851940402630657488671505820681908902000708383676273854845817711531764475730270069855571366959622842914819860834936475292719074168444365510704342711559699508093042880177904174497791.9999999999999999999999999999999999999999999999999999999999999999999999"
+    };
+
+    for (const char* text : edges) {
+        expectDouble(text);
+    }
+
+    std::mt19937_64 rng(11);
+    char            text[64];
+
+    for (uint32 round = 0; round < 200000; round++) {
+        uint64 bits = rng();
+        double value;
+        ::memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) continue;
+
+        ::snprintf(text, sizeof(text), (round % 3 == 0) ? "%.17g" : (round % 3 == 1) ? "%.6e" : "%.15g", value);
+        if (std::strpbrk(text, ".e") == nullptr) ::strcat(text, ".0");
+        expectDouble(text);
+    }
+
+    for (uint32 round = 0; round < 100000; round++) {
+        ::snprintf(text, sizeof(text), "%llu.%04llue%d", (unsigned long long)(rng() % 100000000), (unsigned long long)(rng() % 10000),
+                   (int)(rng() % 80) - 40);
+        expectDouble(text);
+    }
+}
+
+TEST(FastNumberTest, RejectsWhatJsonRejects) {
+    const char* invalid[] = { "", "-", "+1", ".5", "1.", "1e", "1e+", "-e5", "1e400", "-1e400", "0x10", "1.e5" };
+
+    JsonNumber number;
+    for (const char* text : invalid) {
+        ASSERT_FALSE(parse(text, number)) << text;
+    }
+
+    // The number ends where the grammar does: the caller decides what may follow
+    std::string_view text = "012";
+    ASSERT_EQ(jsonParseNumber(text.data(), text.data() + text.size(), number), text.data() + 1);
+    text = "12345678901,";
+    ASSERT_EQ(jsonParseNumber(text.data(), text.data() + text.size(), number), text.data() + 11);
+    ASSERT_EQ(number.asInt64, 12345678901ll);
+}
+
+TEST(FastNumberTest, ConvertsWithRangeChecks) {
+    JsonNumber number;
+    uint8      small;
+    int        integer;
+    float      single;
+    double     real;
+
+    ASSERT_TRUE(parse("255", number));
+    ASSERT_TRUE(number.get(small));
+    ASSERT_EQ(small, 255);
+    ASSERT_TRUE(parse("256", number));
+    ASSERT_FALSE(number.get(small));
+    ASSERT_TRUE(parse("-1", number));
+    ASSERT_FALSE(number.get(small));
+    ASSERT_TRUE(number.get(integer));
+    ASSERT_EQ(integer, -1);
+    ASSERT_TRUE(parse("1.0", number));
+    ASSERT_FALSE(number.get(integer));
+    ASSERT_TRUE(number.get(real));
+    ASSERT_EQ(real, 1.0);
+    ASSERT_TRUE(parse("1e39", number));
+    ASSERT_FALSE(number.get(single));
+    ASSERT_TRUE(parse("18446744073709551615", number));
+    ASSERT_TRUE(number.get(real));
+    ASSERT_EQ(real, 18446744073709551615.0);
+}
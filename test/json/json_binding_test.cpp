@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/json/json_binding.hpp"
+
+struct Address {
+    String city;
+    uint32 zip = 0;
+};
+SA_JSON_BINDING(Address,
+    SA_JSON_FIELD(Address, city),
+    SA_JSON_FIELD(Address, zip))
+
+struct Person {
+    String               name;
+    long long            age    = -1;
+    double               score  = 0.0;
+    bool                 admin  = false;
+    std::vector< String > tags;
+    Address              address;
+    std::vector< Address > previous;
+};
+SA_JSON_BINDING(Person,
+    SA_JSON_FIELD(Person, name),
+    SA_JSON_FIELD(Person, age),
+    SA_JSON_FIELD(Person, score, JSON_OPTIONAL),
+    SA_JSON_FIELD(Person, admin, JSON_OPTIONAL),
+    SA_JSON_FIELD(Person, tags, JSON_OPTIONAL),
+    SA_JSON_FIELD(Person, address),
+    SA_JSON_FIELD(Person, previous, JSON_OPTIONAL))
+
+static_assert(JsonBound< Person >);
+static_assert(!JsonBound< String >);
+static_assert(jsonKeyHash("name") == std::get< 0 >(JsonBinding< Person >::fields).hash);
+
+TEST(JsonBindingTest, ReadsIntoMembers) {
+    Person person;
+    JsonReadError error;
+
+    ASSERT_TRUE(jsonRead(R"({"unknown": {"deep": [1, 2, "x"]}, "name": "Ada\nL", "age": 36,
+                            "score": 9.5, "tags": ["a", "b"], "admin": true,
+                            "address": {"zip": 75001, "city": "Paris"}, "previous": []})", person, &error));
+
+    ASSERT_EQ(person.name, "Ada\nL");
+    ASSERT_EQ(person.age, 36);
+    ASSERT_EQ(person.score, 9.5);
+    ASSERT_TRUE(person.admin);
+    ASSERT_EQ(person.tags, (std::vector< String >{ "a", "b" }));
+    ASSERT_EQ(person.address.city, "Paris");
+    ASSERT_EQ(person.address.zip, 75001u);
+    ASSERT_TRUE(person.previous.empty());
+}
+
+TEST(JsonBindingTest, PrevalidatedBodySkipsOnlyTheLazyCheck) {
+    Person      person;
+    std::string body = R"({"name": "x", "age": 7, "address": {"city": "Lyon", "zip": 69001}})";
+
+    ASSERT_TRUE(jsonRead(body, person, nullptr, JSON_BACKEND_LAZY, true));
+    ASSERT_EQ(person.age, 7);
+    ASSERT_TRUE(JsonDocument("[1, 2", true).isValid());
+    ASSERT_FALSE(JsonDocument("[1, 2").isValid());
+
+    /** The tape parses regardless, it is what builds the tape */
+    ASSERT_FALSE(jsonRead("[1, 2", person, nullptr, JSON_BACKEND_TAPE, true));
+}
+
+TEST(JsonBindingTest, OptionalFieldsKeepDefaults) {
+    Person person;
+
+    ASSERT_TRUE(jsonRead(R"({"name": "x", "age": 1, "score": null, "address": {"city": "", "zip": 0}})", person));
+    ASSERT_EQ(person.score, 0.0);
+    ASSERT_FALSE(person.admin);
+    ASSERT_TRUE(person.tags.empty());
+}
+
+TEST(JsonBindingTest, ReportsSchemaErrors) {
+    Person        person;
+    JsonReadError error;
+
+    ASSERT_FALSE(jsonRead(R"({"name": "x", "address": {"city": "a", "zip": 1}})", person, &error));
+    ASSERT_EQ(error.field, "age");
+    ASSERT_STREQ(error.reason, "is missing");
+
+    ASSERT_FALSE(jsonRead(R"({"name": 3, "age": 1, "address": {"city": "a", "zip": 1}})", person, &error));
+    ASSERT_EQ(error.field, "name");
+    ASSERT_STREQ(error.reason, "has the wrong type");
+
+    ASSERT_FALSE(jsonRead(R"({"name": "x", "age": 1, "address": {"city": "a", "zip": -1}})", person, &error));
+    ASSERT_EQ(error.field, "zip");
+
+    ASSERT_FALSE(jsonRead(R"({"name": "x", "age": 1.5, "address": {"city": "a", "zip": 1}})", person, &error));
+    ASSERT_EQ(error.field, "age");
+
+    ASSERT_FALSE(jsonRead(R"({"name": "x", "age": 1, "address": {"city": "a", "zip": 1}, "tags": ["a", 2]})", person, &error));
+    ASSERT_EQ(error.field, "tags");
+
+    ASSERT_FALSE(jsonRead(R"({"name": "x", "age": 1)", person, &error));
+    ASSERT_TRUE(error.field.empty());
+    ASSERT_STREQ(error.reason, "is not valid JSON");
+
+    ASSERT_FALSE(jsonRead(R"([1, 2])", person, &error));
+    ASSERT_STREQ(error.reason, "is not an object");
+}
+
+TEST(JsonBindingTest, WritesWhatItReads) {
+    Person person;
+    person.name    = "Quote \" and \\ and \x01";
+    person.age     = 42;
+    person.score   = 0.25;
+    person.tags    = { "t" };
+    person.address = { "Oslo", 150 };
+    person.previous.push_back({ "Bergen", 5003 });
+
+    String text = jsonWrite(person);
+    ASSERT_EQ(text, R"({"name":"Quote \" and \\ and \u0001","age":42,"score":0.25,"admin":false,"tags":["t"],)"
+                    R"("address":{"city":"Oslo","zip":150},"previous":[{"city":"Bergen","zip":5003}]})");
+
+    Person copy;
+    ASSERT_TRUE(jsonRead(text, copy));
+    ASSERT_EQ(copy.name, person.name);
+    ASSERT_EQ(copy.previous[0].city, "Bergen");
+    ASSERT_EQ(jsonWrite(copy), text);
+}
+
+struct Flags {
+    std::vector< bool > bits;
+};
+SA_JSON_BINDING(Flags,
+    SA_JSON_FIELD(Flags, bits))
+
+TEST(JsonBindingTest, BindsVectorOfBool) {
+    Flags flags;
+    JsonReadError error;
+
+    ASSERT_TRUE(jsonRead(R"({"bits": [true, false, true]})", flags, &error));
+    ASSERT_EQ(flags.bits, (std::vector< bool >{ true, false, true }));
+    ASSERT_EQ(jsonWrite(flags), R"({"bits":[true,false,true]})");
+
+    ASSERT_FALSE(jsonRead(R"({"bits": [true, 1]})", flags, &error));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/json/json_push_parser.hpp"
+
+struct RecordingHandler {
+    static constexpr bool WANTS_TEXT = true;
+
+    std::string events;
+
+    bool onNull(void)                    { events += "null "; return true; }
+    bool onBool(bool value)              { events += value ? "true " : "false "; return true; }
+    bool onNumber(std::string_view text) { events += "#" + std::string(text) + " "; return true; }
+    bool onString(std::string_view text) { events += "s:" + std::string(text) + " "; return true; }
+    bool onKey(std::string_view text)    { events += "k:" + std::string(text) + " "; return true; }
+    bool onBeginObject(void)             { events += "{ "; return true; }
+    bool onEndObject(void)               { events += "} "; return true; }
+    bool onBeginArray(void)              { events += "[ "; return true; }
+    bool onEndArray(void)                { events += "] "; return true; }
+};
+
+static JsonPushStatus validate(std::string_view text) {
+    JsonPushParser<> parser;
+    parser.feed(text);
+    return parser.finish();
+}
+
+TEST(JsonPushParserTest, AcceptsValidDocuments) {
+    const char* valid[] = {
+        "{}", "[]", " [ ] ", "0", "-0", "12", "-1.5e+10", "0.25E-3", "true", "false", "null", R"("")",
+        R"({"a": [1, {"b": null}, "x\"\\\/\b\f\n\r\t\u00e9"], "c": {}})",
+        R"([[[[]]], {"k": [true, false]}, -0.0])"
+    };
+
+    for (const char* text : valid) {
+        ASSERT_EQ(validate(text), JSON_PUSH_COMPLETE) << text;
+    }
+}
+
+TEST(JsonPushParserTest, RejectsInvalidDocuments) {
+    const char* invalid[] = {
+        "", " ", "{", "[1,]", "[,1]", R"({"a" 1})", R"({"a": 1,})", R"({a: 1})", "[1 2]", "01", "1.", ".5",
+        "-", "1e", "1e+", "+1", "tru", "nulls", "[true false]", R"("\x")", R"("\u12g4")", "\"a\tb\"",
+        R"("unterminated)", "[1]]", "{]", "[}", "1 2", R"({"a": 1} {)"
+    };
+
+    for (const char* text : invalid) {
+        ASSERT_EQ(validate(text), JSON_PUSH_ERROR) << text;
+    }
+
+    std::string deep(JsonPushParser<>::MAX_DEPTH + 1, '[');
+    deep.append(JsonPushParser<>::MAX_DEPTH + 1, ']');
+    ASSERT_EQ(validate(deep), JSON_PUSH_ERROR);
+    ASSERT_EQ(validate(deep.substr(1, deep.size() - 2)), JSON_PUSH_COMPLETE);
+}
+
+TEST(JsonPushParserTest, SameEventsWhateverTheChunking) {
+    std::string text = R"({"name": "bo\"b", "n": [12.5e-3, -7, 0], "ok": true, "x": null, "u": "\u00e9"} )";
+
+    JsonPushParser< RecordingHandler > whole;
+    ASSERT_EQ(whole.feed(text), JSON_PUSH_COMPLETE);
+    ASSERT_EQ(whole.finish(), JSON_PUSH_COMPLETE);
+    ASSERT_EQ(whole.handler.events, R"({ k:name s:bo\"b k:n [ #12.5e-3 #-7 #0 ] k:ok true k:x null k:u s:\u00e9 } )");
+
+    for (size_t first = 0; first <= text.size(); first++) {
+        for (size_t second = first; second <= text.size(); second += 7) {
+            JsonPushParser< RecordingHandler > parser;
+            parser.feed(std::string_view(text).substr(0, first));
+            parser.feed(std::string_view(text).substr(first, second - first));
+            parser.feed(std::string_view(text).substr(second));
+
+            ASSERT_EQ(parser.finish(), JSON_PUSH_COMPLETE);
+            ASSERT_EQ(parser.handler.events, whole.handler.events) << first << " " << second;
+        }
+    }
+
+    JsonPushParser< RecordingHandler > byteWise;
+    for (char ch : std::string("-123.25")) {
+        ASSERT_EQ(byteWise.feed(std::string_view(&ch, 1)), JSON_PUSH_INCOMPLETE);
+    }
+    ASSERT_EQ(byteWise.finish(), JSON_PUSH_COMPLETE);
+    ASSERT_EQ(byteWise.handler.events, "#-123.25 ");
+}
+
+TEST(JsonPushParserTest, RejectsEarly) {
+    JsonPushParser<> parser;
+
+    ASSERT_EQ(parser.feed(R"({"items": [1, 2, )"), JSON_PUSH_INCOMPLETE);
+    ASSERT_EQ(parser.feed(R"(3, oops])"), JSON_PUSH_ERROR);
+    ASSERT_EQ(parser.consumed(), 20u);
+    ASSERT_EQ(parser.feed("]}"), JSON_PUSH_ERROR);
+
+    parser.reset();
+    ASSERT_EQ(parser.feed("[1]"), JSON_PUSH_COMPLETE);
+    ASSERT_EQ(parser.feed("  \n"), JSON_PUSH_COMPLETE);
+    ASSERT_EQ(parser.feed(","), JSON_PUSH_ERROR);
+}
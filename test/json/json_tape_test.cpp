@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/json/json_binding.hpp"
+#include "../../src/json/json_tape.hpp"
+
+static bool parses(std::string_view text) {
+    JsonTape tape;
+    return tape.parse(text);
+}
+
+TEST(JsonTapeTest, AcceptsValidDocuments) {
+    const char* valid[] = {
+        "{}", "[]", " [ ] ", "0", "-0", "12", "-1.5e+10", "0.25E-3", "true", "false", "null", R"("")",
+        R"({"a": [1, {"b": null}, "x\"\\\/\b\f\n\r\té"], "c": {}})",
+        R"([[[[]]], {"k": [true, false]}, -0.0])", "\"caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80\"",
+        "1e-400", "18446744073709551615"
+    };
+
+    for (const char* text : valid) {
+        ASSERT_TRUE(parses(text)) << text;
+    }
+}
+
+TEST(JsonTapeTest, RejectsInvalidDocuments) {
+    const char* invalid[] = {
+        "", " ", "{", "[1,]", "[,1]", R"({"a" 1})", R"({"a": 1,})", R"({a: 1})", "[1 2]", "01", "1.", ".5",
+        "-", "1e", "1e+", "+1", "tru", "nulls", "[true false]", R"("\x")", R"("\u12g4")", "\"a\tb\"",
+        R"("unterminated)", "[1]]", "{]", "[}", "1 2", R"({"a": 1} {)", "[1true]", R"(["a""b"])",
+        "1e400", "\"\xC0\xAF\"", "\"\xED\xA0\x80\"", "\"\xF4\x90\x80\x80\"", "\"\xE2\x82\"", "\"\x80\""
+    };
+
+    for (const char* text : invalid) {
+        ASSERT_FALSE(parses(text)) << text;
+    }
+
+    std::string deep(JsonTape::MAX_DEPTH + 1, '[');
+    deep.append(JsonTape::MAX_DEPTH + 1, ']');
+    ASSERT_FALSE(parses(deep));
+    ASSERT_TRUE(parses(deep.substr(1, deep.size() - 2)));
+}
+
+TEST(JsonTapeTest, ReadsValues) {
+    std::string body = R"({"id": 42, "big": 18446744073709551615, "ratio": -1.5e2, "ok": true, "none": null,
+                           "name": "b\"oéb", "tags": ["x", "y", "z"], "user": {"email": "b@x.io"}})";
+    JsonTape    tape;
+    ASSERT_TRUE(tape.parse(body));
+
+    JsonTapeValue      root = tape.root();
+    long long          id;
+    unsigned long long big;
+    double             ratio;
+    bool               flag;
+    std::string_view   name;
+    uint8              small;
+
+    ASSERT_EQ(root.type(), JSON_OBJECT);
+    ASSERT_EQ(root.size(), 8u);
+    ASSERT_TRUE(root["id"].getInt64(id));
+    ASSERT_EQ(id, 42);
+    ASSERT_TRUE(root["id"].getNumber(small));
+    ASSERT_EQ(small, 42);
+    ASSERT_FALSE(root["big"].getInt64(id));
+    ASSERT_TRUE(root["big"].getUint64(big));
+    ASSERT_EQ(big, 18446744073709551615ull);
+    ASSERT_TRUE(root["ratio"].getDouble(ratio));
+    ASSERT_EQ(ratio, -150.0);
+    ASSERT_FALSE(root["ratio"].getInt64(id));
+    ASSERT_TRUE(root["ok"].getBool(flag));
+    ASSERT_TRUE(flag);
+    ASSERT_TRUE(root["none"].isNull());
+    ASSERT_TRUE(root["name"].getString(name));
+    ASSERT_EQ(name, "b\"o\xC3\xA9" "b");
+    ASSERT_EQ(root["tags"].size(), 3u);
+    ASSERT_TRUE(root["tags"][2].getString(name));
+    ASSERT_EQ(name, "z");
+    ASSERT_FALSE(root["tags"][3].exists());
+    ASSERT_TRUE(root["user"]["email"].getString(name));
+    ASSERT_EQ(name, "b@x.io");
+    ASSERT_EQ(root["missing"].type(), JSON_MISSING);
+    ASSERT_FALSE(root["name"].getInt64(id));
+}
+
+TEST(JsonTapeTest, MatchesNlohmann) {
+    std::string body = R"({"a": [1, -2, 3.25, 18446744073709551615, "s\n", true, false, null, {}, []],
+                           "b": {"c": {"d": "deep"}}, "e": "😀"})";
+
+    // Long strings and whitespace runs cross the 64 byte block boundaries
+    body += std::string(100, ' ');
+    body.insert(1, R"("long": ")" + std::string(150, 'x') + "\\\"" + std::string(70, 'y') + R"(", )");
+
+    JsonTape tape;
+    ASSERT_TRUE(tape.parse(body));
+    ASSERT_EQ(tape.root().toNlohmann(), nlohmann::json::parse(body));
+
+    // Buffers are reused: a second, smaller document parses into the same tape
+    ASSERT_TRUE(tape.parse("[1, 2]"));
+    ASSERT_EQ(tape.root().toNlohmann(), nlohmann::json::parse("[1, 2]"));
+}
+
+struct TapeItem {
+    String              sku;
+    long long           qty = 0;
+    std::vector< int >  sizes;
+};
+SA_JSON_BINDING(TapeItem,
+    SA_JSON_FIELD(TapeItem, sku),
+    SA_JSON_FIELD(TapeItem, qty),
+    SA_JSON_FIELD(TapeItem, sizes, JSON_OPTIONAL))
+
+TEST(JsonTapeTest, BindsLikeTheLazyBackend) {
+    const char* bodies[] = {
+        R"({"sku": "AB", "qty": 3, "sizes": [1, 2]})",
+        R"({"sku": "A", "qty": 1.5})",
+        R"({"qty": 2})",
+        R"({"sku": "A", "qty": 2, "sizes": [1, "x"]})",
+        R"({"sku": "A", "qty": 2)",
+        R"([1])"
+    };
+
+    for (const char* body : bodies) {
+        TapeItem      lazy, tape;
+        JsonReadError lazyError, tapeError;
+
+        bool lazyOk = jsonRead(body, lazy, &lazyError, JSON_BACKEND_LAZY);
+        bool tapeOk = jsonRead(body, tape, &tapeError, JSON_BACKEND_TAPE);
+
+        ASSERT_EQ(lazyOk, tapeOk) << body;
+        ASSERT_EQ(lazy.sku, tape.sku) << body;
+        ASSERT_EQ(lazy.qty, tape.qty) << body;
+        ASSERT_EQ(lazy.sizes, tape.sizes) << body;
+        ASSERT_EQ(lazyError.field, tapeError.field) << body;
+        ASSERT_STREQ(lazyError.reason, tapeError.reason) << body;
+    }
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include <cmath>
+#include <string>
+#include "../../src/json/json_writer.hpp"
+#include "../../src/json/lazy_json.hpp"
+
+TEST(JsonWriterTest, PlacesSeparators) {
+    String     out;
+    JsonWriter json(out);
+
+    json.beginObject()
+            .key("id").value(7)
+            .key("tags").beginArray().value("a").value("b").beginArray().endArray().endArray()
+            .key("nested").beginObject().endObject()
+            .key("none").null()
+            .key("flag").value(false)
+        .endObject();
+
+    ASSERT_TRUE(json.isComplete());
+    ASSERT_EQ(out, R"({"id":7,"tags":["a","b",[]],"nested":{},"none":null,"flag":false})");
+    ASSERT_TRUE(JsonDocument(out).isValid());
+}
+
+TEST(JsonWriterTest, AppendsToExistingBuffer) {
+    String     out = "prefix:";
+    JsonWriter json(out);
+
+    json.beginArray().raw(R"({"x":1})").value(String("s")).endArray();
+    ASSERT_EQ(out, R"(prefix:[{"x":1},"s"])");
+
+    json.value(1);
+    ASSERT_EQ(out, R"(prefix:[{"x":1},"s"],1)");
+}
+
+TEST(JsonWriterTest, FormatsNumbers) {
+    String     out;
+    JsonWriter json(out);
+
+    json.beginArray()
+        .value(0).value(9).value(10).value(99).value(100).value(-1)
+        .value(LLONG_MIN).value(ULLONG_MAX).value((unsigned char) 200)
+        .value(0.1).value(-2.5e-300).value(1e21).value(NAN).value(INFINITY)
+        .endArray();
+
+    ASSERT_EQ(out, "[0,9,10,99,100,-1,-9223372036854775808,18446744073709551615,200,"
+                   "0.1,-2.5e-300,1e+21,null,null]");
+
+    for (long long number : { 1LL, 12LL, 123LL, 1234LL, 12345LL, 1000000007LL, -98765432123LL }) {
+        String     digits;
+        JsonWriter writer(digits);
+        writer.value(number);
+        ASSERT_EQ(digits, std::to_string(number));
+    }
+}
+
+TEST(JsonWriterTest, EscapesStrings) {
+    String     out;
+    JsonWriter json(out);
+
+    json.beginObject().key("k\"\n").value(std::string_view("a\\b\t\x1f\xC3\xA9", 7)).endObject();
+    ASSERT_EQ(out, "{\"k\\\"\\n\":\"a\\\\b\\t\\u001f\xC3\xA9\"}");
+
+    JsonDocument doc(out);
+    String       decoded;
+    ASSERT_TRUE(doc.root()["k\"\n"].getString(decoded));
+    ASSERT_EQ(decoded, "a\\b\t\x1f\xC3\xA9");
+}
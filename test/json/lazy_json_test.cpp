@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/json/lazy_json.hpp"
+
+TEST(LazyJsonTest, ValidatesStructure) {
+    ASSERT_TRUE(JsonDocument(R"({"a": [1, {"b": "]}"}], "c": null})").isValid());
+    ASSERT_TRUE(JsonDocument("  42 ").isValid());
+    ASSERT_TRUE(JsonDocument(R"("text")").isValid());
+    ASSERT_TRUE(JsonDocument("[]").isValid());
+
+    ASSERT_FALSE(JsonDocument("").isValid());
+    ASSERT_FALSE(JsonDocument("   ").isValid());
+    ASSERT_FALSE(JsonDocument(R"({"a": [1, 2})").isValid());
+    ASSERT_FALSE(JsonDocument(R"({"a": "unterminated})").isValid());
+    ASSERT_FALSE(JsonDocument(R"({"a": 1}})").isValid());
+    ASSERT_FALSE(JsonDocument(R"({"a": 1} {"b": 2})").isValid());
+    ASSERT_FALSE(JsonDocument("[[[").isValid());
+    ASSERT_FALSE(JsonDocument("1 2").isValid());
+    ASSERT_FALSE(JsonDocument(R"("a\")").isValid());
+
+    std::string deep(JsonDocument::MAX_DEPTH + 1, '[');
+    deep.append(JsonDocument::MAX_DEPTH + 1, ']');
+    ASSERT_FALSE(JsonDocument(deep).isValid());
+    ASSERT_EQ(JsonDocument(deep).root().type(), JSON_MISSING);
+}
+
+TEST(LazyJsonTest, ReadsFieldsOnDemand) {
+    std::string  body = R"({"id": 42, "ratio": -1.5e2, "ok": true, "off": false, "none": null,
+                            "name": "bob", "tags": ["x", "y"], "user": {"email": "b@x.io"}})";
+    JsonDocument doc(body);
+    JsonValue    root = doc.root();
+
+    long long id;
+    double    ratio;
+    bool      flag;
+    String    name;
+
+    ASSERT_EQ(root.type(), JSON_OBJECT);
+    ASSERT_TRUE(root["id"].getInt64(id));
+    ASSERT_EQ(id, 42);
+    ASSERT_TRUE(root["ratio"].getDouble(ratio));
+    ASSERT_EQ(ratio, -150.0);
+    ASSERT_TRUE(root["ok"].getBool(flag));
+    ASSERT_TRUE(flag);
+    ASSERT_TRUE(root["off"].getBool(flag));
+    ASSERT_FALSE(flag);
+    ASSERT_TRUE(root["none"].isNull());
+    ASSERT_TRUE(root["name"].getString(name));
+    ASSERT_EQ(name, "bob");
+
+    ASSERT_FALSE(root["missing"].exists());
+    ASSERT_FALSE(root["missing"]["deeper"].exists());
+    ASSERT_FALSE(root["name"].getInt64(id));
+    ASSERT_FALSE(root["ratio"].getInt64(id));
+    ASSERT_FALSE(root["id"].getString(name));
+
+    JsonString email;
+    ASSERT_TRUE(root["user"]["email"].getString(email));
+    ASSERT_FALSE(email.escaped);
+    ASSERT_EQ(email.raw, "b@x.io");
+    ASSERT_GE(email.raw.data(), body.data());
+    ASSERT_LT(email.raw.data(), body.data() + body.size());
+
+    ASSERT_TRUE(root["tags"][1u].getString(name));
+    ASSERT_EQ(name, "y");
+    ASSERT_FALSE(root["tags"][2u].exists());
+    ASSERT_EQ(root["tags"].raw(), R"(["x", "y"])");
+}
+
+TEST(LazyJsonTest, SkipsNestedSubtrees) {
+    std::string body = R"({"skip": {"deep": [[1, 2, {"s": "}]{[\"\\"}], [3]], "pad": ")";
+    body.append(200, 'p');
+    body += R"("}, "arr": [)";
+    for (int idx = 0; idx < 100; idx++) {
+        body += R"({"k": "v]}", "n": [1, [2, [3]]]}, )";
+    }
+    body += R"(0], "target": "found"})";
+
+    JsonDocument doc(body);
+    ASSERT_TRUE(doc.isValid());
+
+    String target;
+    ASSERT_TRUE(doc.root()["target"].getString(target));
+    ASSERT_EQ(target, "found");
+    ASSERT_EQ(doc.root().at("/skip/deep/0/2/s").raw(), R"("}]{[\"\\")");
+    ASSERT_TRUE(doc.root().at("/arr/100").exists());
+    ASSERT_FALSE(doc.root().at("/arr/101").exists());
+}
+
+TEST(LazyJsonTest, FindsSeveralFieldsInOnePass) {
+    JsonDocument     doc(R"({"a": 1, "b": [2], "c": "3", "d": {}})");
+    std::string_view keys[]  = { "d", "a", "zz" };
+    JsonValue        values[3];
+
+    ASSERT_EQ(doc.root().findFields(keys, values, 3), 2u);
+    ASSERT_EQ(values[0].type(), JSON_OBJECT);
+    ASSERT_EQ(values[1].type(), JSON_NUMBER);
+    ASSERT_FALSE(values[2].exists());
+
+    uint32 members = 0;
+    ASSERT_TRUE(doc.root().forEachMember([&](const JsonString&, const JsonValue&) { members++; return true; }));
+    ASSERT_EQ(members, 4u);
+}
+
+TEST(LazyJsonTest, DecodesEscapes) {
+    JsonDocument doc(R"({"k\"ey": "a\né😀\/", "bad": "\x", "lone": "\udc00"})");
+    JsonString   text;
+    String       decoded;
+
+    ASSERT_TRUE(doc.root()["k\"ey"].getString(text));
+    ASSERT_TRUE(text.escaped);
+    ASSERT_TRUE(text.decode(decoded));
+    ASSERT_EQ(decoded, "a\n\xC3\xA9\xF0\x9F\x98\x80/");
+
+    ASSERT_FALSE(doc.root()["bad"].getString(decoded));
+    ASSERT_FALSE(doc.root()["lone"].getString(decoded));
+}
+
+TEST(LazyJsonTest, JsonPointer) {
+    JsonDocument doc(R"({"a/b": {"m~n": [10, 20]}, "": 1})");
+    long long    value;
+
+    ASSERT_TRUE(doc.root().at("/a~1b/m~0n/1").getInt64(value));
+    ASSERT_EQ(value, 20);
+    ASSERT_TRUE(doc.root().at("/").getInt64(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_EQ(doc.root().at("").type(), JSON_OBJECT);
+    ASSERT_FALSE(doc.root().at("/a~1b/m~0n/x").exists());
+    ASSERT_FALSE(doc.root().at("a").exists());
+}
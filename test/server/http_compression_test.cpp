@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/server/implementations/http_compression.hpp"
+
+#ifdef SA_HAVE_ZSTD
+static const ContentEncoding PREFERRED = CONTENT_ENCODING_ZSTD;
+#else
+static const ContentEncoding PREFERRED = CONTENT_ENCODING_GZIP;
+#endif // SA_HAVE_ZSTD
+
+TEST(HttpCompressionTest, NegotiatesAcceptEncoding) {
+    ASSERT_EQ(contentEncodingForAccept(""), CONTENT_ENCODING_IDENTITY);
+    ASSERT_EQ(contentEncodingForAccept("gzip"), CONTENT_ENCODING_GZIP);
+    ASSERT_EQ(contentEncodingForAccept(" GZIP ; q=1"), CONTENT_ENCODING_GZIP);
+    ASSERT_EQ(contentEncodingForAccept("x-gzip"), CONTENT_ENCODING_GZIP);
+    ASSERT_EQ(contentEncodingForAccept("br"), CONTENT_ENCODING_IDENTITY);
+}
+
+TEST(HttpCompressionTest, AcceptEncodingQualities) {
+    ASSERT_EQ(contentEncodingForAccept("gzip;q=0.5, deflate;q=0.8"), CONTENT_ENCODING_DEFLATE);
+    ASSERT_EQ(contentEncodingForAccept("gzip;q=0.8, deflate;q=0.5"), CONTENT_ENCODING_GZIP);
+    ASSERT_EQ(contentEncodingForAccept("gzip;q=0"), CONTENT_ENCODING_IDENTITY);
+    ASSERT_EQ(contentEncodingForAccept("gzip;q=0, deflate;q=0.001"), CONTENT_ENCODING_DEFLATE);
+}
+
+TEST(HttpCompressionTest, AcceptEncodingIdentityIsAlwaysAcceptable) {
+    ASSERT_EQ(contentEncodingForAccept("identity;q=0"), CONTENT_ENCODING_IDENTITY);
+    ASSERT_EQ(contentEncodingForAccept("gzip;q=0, identity;q=0"), CONTENT_ENCODING_IDENTITY);
+    ASSERT_EQ(contentEncodingForAccept("identity;q=0, deflate"), CONTENT_ENCODING_DEFLATE);
+}
+
+TEST(HttpCompressionTest, AcceptEncodingWildcard) {
+    ASSERT_EQ(contentEncodingForAccept("*"), PREFERRED);
+    ASSERT_EQ(contentEncodingForAccept("*;q=0.5, deflate"), CONTENT_ENCODING_DEFLATE);
+    ASSERT_EQ(contentEncodingForAccept("*;q=0"), CONTENT_ENCODING_IDENTITY);
+#ifdef SA_HAVE_ZSTD
+    ASSERT_EQ(contentEncodingForAccept("zstd;q=0, *"), CONTENT_ENCODING_GZIP);
+#endif // SA_HAVE_ZSTD
+    ASSERT_EQ(contentEncodingForAccept("gzip;q=0, *;q=0.3"), PREFERRED == CONTENT_ENCODING_GZIP ? CONTENT_ENCODING_DEFLATE : PREFERRED);
+}
+
+TEST(HttpCompressionTest, AcceptEncodingTiesGoToServerPreference) {
+    ASSERT_EQ(contentEncodingForAccept("deflate, gzip"), CONTENT_ENCODING_GZIP);
+    ASSERT_EQ(contentEncodingForAccept("deflate;q=0.7, gzip;q=0.7"), CONTENT_ENCODING_GZIP);
+    ASSERT_EQ(contentEncodingForAccept("deflate, gzip, zstd"), PREFERRED);
+}
+
+TEST(HttpCompressionTest, CompressibleContentTypes) {
+    ASSERT_TRUE(isCompressibleContentType("application/json; charset=utf-8"));
+    ASSERT_TRUE(isCompressibleContentType(" Image/SVG+XML "));
+    ASSERT_FALSE(isCompressibleContentType("Image/PNG"));
+    ASSERT_FALSE(isCompressibleContentType("application/gzip"));
+}
+
+/** Same bound as HttpServer::MAX_DECODED_BODY_BYTES (8 * MAX_BODY_BYTES). */
+static const ulong DECODED_LIMIT = 8 * 1024 * 1024;
+
+static String compressed(ContentEncoding encoding, const String& body) {
+    HttpCompressor compressor;
+    String         out;
+
+    EXPECT_TRUE(compressor.compress(encoding, body, out, HttpCompressor::LEVEL_BEST));
+    return out;
+}
+
+/** Feeds wire in chunks as they would arrive, stopping at the first status that is not MORE. */
+static DecompressStatus decompressed(HttpDecompressor& decompressor, ContentEncoding encoding, const String& wire, String& out, ulong limit) {
+    const ulong CHUNK = 1500;
+
+    EXPECT_TRUE(decompressor.begin(encoding));
+    out.clear();
+
+    DecompressStatus status = DECOMPRESS_MORE;
+    for (ulong offset = 0; offset < wire.size() && status == DECOMPRESS_MORE; offset += CHUNK) {
+        status = decompressor.feed(std::string_view(wire).substr(offset, CHUNK), out, limit);
+    }
+    return status;
+}
+
+TEST(HttpCompressionTest, DecompressesRoundTrip) {
+    HttpDecompressor decompressor;
+    String           body(100000, 'a');
+    String           out;
+
+    for (ulong idx = 0; idx < body.size(); idx += 7) body[idx] = (char)('a' + idx % 26);
+
+    ASSERT_EQ(decompressed(decompressor, CONTENT_ENCODING_GZIP, compressed(CONTENT_ENCODING_GZIP, body), out, DECODED_LIMIT), DECOMPRESS_DONE);
+    ASSERT_EQ(out, body);
+    ASSERT_EQ(decompressed(decompressor, CONTENT_ENCODING_DEFLATE, compressed(CONTENT_ENCODING_DEFLATE, body), out, DECODED_LIMIT), DECOMPRESS_DONE);
+    ASSERT_EQ(out, body);
+}
+
+TEST(HttpCompressionTest, RefusesDecompressionBombs) {
+    HttpDecompressor decompressor;
+    String           bomb(DECODED_LIMIT * 4, '\0');
+    String           out;
+
+    for (ContentEncoding encoding : { CONTENT_ENCODING_GZIP, CONTENT_ENCODING_DEFLATE }) {
+        String wire = compressed(encoding, bomb);
+        ASSERT_LT(wire.size(), 64u * 1024);
+
+        ASSERT_EQ(decompressed(decompressor, encoding, wire, out, DECODED_LIMIT), DECOMPRESS_TOO_LARGE);
+        ASSERT_LE(out.size(), DECODED_LIMIT + 1);
+    }
+#ifdef SA_HAVE_ZSTD
+    ASSERT_EQ(decompressed(decompressor, CONTENT_ENCODING_ZSTD, compressed(CONTENT_ENCODING_ZSTD, bomb), out, DECODED_LIMIT), DECOMPRESS_TOO_LARGE);
+    ASSERT_LE(out.size(), DECODED_LIMIT + 1);
+#endif // SA_HAVE_ZSTD
+}
+
+TEST(HttpCompressionTest, DecompressesUpToTheExactLimit) {
+    HttpDecompressor decompressor;
+    String           atLimit(DECODED_LIMIT, 'x');
+    String           pastLimit(DECODED_LIMIT + 1, 'x');
+    String           out;
+
+    for (ContentEncoding encoding : {
+#ifdef SA_HAVE_ZSTD
+             CONTENT_ENCODING_ZSTD,
+#endif // SA_HAVE_ZSTD
+             CONTENT_ENCODING_GZIP, CONTENT_ENCODING_DEFLATE }) {
+        ASSERT_EQ(decompressed(decompressor, encoding, compressed(encoding, atLimit), out, DECODED_LIMIT), DECOMPRESS_DONE);
+        ASSERT_EQ(out.size(), DECODED_LIMIT);
+
+        ASSERT_EQ(decompressed(decompressor, encoding, compressed(encoding, pastLimit), out, DECODED_LIMIT), DECOMPRESS_TOO_LARGE);
+    }
+}
+
+TEST(HttpCompressionTest, DecompressesConcatenatedGzipMembers) {
+    HttpDecompressor decompressor;
+    String           first  = compressed(CONTENT_ENCODING_GZIP, String("first member, "));
+    String           second = compressed(CONTENT_ENCODING_GZIP, String("second member"));
+    String           out;
+
+    ASSERT_TRUE(decompressor.begin(CONTENT_ENCODING_GZIP));
+    ASSERT_EQ(decompressor.feed(first + second, out, DECODED_LIMIT), DECOMPRESS_DONE);
+    ASSERT_EQ(out, "first member, second member");
+
+    // The next member may start in a later read
+    out.clear();
+    ASSERT_TRUE(decompressor.begin(CONTENT_ENCODING_GZIP));
+    ASSERT_EQ(decompressor.feed(first, out, DECODED_LIMIT), DECOMPRESS_DONE);
+    ASSERT_EQ(decompressor.feed(second, out, DECODED_LIMIT), DECOMPRESS_DONE);
+    ASSERT_EQ(out, "first member, second member");
+
+    out.clear();
+    ASSERT_TRUE(decompressor.begin(CONTENT_ENCODING_GZIP));
+    ASSERT_EQ(decompressor.feed(first + "garbage", out, DECODED_LIMIT), DECOMPRESS_FAILED);
+}
+
+TEST(HttpCompressionTest, RefusesBytesAfterADeflateStream) {
+    HttpDecompressor decompressor;
+    String           wire = compressed(CONTENT_ENCODING_DEFLATE, String("body"));
+    String           out;
+
+    ASSERT_TRUE(decompressor.begin(CONTENT_ENCODING_DEFLATE));
+    ASSERT_EQ(decompressor.feed(wire + wire, out, DECODED_LIMIT), DECOMPRESS_FAILED);
+
+    out.clear();
+    ASSERT_TRUE(decompressor.begin(CONTENT_ENCODING_DEFLATE));
+    ASSERT_EQ(decompressor.feed(wire, out, DECODED_LIMIT), DECOMPRESS_DONE);
+    ASSERT_EQ(decompressor.feed("x", out, DECODED_LIMIT), DECOMPRESS_FAILED);
+}
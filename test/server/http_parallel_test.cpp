@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "../../src/server/implementations/http_parallel.hpp"
+#include "../../src/stl/monotonic_arena.hpp"
+
+/**
+ * A TaskQueue served by real worker threads, bound as the parallel pool like the server does.
+ * Workers leave on a stop task from the connections lane, which they only take once the job
+ * lane is empty.
+ */
+class HttpParallelTest : public ::testing::Test {
+protected:
+    static constexpr uint32 WORKERS = 4;
+
+    TaskQueue pool;
+    pthread_t workers[WORKERS];
+
+    static thread_local bool stopping;
+
+    static void stopTask(void*, long) { stopping = true; }
+
+    static void* workerRoutine(void* arg) {
+        TaskQueue* queue = (TaskQueue*) arg;
+        while (!stopping) {
+            Task task = queue->dequeue();
+            task.run(task.context, task.argument);
+        }
+        return NULL;
+    }
+
+    void SetUp() override {
+        pool.init(WORKERS);
+        for (uint32 idx = 0; idx < WORKERS; idx++) {
+            ASSERT_EQ(pthread_create(&workers[idx], NULL, &workerRoutine, &pool), 0);
+        }
+        bindParallelPool(&pool);
+    }
+
+    void TearDown() override {
+        bindParallelPool(nullptr);
+        for (uint32 idx = 0; idx < WORKERS; idx++) pool.enqueue(Task{ &stopTask, nullptr, 0 });
+        for (uint32 idx = 0; idx < WORKERS; idx++) pthread_join(workers[idx], NULL);
+        pool.destroy();
+    }
+};
+
+thread_local bool HttpParallelTest::stopping = false;
+
+static void noopTask(void*, long) {}
+
+TEST_F(HttpParallelTest, VisitsEveryIndexExactlyOnce) {
+    const uint64 count = 100000;
+    std::vector< std::atomic< uint32 > > visits(count);
+
+    parallelFor(0, count, [&visits](uint64 idx) {
+        visits[idx].fetch_add(1, std::memory_order_relaxed);
+    }, 100);
+
+    for (uint64 idx = 0; idx < count; idx++) {
+        ASSERT_EQ(visits[idx].load(), 1u) << "index " << idx;
+    }
+}
+
+TEST_F(HttpParallelTest, ReductionIsDeterministic) {
+    const uint64 count = 200000;
+    const uint64 grain = 1000;
+    auto map     = [](uint64 idx) { return 1.0 / (double)(idx + 1); };
+    auto combine = [](double lhs, double rhs) { return lhs + rhs; };
+
+    /** The same chunks summed in index order, on one thread */
+    uint64 chunkSize;
+    uint32 chunkCount = _parallelChunkCount(count, grain, chunkSize);
+    double expected   = 0.0;
+    for (uint32 chunk = 0; chunk < chunkCount; chunk++) {
+        double partial = 0.0;
+        for (uint64 idx = chunk * chunkSize; idx < count && idx < (chunk + 1) * chunkSize; idx++) {
+            partial = combine(partial, map(idx));
+        }
+        expected = combine(expected, partial);
+    }
+
+    for (int run = 0; run < 20; run++) {
+        ASSERT_EQ(parallelReduce(0, count, 0.0, map, combine, grain), expected);
+    }
+}
+
+TEST_F(HttpParallelTest, NestedCallsComplete) {
+    const uint64 outer = 64;
+    const uint64 inner = 2000;
+    std::vector< std::atomic< uint32 > > visits(outer * inner);
+
+    parallelFor(0, outer, [&visits](uint64 row) {
+        parallelFor(0, inner, [&visits, row](uint64 column) {
+            visits[row * inner + column].fetch_add(1, std::memory_order_relaxed);
+        }, 100);
+    }, 1);
+
+    for (uint64 idx = 0; idx < outer * inner; idx++) {
+        ASSERT_EQ(visits[idx].load(), 1u) << "index " << idx;
+    }
+}
+
+TEST_F(HttpParallelTest, BodyExceptionIsRethrownToTheCaller) {
+    std::atomic< uint64 > visited{0};
+
+    ASSERT_THROW(parallelFor(0, 100000, [&visited](uint64 idx) {
+        if (idx == 54321) throw std::runtime_error("body failed");
+        visited.fetch_add(1, std::memory_order_relaxed);
+    }, 100), std::runtime_error);
+    ASSERT_LT(visited.load(), 100000u);
+
+    /** The pool is left usable */
+    ASSERT_EQ(parallelReduce(0, 10000, (uint64) 0, [](uint64 idx) { return idx; },
+                             [](uint64 lhs, uint64 rhs) { return lhs + rhs; }, 100),
+              (uint64) 10000 * 9999 / 2);
+}
+
+TEST_F(HttpParallelTest, BodiesRunWithNoArenaBound) {
+    MonotonicArena arena;
+    ArenaScope     scope(arena);
+    std::atomic< uint32 > bound{0};
+
+    parallelFor(0, 10000, [&bound](uint64) {
+        if (currentArena() != nullptr) bound.fetch_add(1, std::memory_order_relaxed);
+    }, 100);
+
+    ASSERT_EQ(bound.load(), 0u);
+    ASSERT_EQ(currentArena(), &arena);
+}
+
+TEST(HttpParallelInlineTest, RunsInlineWhenTheJobLaneIsFull) {
+    /** No worker serves this pool, and its job lane is full: every helper is refused */
+    TaskQueue pool;
+    pool.init(4);
+    while (pool.tryEnqueueJob(Task{ &noopTask, nullptr, 0 })) {}
+    bindParallelPool(&pool);
+
+    pthread_t caller = pthread_self();
+    std::atomic< uint32 > elsewhere{0};
+    std::atomic< uint64 > visited{0};
+    parallelFor(0, 10000, [&](uint64) {
+        if (!pthread_equal(pthread_self(), caller)) elsewhere.fetch_add(1, std::memory_order_relaxed);
+        visited.fetch_add(1, std::memory_order_relaxed);
+    }, 100);
+
+    bindParallelPool(nullptr);
+    Task task;
+    while (pool.tryDequeueJob(task)) {}
+    pool.destroy();
+
+    ASSERT_EQ(visited.load(), 10000u);
+    ASSERT_EQ(elsewhere.load(), 0u);
+}
+
+TEST(HttpParallelInlineTest, RunsInlineWithNoPoolBound) {
+    ASSERT_EQ(parallelPool(), nullptr);
+
+    pthread_t caller = pthread_self();
+    uint32    elsewhere = 0;
+    uint64    visited   = 0;
+    parallelFor(0, 10000, [&](uint64) {
+        if (!pthread_equal(pthread_self(), caller)) elsewhere++;
+        visited++;
+    }, 100);
+
+    ASSERT_EQ(visited, 10000u);
+    ASSERT_EQ(elsewhere, 0u);
+    ASSERT_EQ(parallelReduce(0, 100, 0, [](uint64 idx) { return (int) idx; },
+                             [](int lhs, int rhs) { return lhs + rhs; }, 10), 4950);
+}
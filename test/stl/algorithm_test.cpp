@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../src/stl/algorithm.hpp"
+#include "../../src/stl/collection.hpp"
+#include "../../src/stl/small_vector.hpp"
+
+namespace {
+
+struct ReportRow {
+    uint32 id;
+    double amount;
+};
+
+std::vector< int > randomInts(uint32 count, int range, uint32 seed) {
+    std::mt19937 rng(seed);
+    std::vector< int > values(count);
+    for (int& value : values) {
+        value = (int)((long long)(rng() % (2u * (uint32) range)) - range);
+    }
+    return values;
+}
+
+}
+
+TEST(AlgorithmTest, IntroSortMatchesStdSort) {
+    for (uint32 count : {0u, 1u, 2u, 15u, 17u, 100u, 5000u}) {
+        for (int range : {3, 1000000}) {
+            std::vector< int > values   = randomInts(count, range, count + range);
+            std::vector< int > expected = values;
+            std::sort(expected.begin(), expected.end());
+
+            introSort(values.data(), values.data() + values.size());
+            ASSERT_EQ(values, expected) << count << " items in +-" << range;
+        }
+    }
+}
+
+TEST(AlgorithmTest, IntroSortSurvivesAdversarialInputs) {
+    std::vector< int > sorted(20000), reversed(20000), organPipe(20000);
+    for (int idx = 0; idx < 20000; ++idx) {
+        sorted[idx]    = idx;
+        reversed[idx]  = 20000 - idx;
+        organPipe[idx] = idx < 10000 ? idx : 20000 - idx;
+    }
+
+    for (std::vector< int >* values : {&sorted, &reversed, &organPipe}) {
+        introSort(values->data(), values->data() + values->size(), [](int lhs, int rhs) { return lhs > rhs; });
+        ASSERT_TRUE(std::is_sorted(values->begin(), values->end(), [](int lhs, int rhs) { return lhs > rhs; }));
+    }
+}
+
+TEST(AlgorithmTest, WorksOnCollectionsAndSmallVectors) {
+    Collection< std::string, 64 > names;
+    for (const char* name : {"delta", "alpha", "echo", "charlie", "bravo"}) {
+        names.add(name);
+    }
+
+    introSort(names.begin(), names.end());
+    ASSERT_EQ(names.at(0), "alpha");
+    ASSERT_EQ(names.at(4), "echo");
+    ASSERT_EQ(lowerBound(names.begin(), names.end(), std::string("c")) - names.begin(), 2);
+
+    SmallVector< uint32 > ids;
+    for (uint32 idx = 0; idx < 1000; ++idx) {
+        ids.add((idx * 7919) % 1000);
+    }
+    radixSort(ids);
+    for (uint32 idx = 0; idx < 1000; ++idx) {
+        ASSERT_EQ(ids[idx], idx);
+    }
+}
+
+TEST(AlgorithmTest, RadixSortOrdersSignedAndFloatKeys) {
+    std::vector< int > values   = randomInts(10000, 1 << 30, 5);
+    std::vector< int > expected = values;
+    std::sort(expected.begin(), expected.end());
+    radixSort(values.data(), values.data() + values.size());
+    ASSERT_EQ(values, expected);
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution< double > amounts(-1e6, 1e6);
+    std::vector< double > doubles(3000);
+    for (double& value : doubles) {
+        value = amounts(rng);
+    }
+    doubles[10] = -0.0;
+    doubles[11] = 0.0;
+    doubles[12] = -INFINITY;
+    std::vector< double > sortedDoubles = doubles;
+    std::sort(sortedDoubles.begin(), sortedDoubles.end());
+    radixSort(doubles.data(), doubles.data() + doubles.size());
+    ASSERT_EQ(doubles, sortedDoubles);
+}
+
+TEST(AlgorithmTest, RadixSortByIsStable) {
+    std::vector< ReportRow > rows;
+    for (uint32 id = 0; id < 4000; ++id) {
+        rows.push_back({id, (double)((id * 37) % 50) - 25.0});
+    }
+
+    radixSortBy(rows.data(), rows.data() + rows.size(), [](const ReportRow& row) { return row.amount; });
+
+    for (uint32 idx = 1; idx < rows.size(); ++idx) {
+        ASSERT_LE(rows[idx - 1].amount, rows[idx].amount);
+        if (rows[idx - 1].amount == rows[idx].amount) {
+            ASSERT_LT(rows[idx - 1].id, rows[idx].id);
+        }
+    }
+}
+
+TEST(AlgorithmTest, RadixSortByIsStableBelowCutoff) {
+    std::vector< ReportRow > rows;
+    for (uint32 id = 0; id < 200; ++id) {
+        rows.push_back({id, (double)((id * 37) % 7) - 3.0});
+    }
+
+    radixSortBy(rows.data(), rows.data() + rows.size(), [](const ReportRow& row) { return row.amount; });
+
+    for (uint32 idx = 1; idx < rows.size(); ++idx) {
+        ASSERT_LE(rows[idx - 1].amount, rows[idx].amount);
+        if (rows[idx - 1].amount == rows[idx].amount) {
+            ASSERT_LT(rows[idx - 1].id, rows[idx].id);
+        }
+    }
+}
+
+TEST(AlgorithmTest, BoundsMatchStd) {
+    std::vector< int > values = randomInts(1000, 50, 3);
+    std::sort(values.begin(), values.end());
+
+    for (int probe = -60; probe <= 60; ++probe) {
+        const int* first = values.data();
+        const int* last  = values.data() + values.size();
+        ASSERT_EQ(lowerBound(first, last, probe), &*std::lower_bound(values.begin(), values.end(), probe) + 0);
+        ASSERT_EQ(upperBound(first, last, probe) - first, std::upper_bound(values.begin(), values.end(), probe) - values.begin());
+    }
+
+    int* none = nullptr;
+    ASSERT_EQ(lowerBound(none, none, 3), none);
+}
+
+TEST(AlgorithmTest, NthElementAndPartition) {
+    for (uint32 nth : {0u, 1u, 500u, 2999u}) {
+        std::vector< int > values   = randomInts(3000, 100, nth);
+        std::vector< int > expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        int* first = values.data();
+        nthElement(first, first + nth, first + values.size());
+        ASSERT_EQ(values[nth], expected[nth]);
+        for (uint32 idx = 0; idx < values.size(); ++idx) {
+            ASSERT_TRUE(idx < nth ? values[idx] <= values[nth] : values[idx] >= values[nth]);
+        }
+    }
+
+    std::vector< int > values = randomInts(1001, 100, 8);
+    int* split = partitionBy(values.data(), values.data() + values.size(), [](int value) { return value % 2 == 0; });
+    ASSERT_EQ(split - values.data(), std::count_if(values.begin(), values.end(), [](int value) { return value % 2 == 0; }));
+    ASSERT_TRUE(std::all_of(values.data(), split, [](int value) { return value % 2 == 0; }));
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../../src/stl/associative_container.hpp"
+#include "./copy_counter.hpp"
+
 template< class Key, class Value, uint32 CONTAINER_CAPACITY >
 struct AssociativeContainerWrapper {
     static constexpr uint32 CAPACITY = CONTAINER_CAPACITY;
@@ -55,6 +57,22 @@ TYPED_TEST(AssociativeContainerTest, AddExistingKeyReturnsReference) {
     ASSERT_EQ(container.at(10), 150.0f);
 }
 
+TYPED_TEST(AssociativeContainerTest, RemoveKeepsOrder) {
+    using T = TypeParam;
+    typename T::ContainerType container;
+
+    container.add(1, 1.0f);
+    container.add(2, 2.0f);
+    container.add(3, 3.0f);
+
+    ASSERT_TRUE(container.remove(2));
+    ASSERT_FALSE(container.remove(2));
+    ASSERT_EQ(container.length(), 2u);
+    ASSERT_FALSE(container.exists(2));
+    ASSERT_EQ(container.getKeyAt(1), 3);
+    ASSERT_EQ(container.at(3), 3.0f);
+}
+
 TYPED_TEST(AssociativeContainerTest, AccessValues) {
     using T = TypeParam;
     typename T::ContainerType container;
@@ -113,4 +131,22 @@ TYPED_TEST(AssociativeContainerTest, CapacityLimit) {
     float& valRef = container.add(0, 99.9f);
     ASSERT_EQ(container.length(), T::CAPACITY);
     ASSERT_EQ(valRef, 0.0f);
-}
\ No newline at end of file
+}
+
+TEST(AssociativeContainerMoveTest, AddAndEmplaceDoNotCopy) {
+    CopyCounter::copies = 0;
+
+    AssociativeContainer<CopyCounter, CopyCounter, 8> container;
+    container.add(CopyCounter(1), CopyCounter(10));
+    container.emplace(CopyCounter(2), 20);
+
+    EXPECT_EQ(container.length(), 2u);
+    EXPECT_EQ(container.at(CopyCounter(2)).id, 20);
+
+    /** emplace keeps an existing value, like add. */
+    container.emplace(CopyCounter(1), 99);
+    EXPECT_EQ(container.at(CopyCounter(1)).id, 10);
+
+    /** emplace takes the key by reference, storing it is the only copy. */
+    EXPECT_EQ(CopyCounter::copies, 1);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <string>
 #include "../../src/stl/collection.hpp"
+#include "./copy_counter.hpp"
 
 struct TestItem {
     int id;
@@ -142,4 +144,83 @@ TYPED_TEST(CollectionTest, EqualityOperator) {
     other_collection.add(different_item);
 
     EXPECT_TRUE(this->collection != other_collection);
-}
\ No newline at end of file
+}
+struct LifetimeTracker {
+    static int alive;
+    int id;
+
+    LifetimeTracker(int itemId = 0) : id(itemId) { alive++; }
+    LifetimeTracker(const LifetimeTracker& other) : id(other.id) { alive++; }
+    LifetimeTracker& operator=(const LifetimeTracker& other) { id = other.id; return *this; }
+    ~LifetimeTracker() { alive--; }
+
+    bool operator==(const LifetimeTracker& other) const { return id == other.id; }
+    bool operator!=(const LifetimeTracker& other) const { return id != other.id; }
+};
+
+int LifetimeTracker::alive = 0;
+
+TEST(CollectionStorageTest, OnlyLiveItemsAreConstructed) {
+    {
+        Collection<LifetimeTracker, 64> collection;
+        EXPECT_EQ(LifetimeTracker::alive, 0);
+
+        for (int i = 0; i < 5; ++i) {
+            collection.add(LifetimeTracker(i));
+        }
+        EXPECT_EQ(LifetimeTracker::alive, 5);
+
+        collection.removeAt(1);
+        EXPECT_EQ(LifetimeTracker::alive, 4);
+        EXPECT_EQ(collection.at(1).id, 2);
+
+        Collection<LifetimeTracker, 64> copy(collection);
+        EXPECT_EQ(LifetimeTracker::alive, 8);
+
+        copy = collection;
+        EXPECT_EQ(LifetimeTracker::alive, 8);
+    }
+    EXPECT_EQ(LifetimeTracker::alive, 0);
+}
+
+TEST(CollectionStorageTest, AddAtInsertsAndShifts) {
+    Collection<std::string, 8> collection;
+    collection.add("a");
+    collection.add("c");
+
+    collection.addAt(1, "b");
+    collection.addAt(3, "d");
+    collection.addAt(0, "_");
+
+    ASSERT_EQ(collection.length, 5u);
+    EXPECT_EQ(collection.at(0), "_");
+    EXPECT_EQ(collection.at(1), "a");
+    EXPECT_EQ(collection.at(2), "b");
+    EXPECT_EQ(collection.at(3), "c");
+    EXPECT_EQ(collection.at(4), "d");
+}
+
+TEST(CollectionMoveTest, HotPathsDoNotCopy) {
+    CopyCounter::copies = 0;
+
+    Collection<CopyCounter, 16> collection;
+    collection.add(CopyCounter(1));
+    collection.emplace(2);
+    collection.addAt(0, CopyCounter(0));
+    collection.emplaceAt(1, 5);
+    ASSERT_TRUE(collection.tryAdd(CopyCounter(3)));
+    ASSERT_TRUE(collection.tryEmplace(4));
+    collection.removeAt(1);
+
+    ASSERT_EQ(collection.length, 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(collection.at(i).id, i);
+    }
+
+    Collection<CopyCounter, 16> moved(std::move(collection));
+    Collection<CopyCounter, 16> assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.at(4).id, 4);
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+}
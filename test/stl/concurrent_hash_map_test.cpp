@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+#include "../../src/stl/concurrent_hash_map.hpp"
+
+TEST(ConcurrentHashMapTest, AddFindRemove) {
+    ConcurrentHashMap< uint32, uint64 > container;
+
+    ASSERT_TRUE(container.add(7, 70));
+    ASSERT_FALSE(container.add(7, 700));
+    ASSERT_TRUE(container.add(8, 80));
+
+    uint64 value = 0;
+    ASSERT_TRUE(container.find(7, value));
+    ASSERT_EQ(value, 700u);
+    ASSERT_EQ(container.getValue(8), 80u);
+    ASSERT_EQ(container.getValue(9, 99), 99u);
+    ASSERT_EQ(container.length(), 2u);
+
+    ASSERT_TRUE(container.remove(7));
+    ASSERT_FALSE(container.remove(7));
+    ASSERT_FALSE(container.exists(7));
+    ASSERT_EQ(container.length(), 1u);
+
+    container.clear();
+    ASSERT_EQ(container.length(), 0u);
+    ASSERT_FALSE(container.exists(8));
+}
+
+TEST(ConcurrentHashMapTest, ShardsGrowAndRemoveKeepsProbeRuns) {
+    ConcurrentHashMap< uint32, uint32, 4, 8 > container;
+    std::map< uint32, uint32 > reference;
+    uint32 seed = 7;
+
+    for (int op = 0; op < 30000; ++op) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32 key = (seed >> 8) % 3000;
+
+        if ((seed >> 4) % 4 == 0) {
+            ASSERT_EQ(container.remove(key), reference.erase(key) == 1);
+        } else {
+            container.add(key, op);
+            reference[key] = op;
+        }
+    }
+
+    ASSERT_EQ(container.length(), reference.size());
+    for (uint32 key = 0; key < 3000; ++key) {
+        auto it = reference.find(key);
+        uint32 value = 0;
+        ASSERT_EQ(container.find(key, value), it != reference.end());
+        if (it != reference.end()) {
+            ASSERT_EQ(value, it->second);
+        }
+    }
+}
+
+TEST(ConcurrentHashMapTest, ConcurrentCountersAreExact) {
+    ConcurrentHashMap< uint32, uint32 > hits;
+    const uint32 nbThreads = 8;
+    const uint32 nbIncrements = 20000;
+    std::vector< std::thread > threads;
+
+    for (uint32 t = 0; t < nbThreads; ++t) {
+        threads.emplace_back([&hits, t]() {
+            for (uint32 i = 0; i < nbIncrements; ++i) {
+                hits.update((i + t) % 100, 0, [](uint32& count) { count++; });
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    uint32 total = 0;
+    for (uint32 key = 0; key < 100; ++key) {
+        total += hits.getValue(key);
+    }
+    ASSERT_EQ(hits.length(), 100u);
+    ASSERT_EQ(total, nbThreads * nbIncrements);
+}
+
+TEST(ConcurrentHashMapTest, ReadersNeverSeeTornValues) {
+    struct Pair {
+        uint64 first;
+        uint64 second;
+    };
+
+    ConcurrentHashMap< uint32, Pair, 2, 8 > container;
+    std::atomic< bool > done{false};
+    std::atomic< uint32 > badReads{0};
+
+    std::thread writer([&]() {
+        for (uint64 round = 1; round < 200; ++round) {
+            for (uint32 key = 0; key < 500; ++key) {
+                container.add(key, Pair{round * key, round * key});
+            }
+            for (uint32 key = 0; key < 500; key += 3) {
+                container.remove(key);
+            }
+        }
+        done.store(true);
+    });
+
+    std::vector< std::thread > readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                for (uint32 key = 0; key < 500; ++key) {
+                    Pair pair;
+                    if (container.find(key, pair) && pair.first != pair.second) {
+                        badReads++;
+                    }
+                }
+            }
+        });
+    }
+
+    writer.join();
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(badReads.load(), 0u);
+}
@@ -0,0 +1,19 @@
+#ifndef copy_counter_hpp
+#define copy_counter_hpp
+
+/** Item that counts its copies, to check the containers move instead. Reset copies first. */
+struct CopyCounter {
+    inline static int copies = 0;
+    int id;
+
+    CopyCounter(int itemId = 0) : id(itemId) {}
+    CopyCounter(const CopyCounter& other) : id(other.id) { copies++; }
+    CopyCounter(CopyCounter&& other) noexcept : id(other.id) {}
+    CopyCounter& operator=(const CopyCounter& other) { id = other.id; copies++; return *this; }
+    CopyCounter& operator=(CopyCounter&& other) noexcept { id = other.id; return *this; }
+
+    bool operator==(const CopyCounter& other) const { return id == other.id; }
+    bool operator!=(const CopyCounter& other) const { return id != other.id; }
+};
+
+#endif
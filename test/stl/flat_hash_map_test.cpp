@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include "../../src/stl/flat_hash_map.hpp"
+#include "./copy_counter.hpp"
+
+TEST(FlatHashMapTest, AddAndExists) {
+    FlatHashMap< int, float > container;
+
+    float& val1 = container.add(1, 10.5f);
+
+    ASSERT_EQ(container.length(), 1u);
+    ASSERT_TRUE(container.exists(1));
+    ASSERT_EQ(val1, 10.5f);
+
+    container.add(5, 20.0f);
+    ASSERT_EQ(container.length(), 2u);
+    ASSERT_TRUE(container.exists(5));
+    ASSERT_FALSE(container.exists(2));
+}
+
+TEST(FlatHashMapTest, AddExistingKeyOverwrites) {
+    FlatHashMap< int, float > container;
+
+    container.add(10, 50.0f);
+    float& existingValRef = container.add(10, 99.9f);
+
+    ASSERT_EQ(container.length(), 1u);
+    ASSERT_EQ(existingValRef, 99.9f);
+
+    existingValRef = 150.0f;
+    ASSERT_EQ(container.at(10), 150.0f);
+}
+
+TEST(FlatHashMapTest, StringKeys) {
+    FlatHashMap< std::string, std::string > container;
+
+    container.add("content-type", "application/json");
+    container.add("content-length", "42");
+    container.add("host", "localhost");
+
+    ASSERT_EQ(container.length(), 3u);
+    ASSERT_EQ(container.at("content-length"), "42");
+    ASSERT_EQ(container.getValue("host"), "localhost");
+    ASSERT_EQ(container.find("accept"), nullptr);
+    ASSERT_TRUE(container.remove("content-type"));
+    ASSERT_FALSE(container.exists("content-type"));
+    ASSERT_EQ(container.at("host"), "localhost");
+}
+
+TEST(FlatHashMapTest, GrowsBeyondInitialCapacity) {
+    FlatHashMap< uint32, uint32, 16 > container;
+
+    for (uint32 i = 0; i < 10000; ++i) {
+        container.add(i, i * 3);
+    }
+
+    ASSERT_EQ(container.length(), 10000u);
+    ASSERT_GE(container.slotCount, 10000u);
+
+    for (uint32 i = 0; i < 10000; ++i) {
+        ASSERT_EQ(container.at(i), i * 3);
+    }
+}
+
+TEST(FlatHashMapTest, RemoveLeavesNoTombstones) {
+    FlatHashMap< int, int, 64 > container;
+
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 40; ++i) {
+            container.add(round * 1000 + i, i);
+        }
+        for (int i = 0; i < 40; ++i) {
+            ASSERT_TRUE(container.remove(round * 1000 + i));
+        }
+    }
+
+    ASSERT_EQ(container.length(), 0u);
+    ASSERT_EQ(container.slotCount, 64u);
+
+    for (uint32 i = 0; i < container.slotCount; ++i) {
+        ASSERT_EQ(container.ctrl[i], (FlatHashMap< int, int, 64 >::CTRL_EMPTY));
+    }
+}
+
+TEST(FlatHashMapTest, RandomOperationsMatchReference) {
+    FlatHashMap< std::string, int, 16 > container;
+    std::unordered_map< std::string, int > reference;
+    std::mt19937 rng(1234);
+
+    for (int op = 0; op < 50000; ++op) {
+        std::string key = "session-" + std::to_string(rng() % 2000);
+        int action = rng() % 3;
+
+        if (action == 0) {
+            ASSERT_EQ(container.remove(key), reference.erase(key) == 1);
+        } else {
+            container.add(key, op);
+            reference[key] = op;
+        }
+    }
+
+    ASSERT_EQ(container.length(), reference.size());
+    for (auto& entry : reference) {
+        ASSERT_TRUE(container.exists(entry.first));
+        ASSERT_EQ(container.at(entry.first), entry.second);
+    }
+}
+
+TEST(FlatHashMapTest, IteratorVisitsEveryEntryOnce) {
+    FlatHashMap< int, float > container;
+    container.add(10, 100.0f);
+    container.add(20, 200.0f);
+    container.add(30, 300.0f);
+
+    std::set< int > visitedKeys;
+    FlatHashMap< int, float >::Iterator it;
+    it.init(&container);
+
+    for (it.begin(); it.key() != nullptr; it.next()) {
+        ASSERT_EQ(*it.value(), *it.key() * 10.0f);
+        ASSERT_TRUE(visitedKeys.insert(*it.key()).second);
+    }
+
+    ASSERT_EQ(visitedKeys.size(), 3u);
+}
+
+TEST(FlatHashMapTest, ClearAndReuse) {
+    FlatHashMap< std::string, int > container;
+    container.add("a", 1);
+    container.add("b", 2);
+
+    container.clear();
+    ASSERT_EQ(container.length(), 0u);
+    ASSERT_FALSE(container.exists("a"));
+
+    container.add("a", 3);
+    ASSERT_EQ(container.at("a"), 3);
+}
+
+TEST(FlatHashMapTest, UsesPoolAllocator) {
+    PoolAllocator* pool = new PoolAllocator();
+    {
+        FlatHashMap< int, std::string, 16 > container(pool);
+        for (int i = 0; i < 1000; ++i) {
+            container.add(i, std::to_string(i));
+        }
+
+        ASSERT_TRUE((char*) container.slots >= pool->arena.items && (char*) container.slots < pool->arenaEnd);
+        ASSERT_EQ(container.at(999), "999");
+    }
+    delete pool;
+}
+
+TEST(FlatHashMapTest, AddEmplaceAndGrowthDoNotCopy) {
+    CopyCounter::copies = 0;
+
+    FlatHashMap< std::string, CopyCounter, 16 > container;
+    for (int i = 0; i < 100; ++i) {
+        container.add("key-" + std::to_string(i), CopyCounter(i));
+    }
+    container.emplace("key-100", 100);
+    container.emplace("key-7", -1);
+    container.remove("key-0");
+
+    FlatHashMap< std::string, CopyCounter, 16 > moved(std::move(container));
+    EXPECT_EQ(moved.length(), 100u);
+    EXPECT_EQ(moved.at("key-7").id, 7);
+
+    FlatHashMap< std::string, CopyCounter, 16 > assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.at("key-100").id, 100);
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+}
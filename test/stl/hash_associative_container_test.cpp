@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 #include <set>
 #include <map>
+#include <string>
 #include "../../src/stl/hash_associative_container.hpp"
+#include "./copy_counter.hpp"
 
 template< class Key, class Value, uint32 CONTAINER_CAPACITY >
 struct HashContainerWrapper {
@@ -176,3 +178,178 @@ TYPED_TEST(HashAssociativeContainerTest, HashCollisionHandling) {
         ASSERT_EQ(container.at(i * 128 + 1), (float)(i * 10));
     }
 }
+
+TEST(HashAssociativeContainerGrowthTest, GrowsPastInitialCapacity) {
+    HashAssociativeContainer< int, int, 8 > container;
+
+    for (int i = 0; i < 5000; ++i) {
+        container.add(i, i * 2);
+    }
+
+    ASSERT_EQ(container.length(), 5000u);
+    ASSERT_GE(container.bucketCount + container.oldBucketCount, 4096u);
+
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(container.exists(i));
+        ASSERT_EQ(container.at(i), i * 2);
+    }
+}
+
+TEST(HashAssociativeContainerGrowthTest, RehashIsIncremental) {
+    HashAssociativeContainer< int, int, 64 > container;
+
+    for (int i = 0; i < 64; ++i) {
+        container.add(i, i);
+    }
+    ASSERT_FALSE(container.isRehashing());
+
+    container.add(64, 64);
+    ASSERT_TRUE(container.isRehashing());
+    ASSERT_EQ(container.bucketCount, 128u);
+    ASSERT_EQ(container.oldBucketCount, 64u);
+
+    /** Lookups, removals and iteration see both tables while migrating. */
+    for (int i = 0; i <= 64; ++i) {
+        ASSERT_EQ(container.at(i), i);
+    }
+    ASSERT_TRUE(container.remove(3));
+    ASSERT_FALSE(container.exists(3));
+
+    HashAssociativeContainer< int, int, 64 >::Iterator it;
+    it.init(&container);
+    uint32 visited = 0;
+    for (it.begin(); it.key() != nullptr; it.next()) {
+        visited++;
+    }
+    ASSERT_EQ(visited, container.length());
+
+    int nextKey = 1000;
+    while (container.isRehashing()) {
+        container.add(nextKey, nextKey);
+        nextKey++;
+    }
+
+    ASSERT_LT(nextKey - 1000, 32);
+    for (int i = 0; i <= 64; ++i) {
+        ASSERT_EQ(container.exists(i), i != 3);
+    }
+}
+
+TEST(HashAssociativeContainerGrowthTest, StringKeysSpreadAcrossBuckets) {
+    HashAssociativeContainer< std::string, int, 64 > container;
+
+    for (int i = 0; i < 48; ++i) {
+        container.add("header-" + std::to_string(i), i);
+    }
+
+    uint32 usedBuckets = 0;
+    for (uint32 i = 0; i < container.bucketCount; ++i) {
+        usedBuckets += container.table[i] != (HashAssociativeContainer< std::string, int, 64 >::NO_ENTRY);
+    }
+    ASSERT_GT(usedBuckets, 16u);
+
+    ASSERT_EQ(container.at("header-47"), 47);
+    ASSERT_TRUE(container.remove("header-0"));
+    ASSERT_FALSE(container.exists("header-0"));
+}
+
+TEST(HashAssociativeContainerDenseTest, IndexedAccessFollowsInsertionOrder) {
+    HashAssociativeContainer< std::string, int, 4 > container;
+
+    for (int i = 0; i < 100; ++i) {
+        container.add("key-" + std::to_string(i), i);
+    }
+
+    for (uint32 i = 0; i < container.length(); ++i) {
+        ASSERT_EQ(container.getKeyAt(i), "key-" + std::to_string(i));
+        ASSERT_EQ(container.getValueAt(i), (int) i);
+    }
+}
+
+TEST(HashAssociativeContainerDenseTest, RemoveSwapsLastEntryIntoHole) {
+    HashAssociativeContainer< int, int, 16 > container;
+
+    for (int i = 0; i < 10; ++i) {
+        container.add(i, i * 10);
+    }
+
+    ASSERT_TRUE(container.remove(2));
+    ASSERT_EQ(container.length(), 9u);
+    ASSERT_EQ(container.getKeyAt(2), 9);
+    ASSERT_EQ(container.getValueAt(2), 90);
+    ASSERT_EQ(container.at(9), 90);
+
+    ASSERT_TRUE(container.remove(8));
+    ASSERT_EQ(container.getKeyAt(7), 7);
+    ASSERT_EQ(container.length(), 8u);
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(container.exists(i), i != 2 && i != 8);
+    }
+}
+
+TEST(HashAssociativeContainerDenseTest, RandomOperationsMatchReference) {
+    HashAssociativeContainer< int, int, 8 > container;
+    std::map< int, int > reference;
+    uint32 seed = 42;
+
+    for (int op = 0; op < 20000; ++op) {
+        seed = seed * 1664525u + 1013904223u;
+        int key = (int)((seed >> 8) % 700);
+
+        if ((seed >> 4) % 3 == 0) {
+            ASSERT_EQ(container.remove(key), reference.erase(key) == 1);
+        } else {
+            container.add(key, op);
+            reference[key] = op;
+        }
+    }
+
+    ASSERT_EQ(container.length(), reference.size());
+
+    std::map< int, int > dense;
+    for (uint32 i = 0; i < container.length(); ++i) {
+        dense[container.getKeyAt(i)] = container.getValueAt(i);
+    }
+    ASSERT_EQ(dense, reference);
+}
+
+TEST(HashAssociativeContainerDenseTest, PooledEntriesGrowInPlace) {
+    PoolAllocator* pool = new PoolAllocator();
+    {
+        HashAssociativeContainer< int, int, 8 > container(pool);
+        for (int i = 0; i < 3000; ++i) {
+            container.add(i, -i);
+        }
+        for (int i = 0; i < 3000; ++i) {
+            ASSERT_EQ(container.at(i), -i);
+        }
+        ASSERT_TRUE((char*) container.entries >= pool->arena.items && (char*) container.entries < pool->arenaEnd);
+    }
+    delete pool;
+}
+
+TEST(HashAssociativeContainerMoveTest, AddEmplaceAndGrowthDoNotCopy) {
+    CopyCounter::copies = 0;
+
+    HashAssociativeContainer< std::string, CopyCounter, 4 > container;
+    for (int i = 0; i < 100; ++i) {
+        container.add("key-" + std::to_string(i), CopyCounter(i));
+    }
+    container.emplace("key-100", 100);
+    container.add("key-5", CopyCounter(-5));
+    container.remove("key-0");
+
+    HashAssociativeContainer< std::string, CopyCounter, 4 > moved(std::move(container));
+    EXPECT_EQ(moved.length(), 100u);
+    EXPECT_EQ(moved.at("key-100").id, 100);
+    EXPECT_EQ(moved.at("key-5").id, -5);
+
+    HashAssociativeContainer< std::string, CopyCounter, 4 > assigned;
+    assigned.add("other", CopyCounter(0));
+    assigned = std::move(moved);
+    EXPECT_FALSE(assigned.exists("other"));
+    EXPECT_EQ(assigned.at("key-99").id, 99);
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+}
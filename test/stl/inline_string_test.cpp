@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/stl/inline_string.hpp"
+
+TEST(InlineStringTest, StoresInPlace) {
+    InlineString< 16 > method("PATCH");
+
+    ASSERT_EQ(method.length(), 5u);
+    ASSERT_STREQ(method.c_str(), "PATCH");
+    ASSERT_TRUE(method == "PATCH");
+    ASSERT_TRUE(method != std::string("PATCH "));
+    ASSERT_EQ(method.view(), std::string_view("PATCH"));
+    ASSERT_TRUE(std::is_trivially_copyable_v< InlineString< 16 > >);
+    ASSERT_EQ(sizeof(InlineString< 16 >), sizeof(uint32) + 17 + 3);
+}
+
+TEST(InlineStringTest, RefusesWhatDoesNotFit) {
+    InlineString< 8 > version("HTTP/1.1");
+
+    ASSERT_FALSE(version.append('x'));
+    ASSERT_FALSE(version.assign("HTTP/1.1 "));
+    ASSERT_EQ(version, "HTTP/1.1");
+
+    version.clear();
+    ASSERT_TRUE(version.isEmpty());
+    ASSERT_TRUE(version.append("HTTP/"));
+    ASSERT_FALSE(version.append("1.1.1"));
+    ASSERT_TRUE(version.append("2"));
+    ASSERT_STREQ(version.c_str(), "HTTP/2");
+}
+
+TEST(InlineStringTest, LowersAndOrders) {
+    InlineString<> name("Content-Type");
+    name.toLower();
+
+    ASSERT_EQ(name, "content-type");
+    ASSERT_TRUE(InlineString<>("accept") < name);
+    ASSERT_FALSE(name < InlineString<>("content"));
+    ASSERT_TRUE(InlineString< 4 >::fits("abcd"));
+    ASSERT_FALSE(InlineString< 4 >::fits("abcde"));
+}
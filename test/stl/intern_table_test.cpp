@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../src/stl/intern_table.hpp"
+
+namespace {
+
+typedef InternTable< 8, 16 > ColorTable;
+
+const ColorTable& colors(void) {
+    static const ColorTable table = {"red", "green", "blue"};
+    return table;
+}
+
+typedef InternedName< ColorTable, colors, true > ColorName;
+
+}
+
+TEST(InternTableTest, AssignsDenseIdsInOrder) {
+    InternTable< 4, 8 > table;
+
+    ASSERT_EQ(table.intern("get"), 0u);
+    ASSERT_EQ(table.intern("post"), 1u);
+    ASSERT_EQ(table.intern("get"), 0u);
+    ASSERT_EQ(table.intern("toolongname"), table.NOT_INTERNED);
+    ASSERT_EQ(table.intern("put"), 2u);
+    ASSERT_EQ(table.intern("head"), 3u);
+    ASSERT_EQ(table.intern("trace"), table.NOT_INTERNED);
+
+    ASSERT_EQ(table.find("post"), 1u);
+    ASSERT_EQ(table.name(2), "put");
+    ASSERT_EQ(table.length(), 4u);
+}
+
+TEST(InternTableTest, FrozenTableOnlyFinds) {
+    InternTable< 8, 8 > table;
+    table.intern("a");
+    table.freeze();
+
+    ASSERT_TRUE(table.isFrozen());
+    ASSERT_EQ(table.intern("b"), table.NOT_INTERNED);
+    ASSERT_EQ(table.intern("a"), 0u);
+    ASSERT_EQ(table.length(), 1u);
+}
+
+TEST(InternTableTest, InternedNamesCompareByIdOrText) {
+    ColorName red("RED");
+    ColorName other("Magenta");
+
+    ASSERT_TRUE(red.isInterned());
+    ASSERT_EQ(red.id, 0u);
+    ASSERT_STREQ(red.c_str(), "red");
+    ASSERT_TRUE(red == ColorName(0u));
+    ASSERT_TRUE(red != ColorName("green"));
+
+    ASSERT_FALSE(other.isInterned());
+    ASSERT_TRUE(other == ColorName("magenta"));
+    ASSERT_TRUE(other != ColorName("cyan"));
+
+    ColorName oversized(std::string(17, 'x'));
+    ASSERT_FALSE(oversized.isValid());
+    ASSERT_TRUE(oversized != oversized);
+}
+
+TEST(InternTableTest, FrozenTableIsSharedBetweenThreads) {
+    std::vector< std::thread > threads;
+    std::vector< uint32 >      found(4, 0);
+
+    for (uint32 t = 0; t < 4; ++t) {
+        threads.emplace_back([&found, t]() {
+            for (int round = 0; round < 10000; ++round) {
+                found[t] += ColorName("Blue").id == 2u;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (uint32 count : found) {
+        ASSERT_EQ(count, 10000u);
+    }
+}
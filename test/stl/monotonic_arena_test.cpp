@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../../src/stl/monotonic_arena.hpp"
+
+TEST(MonotonicArenaTest, BumpsAndAligns) {
+    MonotonicArena arena(256);
+
+    char* first  = (char*) arena.allocate(3, 1);
+    char* second = (char*) arena.allocate(8, 8);
+    char* third  = (char*) arena.allocate(1, 64);
+
+    ASSERT_EQ((ulong) second % 8, 0u);
+    ASSERT_EQ((ulong) third % 64, 0u);
+    ASSERT_GE(second, first + 3);
+    ASSERT_LE(second, first + 3 + 7);
+    ASSERT_GE(arena.bytesUsed(), 12u);
+}
+
+TEST(MonotonicArenaTest, GrowsAndResetsToOneBlock) {
+    MonotonicArena arena(128);
+
+    for (int idx = 0; idx < 1000; idx++) {
+        ::memset(arena.allocate(100), idx, 100);
+    }
+    void* big = arena.allocate(1 << 20);
+    ::memset(big, 1, 1 << 20);
+
+    ASSERT_GE(arena.bytesUsed(), 100000u + (1u << 20));
+    ulong capacity = arena.capacity();
+
+    arena.reset();
+    ASSERT_EQ(arena.bytesUsed(), 0u);
+    ASSERT_LT(arena.capacity(), capacity);
+    ASSERT_GE(arena.capacity(), 1u << 20);
+
+    // The kept block serves the next round without growing
+    ulong settled = arena.capacity();
+    for (int idx = 0; idx < 1000; idx++) {
+        arena.allocate(100);
+    }
+    ASSERT_EQ(arena.capacity(), settled);
+}
+
+TEST(MonotonicArenaTest, AllocatorFollowsTheBoundArena) {
+    typedef std::basic_string< char, std::char_traits< char >, ArenaStlAllocator< char > > ArenaString;
+
+    ASSERT_EQ(currentArena(), nullptr);
+    ASSERT_THROW(ArenaStlAllocator< int >().allocate(1), std::bad_alloc);
+
+    MonotonicArena outer, inner;
+    {
+        ArenaScope scope(outer);
+        std::vector< int, ArenaStlAllocator< int > > numbers;
+        for (int idx = 0; idx < 1000; idx++) numbers.push_back(idx);
+        ASSERT_EQ(numbers[999], 999);
+        ASSERT_GE(outer.bytesUsed(), 1000 * sizeof(int));
+
+        {
+            ArenaScope nested(inner);
+            ASSERT_EQ(currentArena(), &inner);
+            ArenaString text(100, 'x');
+            ASSERT_GE(inner.bytesUsed(), 100u);
+        }
+        ASSERT_EQ(currentArena(), &outer);
+    }
+    ASSERT_EQ(currentArena(), nullptr);
+}
+
+TEST(MonotonicArenaTest, NullScopeUnbindsTheArena) {
+    MonotonicArena arena;
+    ArenaScope     scope(arena);
+    {
+        ArenaScope unbound(nullptr);
+        ASSERT_EQ(currentArena(), nullptr);
+        ASSERT_THROW(ArenaStlAllocator< int >().allocate(1), std::bad_alloc);
+    }
+    ASSERT_EQ(currentArena(), &arena);
+}
+
+TEST(MonotonicArenaTest, ResetGuardResetsOnThrow) {
+    MonotonicArena arena;
+
+    try {
+        ArenaResetGuard release(arena);
+        arena.allocate(100);
+        throw std::runtime_error("handler failed");
+    } catch (const std::runtime_error&) {
+    }
+    ASSERT_EQ(arena.bytesUsed(), 0u);
+}
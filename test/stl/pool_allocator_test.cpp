@@ -15,7 +15,7 @@ protected:
 };
 
 TEST_F(PoolAllocatorTest, BlockSplitting) {
-    uint32 largeSize = 1024 * 1024 * 256; 
+    uint32 largeSize = PoolAllocator::HUGE_ALLOC_THRESHOLD - 1024;
     
     void* ptrLarge = allocate_and_check(largeSize);
     
@@ -31,7 +31,6 @@ TEST_F(PoolAllocatorTest, BlockSplitting) {
     allocator.dealloc(ptrSmall);
 }
 
-/** @TODO: MUST FIX
 TEST_F(PoolAllocatorTest, ReallocBehavior) {
     void* ptr1 = allocator.realloc(nullptr, 16);
     ASSERT_NE(ptr1, nullptr);
@@ -43,25 +42,125 @@ TEST_F(PoolAllocatorTest, ReallocBehavior) {
     uint32 newSizeLarge = 64;
     void* ptr2 = allocator.realloc(ptr1, newSizeLarge);
     ASSERT_NE(ptr2, nullptr);
-    ASSERT_NE(ptr1, ptr2);
     
     ASSERT_EQ(::memcmp(ptr2, data, oldSize), 0);
 
     uint32 newSizeSmall = 2;
     void* ptr3 = allocator.realloc(ptr2, newSizeSmall);
     ASSERT_NE(ptr3, nullptr);
-    ASSERT_NE(ptr2, ptr3);
     
     ASSERT_EQ(::memcmp(ptr3, "HO", newSizeSmall), 0);
 
     void* result = allocator.realloc(ptr3, 0);
     ASSERT_EQ(result, nullptr);
-} */
+}
+
+TEST_F(PoolAllocatorTest, ReallocGrowsInPlaceWhenNextBlockIsFree) {
+    void* ptr = allocate_and_check(32);
+    ::memset(ptr, 0x5A, 32);
+
+    void* grown = allocator.realloc(ptr, 4096);
+    ASSERT_EQ(grown, ptr);
+    ASSERT_GE(allocator.inspectHeader(grown)->words * 4u, 4096u);
+
+    for (uint32 i = 0; i < 32; ++i) {
+        ASSERT_EQ(((unsigned char*) grown)[i], 0x5A);
+    }
+
+    void* next = allocate_and_check(16);
+    ASSERT_GT((char*) next, (char*) grown + 4096 - 1);
+
+    allocator.dealloc(next);
+    allocator.dealloc(grown);
+}
+
+TEST_F(PoolAllocatorTest, ReallocAbsorbsFreedNeighbour) {
+    void* first  = allocate_and_check(64);
+    void* second = allocate_and_check(64);
+    void* third  = allocate_and_check(64);
+
+    allocator.dealloc(second);
+
+    void* grown = allocator.realloc(first, 128);
+    ASSERT_EQ(grown, first);
+
+    void* moved = allocator.realloc(grown, 1024);
+    ASSERT_NE(moved, first);
+    ASSERT_TRUE(allocator.inspectHeader(moved)->alloced);
+
+    allocator.dealloc(third);
+    allocator.dealloc(moved);
+}
+
+TEST_F(PoolAllocatorTest, ReallocShrinksInPlace) {
+    void* ptr = allocate_and_check(1024);
+    void* shrunk = allocator.realloc(ptr, 100);
+    ASSERT_EQ(shrunk, ptr);
+    ASSERT_EQ(allocator.inspectHeader(shrunk)->words, 25u);
+
+    void* reused = allocate_and_check(100);
+    ASSERT_LT((char*) reused, (char*) ptr + 1024);
+
+    allocator.dealloc(reused);
+    allocator.dealloc(shrunk);
+}
+
+TEST_F(PoolAllocatorTest, HugeReallocUsesMappedRegion) {
+    void* ptr = allocate_and_check(1024);
+    ::memset(ptr, 0x11, 1024);
+
+    uint32 hugeSize = PoolAllocator::HUGE_ALLOC_THRESHOLD * 4;
+    void* huge = allocator.realloc(ptr, hugeSize);
+    ASSERT_NE(huge, nullptr);
+    ASSERT_TRUE(allocator.inspectHeader(huge)->mapped);
+    ASSERT_TRUE(allocator.inspectHeader(huge)->alloced);
+    ASSERT_EQ(((unsigned char*) huge)[1023], 0x11);
+
+    ((unsigned char*) huge)[hugeSize - 1] = 0x22;
+
+    void* bigger = allocator.realloc(huge, hugeSize * 8);
+    ASSERT_NE(bigger, nullptr);
+    ASSERT_EQ(((unsigned char*) bigger)[0], 0x11);
+    ASSERT_EQ(((unsigned char*) bigger)[hugeSize - 1], 0x22);
+
+    void* arenaBlock = allocate_and_check(1024);
+    ASSERT_EQ(arenaBlock, ptr);
+
+    allocator.dealloc(bigger);
+    allocator.dealloc(arenaBlock);
+}
+
+TEST_F(PoolAllocatorTest, HugeAllocUsesMappedRegion) {
+    void* huge = allocate_and_check(PoolAllocator::HUGE_ALLOC_THRESHOLD);
+    ASSERT_TRUE(allocator.inspectHeader(huge)->mapped);
+    ASSERT_TRUE(allocator.inspectHeader(huge)->alloced);
+    ::memset(huge, 0x33, PoolAllocator::HUGE_ALLOC_THRESHOLD);
+
+    void* small = allocate_and_check(64);
+    ASSERT_EQ(small, (void*)(allocator.arena.items + sizeof(PoolAllocator::Header)));
+
+    allocator.dealloc(huge);
+    allocator.dealloc(small);
+}
+
+TEST_F(PoolAllocatorTest, TryResizeInPlaceKeepsAlignment) {
+    void* aligned = allocator.allocAligned(64, 64);
+    ASSERT_NE(aligned, nullptr);
+
+    ASSERT_TRUE(allocator.tryResizeInPlace(aligned, 4096));
+    ASSERT_EQ((ulong) aligned % 64, 0u);
+
+    void* blocker = allocate_and_check(256);
+    ASSERT_GT((char*) blocker, (char*) aligned);
+    ASSERT_FALSE(allocator.tryResizeInPlace(aligned, 8192));
+
+    allocator.dealloc(blocker);
+    allocator.dealloc(aligned);
+}
 
 TEST_F(PoolAllocatorTest, BasicDeallocation) {
-    uint32 maxAllocSize = PoolAllocator::POOL_CAPACITY - 50;
+    uint32 maxAllocSize = PoolAllocator::HUGE_ALLOC_THRESHOLD - 50;
     void* ptr = allocate_and_check(maxAllocSize);
-    void* fail_ptr = allocator.alloc(100);
     const PoolAllocator::Header* header = allocator.inspectHeader(ptr);
 
     allocator.dealloc(ptr);
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "../../src/stl/pool_memory_resource.hpp"
+#include <map>
+
+class PoolMemoryResourceTest : public ::testing::Test {
+protected:
+    PoolAllocator allocator;
+};
+
+TEST_F(PoolMemoryResourceTest, AlignedAllocation) {
+    void* unaligned = allocator.alloc(3);
+    ASSERT_NE(unaligned, nullptr);
+
+    for (uint32 alignment = 8; alignment <= 4096; alignment *= 2) {
+        void* ptr = allocator.allocAligned(24, alignment);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ((ulong) ptr % alignment, 0u) << "alignment " << alignment;
+        ::memset(ptr, 0xAB, 24);
+    }
+
+    allocator.dealloc(unaligned);
+}
+
+TEST_F(PoolMemoryResourceTest, AlignedBlocksAreReusable) {
+    void* first = allocator.allocAligned(64, 64);
+    ASSERT_NE(first, nullptr);
+    allocator.dealloc(first);
+
+    void* second = allocator.allocAligned(64, 64);
+    EXPECT_EQ(first, second);
+    allocator.dealloc(second);
+}
+
+TEST_F(PoolMemoryResourceTest, PmrContainersUseThePool) {
+    PoolMemoryResource resource(&allocator);
+
+    std::pmr::vector< std::pmr::string > items(&resource);
+    for (int i = 0; i < 100; ++i) {
+        items.emplace_back("a string long enough to skip the small buffer #" + std::to_string(i));
+    }
+
+    ASSERT_EQ(items.size(), 100u);
+    EXPECT_EQ(items[42], "a string long enough to skip the small buffer #42");
+
+    char* arenaBegin = allocator.arena.items;
+    char* arenaEnd   = allocator.arenaEnd;
+    EXPECT_TRUE((char*) items.data() >= arenaBegin && (char*) items.data() < arenaEnd);
+    EXPECT_TRUE((char*) items[0].data() >= arenaBegin && (char*) items[0].data() < arenaEnd);
+}
+
+TEST_F(PoolMemoryResourceTest, ResourceEquality) {
+    PoolMemoryResource resource(&allocator);
+    PoolMemoryResource sameResource(&allocator);
+
+    EXPECT_TRUE(resource.is_equal(sameResource));
+    EXPECT_FALSE(resource.is_equal(*std::pmr::new_delete_resource()));
+}
+
+TEST_F(PoolMemoryResourceTest, StlAllocatorAdapter) {
+    PoolStlAllocator< int > intAllocator(&allocator);
+    PoolVector< int > numbers(intAllocator);
+
+    for (int i = 0; i < 1000; ++i) {
+        numbers.push_back(i);
+    }
+    EXPECT_EQ(numbers[999], 999);
+
+    PoolString text("pooled string that does not fit the sso buffer", PoolStlAllocator< char >(&allocator));
+    EXPECT_EQ(text.size(), 46u);
+
+    typedef std::pair< const int, double > Node;
+    std::map< int, double, std::less< int >, PoolStlAllocator< Node > > table{PoolStlAllocator< Node >(&allocator)};
+    table[1] = 1.5;
+    table[2] = 2.5;
+    EXPECT_EQ(table.at(2), 2.5);
+
+    EXPECT_TRUE(PoolStlAllocator< char >(&allocator) == intAllocator);
+}
+
+TEST_F(PoolMemoryResourceTest, StlAllocatorDeallocateNeverThrows) {
+    PoolStlAllocator< int > intAllocator(&allocator);
+    int* numbers = intAllocator.allocate(4);
+
+    static_assert(noexcept(intAllocator.deallocate(numbers, 4)));
+    intAllocator.deallocate(numbers, 4);
+    EXPECT_FALSE(allocator.inspectHeader(numbers)->alloced);
+    EXPECT_FALSE(allocator.tryDealloc(numbers));
+}
+
+TEST_F(PoolMemoryResourceTest, ExhaustedPoolThrows) {
+    PoolMemoryResource resource(&allocator);
+
+    EXPECT_THROW((void) resource.allocate(PoolAllocator::POOL_CAPACITY, 16), std::bad_alloc);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
+#include <memory>
 #include "../../src/stl/queue.hpp"
+#include "./copy_counter.hpp"
 
 TEST(QueueTest, EnqueueDequeueBasic) {
     Queue<int, 4> q;
@@ -39,3 +41,35 @@ TEST(QueueTest, WrapAround) {
     EXPECT_EQ(q.dequeue(), 4);
     EXPECT_TRUE(q.isEmpty());
 }
+
+TEST(QueueTest, DestroysOnlyQueuedItems) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        Queue<std::shared_ptr<int>, 8> q;
+        EXPECT_EQ(tracker.use_count(), 1);
+
+        q.enqueue(tracker);
+        q.enqueue(tracker);
+        q.enqueue(tracker);
+        EXPECT_EQ(tracker.use_count(), 4);
+
+        q.dequeue();
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(QueueTest, EnqueueAndDequeueDoNotCopy) {
+    CopyCounter::copies = 0;
+
+    Queue<CopyCounter, 8> q;
+    q.enqueue(CopyCounter(1));
+    q.emplace(2);
+
+    Queue<CopyCounter, 8> moved(std::move(q));
+    EXPECT_EQ(moved.length(), 2u);
+    EXPECT_EQ(moved.dequeue().id, 1);
+    EXPECT_EQ(moved.dequeue().id, 2);
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../../src/stl/collection.hpp"
+#include "../../src/stl/simd_find.hpp"
+#include "../../src/stl/small_vector.hpp"
+
+namespace {
+
+enum class SocketState : unsigned short { IDLE, READING, WRITING, CLOSED };
+
+template< class ItemType >
+void expectKernelsAgree(uint32 maxLength) {
+    std::mt19937 rng(99);
+    ItemType     items[300];
+
+    for (uint32 length = 0; length <= maxLength; ++length) {
+        for (uint32 idx = 0; idx < length; ++idx) {
+            items[idx] = (ItemType)(rng() % 7);
+        }
+        for (uint32 value = 0; value < 8; ++value) {
+            ItemType needle   = (ItemType) value;
+            int      expected = simdFindScalar(items, length, needle);
+
+            ASSERT_EQ(simdFind(items, length, needle), expected) << "length " << length;
+#ifdef SA_SIMD_X86
+            ASSERT_EQ(simdFindSse2(items, length, needle), expected) << "length " << length;
+            if (simdHasAvx2()) {
+                ASSERT_EQ(simdFindAvx2(items, length, needle), expected) << "length " << length;
+            }
+#endif
+        }
+    }
+}
+
+}
+
+TEST(SimdFindTest, KernelsMatchScalarForEveryWidth) {
+    expectKernelsAgree< uint8 >(300);
+    expectKernelsAgree< short >(200);
+    expectKernelsAgree< int >(150);
+    expectKernelsAgree< uint64 >(100);
+}
+
+TEST(SimdFindTest, FindsLastSlotAndHighBits) {
+    uint64 ids[70] = {};
+    ids[69]        = 0xFFFFFFFF00000000ull;
+
+    ASSERT_EQ(simdFind(ids, 70, 0xFFFFFFFF00000000ull), 69);
+    ASSERT_EQ(simdFind(ids, 70, 0x00000000FFFFFFFFull), -1);
+    ASSERT_EQ(simdFind(ids, 69, 0xFFFFFFFF00000000ull), -1);
+}
+
+TEST(SimdFindTest, CollectionAndSmallVectorUseIt) {
+    Collection< int, 256 > fds;
+    SmallVector< SocketState > states;
+    SmallVector< const char* > names;
+    const char* words[] = {"alpha", "beta", "gamma"};
+
+    for (int fd = 0; fd < 200; ++fd) {
+        fds.add(fd * 3);
+        states.add(fd == 150 ? SocketState::CLOSED : SocketState::READING);
+        names.add(words[fd % 2]);
+    }
+
+    ASSERT_EQ(fds.indexOf(3 * 177), 177);
+    ASSERT_EQ(fds.indexOf(4), -1);
+    ASSERT_EQ(states.indexOf(SocketState::CLOSED), 150);
+    ASSERT_EQ(states.indexOf(SocketState::WRITING), -1);
+    ASSERT_EQ(names.indexOf(words[1]), 1);
+    ASSERT_EQ(names.indexOf(words[2]), -1);
+}
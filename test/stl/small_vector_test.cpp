@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/stl/small_vector.hpp"
+#include "../../src/stl/associative_container.hpp"
+
+TEST(SmallVectorTest, StaysInlineUpToCapacity) {
+    SmallVector<int, 4> vector;
+
+    for (int i = 0; i < 4; ++i) {
+        vector.add(i);
+    }
+
+    ASSERT_TRUE(vector.isInline());
+    ASSERT_EQ(vector.length, 4u);
+    ASSERT_EQ(vector.capacity, 4u);
+    ASSERT_EQ(vector.at(3), 3);
+}
+
+TEST(SmallVectorTest, SpillsToHeapWithGeometricGrowth) {
+    SmallVector<std::string, 2> vector;
+
+    for (int i = 0; i < 100; ++i) {
+        vector.add("token-" + std::to_string(i));
+    }
+
+    ASSERT_FALSE(vector.isInline());
+    ASSERT_EQ(vector.length, 100u);
+    ASSERT_EQ(vector.capacity, 128u);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(vector[i], "token-" + std::to_string(i));
+    }
+    ASSERT_EQ(vector.indexOf("token-42"), 42);
+}
+
+TEST(SmallVectorTest, RefusesReservationsPastTheSizeLimit) {
+    SmallVector<uint64, 4> vector;
+
+    ASSERT_FALSE(vector.reserve(0xF0000000u));
+    ASSERT_TRUE(vector.isInline());
+    ASSERT_EQ(vector.capacity, 4u);
+
+    ASSERT_TRUE(vector.reserve(1000));
+    ASSERT_EQ(vector.capacity, 1000u);
+}
+
+TEST(SmallVectorTest, AddingOwnItemWhileGrowing) {
+    SmallVector<std::string, 1> vector;
+    vector.add("a string long enough to live on the heap");
+
+    vector.add(vector.at(0));
+
+    ASSERT_EQ(vector.length, 2u);
+    ASSERT_EQ(vector.at(1), vector.at(0));
+}
+
+TEST(SmallVectorTest, InsertAndRemove) {
+    SmallVector<int, 2> vector;
+    vector.add(1);
+    vector.add(3);
+    vector.addAt(1, 2);
+    vector.addAt(0, 0);
+
+    ASSERT_EQ(vector.length, 4u);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(vector.at(i), i);
+    }
+
+    vector.removeAt(0);
+    ASSERT_EQ(vector.at(0), 1);
+    ASSERT_EQ(vector.length, 3u);
+
+    int sum = 0;
+    for (auto&& it = vector.begin(); it != vector.end(); ++it) {
+        sum += *it;
+    }
+    ASSERT_EQ(sum, 6);
+}
+
+TEST(SmallVectorTest, CopyAndMove) {
+    SmallVector<std::string, 2> inlineVector;
+    inlineVector.add("a");
+
+    SmallVector<std::string, 2> spilled;
+    for (int i = 0; i < 10; ++i) {
+        spilled.add(std::to_string(i));
+    }
+
+    SmallVector<std::string, 2> copy(spilled);
+    ASSERT_TRUE(copy == spilled);
+
+    std::string* heapBlock = spilled.items;
+    SmallVector<std::string, 2> moved(std::move(spilled));
+    ASSERT_EQ(moved.items, heapBlock);
+    ASSERT_EQ(spilled.length, 0u);
+    ASSERT_TRUE(spilled.isInline());
+
+    moved = std::move(inlineVector);
+    ASSERT_TRUE(moved.isInline());
+    ASSERT_EQ(moved.length, 1u);
+    ASSERT_EQ(moved.at(0), "a");
+
+    copy = moved;
+    ASSERT_EQ(copy.length, 1u);
+}
+
+TEST(SmallVectorTest, UsesPoolAllocator) {
+    PoolAllocator* pool = new PoolAllocator();
+    {
+        SmallVector<uint32, 4> vector(pool);
+        for (uint32 i = 0; i < 1000; ++i) {
+            vector.add(i);
+        }
+
+        ASSERT_TRUE((char*) vector.items >= pool->arena.items && (char*) vector.items < pool->arenaEnd);
+        ASSERT_EQ(vector.at(999), 999u);
+    }
+    delete pool;
+}
+
+TEST(SmallVectorTest, BacksAssociativeContainerPastInlineCapacity) {
+    AssociativeContainer<std::string, std::string, 2, SmallVector> headers;
+
+    for (int i = 0; i < 40; ++i) {
+        headers.add("x-header-" + std::to_string(i), std::to_string(i));
+    }
+
+    ASSERT_EQ(headers.length(), 40u);
+    ASSERT_EQ(headers.at("x-header-39"), "39");
+
+    decltype(headers)::Iterator it;
+    it.init(&headers);
+    int count = 0;
+    for (it.begin(); it.key() != it.end().key(); it.next()) {
+        count++;
+    }
+    ASSERT_EQ(count, 40);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include "../../src/stl/sorted_flat_map.hpp"
+
+TEST(SortedFlatMapTest, AddKeepsKeysSorted) {
+    SortedFlatMap< std::string, int > container;
+
+    container.add("text/html", 1);
+    container.add("application/json", 2);
+    container.add("image/png", 3);
+    int& existing = container.add("text/html", 4);
+
+    ASSERT_EQ(existing, 1);
+    ASSERT_EQ(container.length(), 3u);
+    ASSERT_EQ(container.getKeyAt(0), "application/json");
+    ASSERT_EQ(container.getKeyAt(1), "image/png");
+    ASSERT_EQ(container.getKeyAt(2), "text/html");
+    ASSERT_EQ(container.at("image/png"), 3);
+    ASSERT_EQ(container.find("text/css"), nullptr);
+}
+
+TEST(SortedFlatMapTest, SharedPrefixesFallBackToKeys) {
+    SortedFlatMap< std::string, int > container;
+    const char* names[] = {"application/xml", "application/json", "application", "applicat",
+                           "application/javascript", "applicatio", "", "application/x-www-form-urlencoded"};
+
+    for (int idx = 0; idx < 8; ++idx) {
+        container.add(names[idx], idx);
+    }
+    for (int idx = 0; idx < 8; ++idx) {
+        ASSERT_EQ(container.at(names[idx]), idx) << names[idx];
+    }
+    for (uint32 idx = 1; idx < container.length(); ++idx) {
+        ASSERT_LT(container.getKeyAt(idx - 1), container.getKeyAt(idx));
+    }
+
+    ASSERT_FALSE(container.exists("application/"));
+    ASSERT_FALSE(container.exists(std::string("applicat\0", 9)));
+    ASSERT_TRUE(container.remove("application/json"));
+    ASSERT_FALSE(container.exists("application/json"));
+    ASSERT_EQ(container.at("application/xml"), 0);
+}
+
+TEST(SortedFlatMapTest, SignedKeysOrderAcrossZero) {
+    SortedFlatMap< int, int > container;
+
+    for (int key : {5, -3, 0, -2147483647 - 1, 2147483647, -1}) {
+        container.add(key, key * 2);
+    }
+
+    ASSERT_EQ(container.getKeyAt(0), -2147483647 - 1);
+    ASSERT_EQ(container.getKeyAt(1), -3);
+    ASSERT_EQ(container.getKeyAt(5), 2147483647);
+    ASSERT_EQ(container.at(-3), -6);
+    ASSERT_FALSE(container.exists(1));
+}
+
+TEST(SortedFlatMapTest, BuildSortsAndKeepsFirstDuplicate) {
+    std::string keys[]   = {"delta", "alpha", "charlie", "alpha", "bravo"};
+    int         values[] = {4, 1, 3, 10, 2};
+
+    SortedFlatMap< std::string, int > container;
+    container.build(keys, values, 5);
+
+    ASSERT_EQ(container.length(), 4u);
+    ASSERT_EQ(container.getKeyAt(0), "alpha");
+    ASSERT_EQ(container.at("alpha"), 1);
+    ASSERT_EQ(container.at("delta"), 4);
+}
+
+TEST(SortedFlatMapTest, LookupsMatchReference) {
+    std::mt19937 rng(42);
+
+    for (uint32 size : {0u, 1u, 7u, 8u, 9u, 63u, 1000u, 10000u}) {
+        std::map< uint64, uint32 > reference;
+        SmallVector< uint64 > keys;
+        SmallVector< uint32 > values;
+
+        while (reference.size() < size) {
+            uint64 key = ((uint64) rng() << 32) | rng();
+            if (reference.emplace(key, (uint32) reference.size()).second) {
+                keys.add(key);
+                values.add(reference[key]);
+            }
+        }
+
+        SortedFlatMap< uint64, uint32 > container;
+        container.build(keys.items, values.items, keys.length);
+        ASSERT_EQ(container.length(), size);
+
+        for (auto& entry : reference) {
+            ASSERT_EQ(container.at(entry.first), entry.second);
+            ASSERT_FALSE(container.exists(entry.first + 1) && reference.count(entry.first + 1) == 0);
+        }
+        ASSERT_FALSE(container.exists(0) && reference.count(0) == 0);
+        ASSERT_FALSE(container.exists(~0ull) && reference.count(~0ull) == 0);
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include "../../src/stl/spsc_queue.hpp"
+
+TEST(SpscQueueTest, UsesEverySlot) {
+    SpscQueue< int, 4 > queue;
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(queue.enqueue(i));
+    }
+    ASSERT_FALSE(queue.enqueue(4));
+    ASSERT_EQ(queue.length(), 4u);
+
+    int item = -1;
+    ASSERT_TRUE(queue.dequeue(item));
+    ASSERT_EQ(item, 0);
+    ASSERT_TRUE(queue.emplace(4));
+
+    for (int expected = 1; expected <= 4; ++expected) {
+        ASSERT_TRUE(queue.dequeue(item));
+        ASSERT_EQ(item, expected);
+    }
+    ASSERT_FALSE(queue.dequeue(item));
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+TEST(SpscQueueTest, BulkOperationsWrapAround) {
+    SpscQueue< uint32, 8 > queue;
+    uint32 batch[6];
+    uint32 next = 0;
+    uint32 expected = 0;
+
+    for (int round = 0; round < 100; ++round) {
+        for (uint32 idx = 0; idx < 6; ++idx) {
+            batch[idx] = next + idx;
+        }
+        next += queue.enqueueBulk(batch, 6);
+
+        uint32 count = queue.dequeueBulk(batch, 5);
+        for (uint32 idx = 0; idx < count; ++idx) {
+            ASSERT_EQ(batch[idx], expected++);
+        }
+        ASSERT_LE(queue.length(), 8u);
+    }
+
+    ASSERT_EQ(next - expected, queue.length());
+}
+
+TEST(SpscQueueTest, BulkOperationsRefreshAStaleIndex) {
+    SpscQueue< uint32, 8 > queue;
+    uint32 batch[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    uint32 item;
+
+    // Consumer caches head = 2, then the producer adds 4 more
+    ASSERT_EQ(queue.enqueueBulk(batch, 2), 2u);
+    ASSERT_TRUE(queue.dequeue(item));
+    ASSERT_EQ(queue.enqueueBulk(batch + 2, 4), 4u);
+    ASSERT_EQ(queue.dequeueBulk(batch, 8), 5u);
+
+    // Producer caches tail = 14 (ring full), then the consumer frees the two slots it missed
+    ASSERT_EQ(queue.enqueueBulk(batch, 8), 8u);
+    ASSERT_EQ(queue.dequeueBulk(batch, 8), 8u);
+    ASSERT_TRUE(queue.enqueue(100));
+    ASSERT_TRUE(queue.dequeue(item));
+    ASSERT_EQ(item, 100u);
+    ASSERT_TRUE(queue.enqueue(101));
+    ASSERT_TRUE(queue.dequeue(item));
+    ASSERT_EQ(queue.enqueueBulk(batch, 8), 8u);
+}
+
+TEST(SpscQueueTest, DestroysPendingItems) {
+    auto tracked = std::make_shared< int >(1);
+    {
+        SpscQueue< std::shared_ptr< int >, 8 > queue;
+        for (int i = 0; i < 5; ++i) {
+            queue.enqueue(tracked);
+        }
+        std::shared_ptr< int > item;
+        queue.dequeue(item);
+        ASSERT_EQ(tracked.use_count(), 6);
+    }
+    ASSERT_EQ(tracked.use_count(), 1);
+}
+
+TEST(SpscQueueTest, ProducerConsumerKeepOrder) {
+    SpscQueue< uint64, 64 > queue;
+    const uint64 nbItems = 1000000;
+
+    std::thread producer([&]() {
+        uint64 batch[16];
+        uint64 next = 0;
+
+        while (next < nbItems) {
+            uint32 count = 0;
+            while (count < 16 && next + count < nbItems) {
+                batch[count] = next + count;
+                count++;
+            }
+            uint32 sent = queue.enqueueBulk(batch, count);
+            next += sent;
+            if (sent == 0) std::this_thread::yield();
+        }
+    });
+
+    uint64 expected = 0;
+    uint64 batch[16];
+    bool   ordered = true;
+
+    while (expected < nbItems) {
+        uint32 count = queue.dequeueBulk(batch, 16);
+        for (uint32 idx = 0; idx < count; ++idx) {
+            ordered &= batch[idx] == expected++;
+        }
+        if (count == 0) std::this_thread::yield();
+    }
+    producer.join();
+
+    ASSERT_TRUE(ordered);
+    ASSERT_TRUE(queue.isEmpty());
+}